@@ -0,0 +1,60 @@
+#include <iostream>
+#include <string>
+#include "../fiea-portfolio-project/abrv/abrv.h"
+#include "../fiea-portfolio-project/misc/contentpack.h"
+#include "../fiea-portfolio-project/misc/mappedfile.h"
+#include "../fiea-portfolio-project/store/gamelovstorage.h"
+#include "../fiea-portfolio-project/store/gamexlostorage.h"
+
+/*
+ * Compiles the `.txt` and XML files in the `res` folder into a content pack, which the game loads instead when it finds one.
+ * Run from the game's project folder, the same as the game:
+ *   content-compiler [resloc] [xmlfilename] [output]
+ * The files are loaded with the game's own loaders, so content that compiles is content the game accepts.
+ */
+int main(int argc, char* argv[]) {
+    std::string resloc = (argc > 1) ? argv[1] : "res";
+    std::string xmlfilename = (argc > 2) ? argv[2] : AWE::GameXLOStorage::DEFAULT_XMLFILENAME;
+    std::string output = (argc > 3) ? argv[3] : AWE::ContentPack::DEFAULT_FILENAME;
+
+    AWE::GameLOVStorage lov;
+    if (!lov.Initialize(resloc)) {
+        std::cout << "List of values failed to initialize.\n";
+        return 1;
+    }
+
+    using namespace AWE::literals;
+    AWE::DamageInclination_shptr phys = lov.GetDamageInclination("PHYS"_abrv);
+    if (!phys) {
+        std::cout << "PHYS damage inclination was not loaded!\n";
+        return 1;
+    }
+
+    AWE::GameXLOStorage xlo;
+    if (!xlo.Initialize(lov, phys, xmlfilename.c_str())) {
+        std::cout << "XML-loaded objects failed to initialize.\n";
+        return 1;
+    }
+
+    if (!AWE::WriteContentPack(lov, xlo, output)) {
+        return 1;
+    }
+
+    // Load the pack back the way the game will, so a pack the game cannot load is never left behind looking fine.
+    AWE::MappedFile packFile;
+    AWE::ContentPack pack;
+    AWE::GameLOVStorage packLov;
+    AWE::GameXLOStorage packXlo;
+    if (!packFile.Open(output) || !pack.Attach(packFile.data(), packFile.size()) || !packLov.Initialize(pack) || !packXlo.Initialize(packLov, pack)) {
+        std::cout << output << " was written, but could not be loaded back.\n";
+        return 1;
+    }
+
+    if (packXlo.skills().size() != xlo.skills().size() || packXlo.equipment().size() != xlo.equipment().size() || packXlo.battlers().size() != xlo.battlers().size()) {
+        std::cout << output << " was written, but does not hold everything that was loaded.\n";
+        return 1;
+    }
+
+    std::cout << "Compiled " << xlo.skills().size() << " skills, " << xlo.equipment().size() << " equipment and " << xlo.battlers().size() << " battlers into " << output << ".\n";
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../fiea-portfolio-project/abrv/abrv.h"
+#include "../fiea-portfolio-project/misc/damage.h"
+#include "../fiea-portfolio-project/misc/damagekernel.h"
+#include "../fiea-portfolio-project/store/contentsnapshot.h"
+#include "../fiea-portfolio-project/store/gamelovstorage.h"
+#include "../fiea-portfolio-project/store/gamexlostorage.h"
+
+namespace DAMAGEKERNELPARITY_PRIVATE {
+    const char* LevelName(AWE::DamageKernelLevel level) {
+        switch (level) {
+        case AWE::DamageKernelLevel::SSE2:
+            return "SSE2";
+        case AWE::DamageKernelLevel::AVX2:
+            return "AVX2";
+        default:
+            return "SCALAR";
+        }
+    }
+
+    /// <returns>true if both ranges hold the same bits. NaNs and signed zeros only match themselves.</returns>
+    bool SameBits(const float* a, const float* b, std::size_t count) {
+        return std::memcmp(a, b, count * sizeof(float)) == 0;
+    }
+
+    /// <returns>true if both damages have the same final total and the same bits in every component's grid.</returns>
+    bool SameDamage(const AWE::Damage& a, const AWE::Damage& b) {
+        if (a.final() != b.final() || a.componentCount() != b.componentCount() || a.cellCount() != b.cellCount()) {
+            return false;
+        }
+        for (std::size_t component = 0; component < a.componentCount(); component++) {
+            if (!SameBits(a.GetValues(component).cells().data(), b.GetValues(component).cells().data(), a.cellCount())) {
+                return false;
+            }
+            float totalA = a.GetValues(component).total();
+            float totalB = b.GetValues(component).total();
+            if (!SameBits(&totalA, &totalB, 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// Small deterministic generator, so every run and every machine sees the same synthetic bindings.
+    /// </summary>
+    class Lcg {
+    private:
+        std::uint32_t _state;
+
+    public:
+        Lcg(std::uint32_t seed) : _state(seed) {}
+
+        /// <returns>A value in [0, 1).</returns>
+        float Next() {
+            _state = (_state * 1664525U) + 1013904223U;
+            return static_cast<float>(_state >> 8) / static_cast<float>(1U << 24);
+        }
+        /// <returns>A value in [low, high].</returns>
+        int NextInt(int low, int high) {
+            return low + static_cast<int>(Next() * static_cast<float>(high - low + 1));
+        }
+    };
+
+    /// <summary>
+    /// Feeds the kernel synthetic bindings at every chunk size, including the edges the shipped content may not reach: 0 and negative affinities,
+    /// resistances above 100, and bonus scaling on both sides of the gates.
+    /// </summary>
+    /// <returns>Number of chunks whose result at some level differed from the scalar one.</returns>
+    std::size_t CheckSyntheticBindings(AWE::DamageKernelLevel bestLevel, const AWE::DamageKernelConstants& constants, std::size_t& chunksChecked) {
+        const std::size_t ROUNDS = 2000;
+        Lcg lcg(0x5EEDU);
+        std::size_t mismatches = 0;
+
+        for (std::size_t round = 0; round < ROUNDS; round++) {
+            AWE::DamageKernelInclination inclination = {};
+            inclination.damageReduction = lcg.Next();
+            inclination.penetratedDamageReduction = inclination.damageReduction * lcg.Next();
+            inclination.bonusScaling = lcg.Next() * 4.0f;
+            inclination.elementalStatDamage = lcg.Next() * 2000.0f;
+
+            for (std::size_t count = 1; count <= AWE::DAMAGEKERNEL_WIDTH; count++) {
+                float scalings[AWE::DAMAGEKERNEL_WIDTH];
+                AWE::ElementalAffinityValue affinities[AWE::DAMAGEKERNEL_WIDTH];
+                AWE::DamageResistanceValue resistances[AWE::DAMAGEKERNEL_WIDTH];
+                float damageSourcePercentages[AWE::DAMAGEKERNEL_WIDTH];
+                int penetrating[AWE::DAMAGEKERNEL_WIDTH];
+                for (std::size_t i = 0; i < count; i++) {
+                    scalings[i] = lcg.Next() * 3.0f;
+                    affinities[i] = lcg.NextInt(-50, 300);
+                    resistances[i] = lcg.NextInt(-50, 150);
+                    damageSourcePercentages[i] = lcg.Next();
+                    penetrating[i] = lcg.NextInt(0, 1);
+                }
+                AWE::DamageKernelBindings bindings = { scalings, affinities, resistances, damageSourcePercentages, penetrating };
+
+                float reference[AWE::DAMAGEKERNEL_WIDTH];
+                AWE::EvaluateBindingDamage(AWE::DamageKernelLevel::SCALAR, constants, inclination, bindings, count, reference);
+
+                for (unsigned short level = 1; level <= static_cast<unsigned short>(bestLevel); level++) {
+                    float output[AWE::DAMAGEKERNEL_WIDTH];
+                    AWE::EvaluateBindingDamage(static_cast<AWE::DamageKernelLevel>(level), constants, inclination, bindings, count, output);
+                    if (!SameBits(reference, output, count)) {
+                        mismatches++;
+                    }
+                }
+                chunksChecked++;
+            }
+        }
+        return mismatches;
+    }
+}
+
+/*
+ * Checks that the vectorized element binding kernels give bit-identical damage to the scalar path, for every skill, attacker, and defender in the shipped content.
+ * Run from the game's project folder, the same as the game:
+ *   damage-kernel-parity [resloc] [xmlfilename]
+ * Every level the running CPU supports is compared, through single calculations, batches, and the kernel itself. Returns nonzero on any difference.
+ */
+int main(int argc, char* argv[]) {
+    using namespace DAMAGEKERNELPARITY_PRIVATE;
+
+    std::string resloc = (argc > 1) ? argv[1] : "res";
+    std::string xmlfilename = (argc > 2) ? argv[2] : AWE::GameXLOStorage::DEFAULT_XMLFILENAME;
+
+    std::unique_ptr<AWE::GameLOVStorage> lov = std::make_unique<AWE::GameLOVStorage>();
+    if (!lov->Initialize(resloc)) {
+        std::cout << "List of values failed to initialize.\n";
+        return 1;
+    }
+
+    using namespace AWE::literals;
+    AWE::DamageInclination_shptr phys = lov->GetDamageInclination("PHYS"_abrv);
+    if (!phys) {
+        std::cout << "PHYS damage inclination was not loaded!\n";
+        return 1;
+    }
+
+    std::unique_ptr<AWE::GameXLOStorage> xlo = std::make_unique<AWE::GameXLOStorage>();
+    if (!xlo->Initialize(*lov, phys, xmlfilename.c_str())) {
+        std::cout << "XML-loaded objects failed to initialize.\n";
+        return 1;
+    }
+
+    AWE::ContentSnapshot content(std::move(lov), std::move(xlo));
+
+    std::vector<AWE::BattlerInstance> instances;
+    instances.reserve(content.battlers().size());
+    for (const AWE::ContentSnapshot::BattlerEntry& entry : content.battlers()) {
+        std::optional<AWE::BattlerInstance> instance = content.Spawn(entry.key);
+        if (instance) {
+            instances.push_back(std::move(*instance));
+        }
+    }
+
+    std::vector<AWE::DamageQuery> queries;
+    for (const auto& skill : content.xlo().skills()) {
+        for (const AWE::BattlerInstance& attacker : instances) {
+            for (const AWE::BattlerInstance& defender : instances) {
+                queries.push_back({ skill.second.get(), &attacker, &defender });
+            }
+        }
+    }
+
+    AWE::DamageCalculator calculator(content.lov(), content.xlo());
+    AWE::DamageKernelLevel bestLevel = AWE::DetectDamageKernelLevel();
+    std::size_t typeCount = calculator.batchLayout().types().size();
+    std::size_t mismatches = 0;
+
+    // The traced calculation never goes through the kernel, so it is the reference every level is held to.
+    std::vector<AWE::Damage> reference;
+    reference.reserve(queries.size());
+    for (const AWE::DamageQuery& query : queries) {
+        AWE::DamageTraceBuffer trace(1, 0, 0);
+        reference.push_back(calculator.CalculateDamage(*query.skill, *query.attacker, *query.defender, trace));
+    }
+
+    std::vector<AWE::DamageValueFinalTotal> scalarFinals(queries.size());
+    std::vector<float> scalarSubtotals(queries.size() * typeCount);
+    calculator.kernelLevel(AWE::DamageKernelLevel::SCALAR);
+    if (!calculator.CalculateDamageBatch(queries, scalarFinals, scalarSubtotals)) {
+        std::cout << "Scalar batch calculation failed.\n";
+        return 1;
+    }
+
+    for (unsigned short level = 0; level <= static_cast<unsigned short>(bestLevel); level++) {
+        AWE::DamageKernelLevel kernelLevel = static_cast<AWE::DamageKernelLevel>(level);
+        calculator.kernelLevel(kernelLevel);
+        std::size_t levelMismatches = 0;
+
+        for (std::size_t q = 0; q < queries.size(); q++) {
+            AWE::Damage damage = calculator.CalculateDamage(*queries[q].skill, *queries[q].attacker, *queries[q].defender);
+            if (!SameDamage(damage, reference[q])) {
+                levelMismatches++;
+            }
+        }
+
+        std::vector<AWE::DamageValueFinalTotal> finals(queries.size());
+        std::vector<float> subtotals(queries.size() * typeCount);
+        if (!calculator.CalculateDamageBatch(queries, finals, subtotals)) {
+            std::cout << LevelName(kernelLevel) << " batch calculation failed.\n";
+            return 1;
+        }
+        for (std::size_t q = 0; q < queries.size(); q++) {
+            if (finals[q] != reference[q].final() || finals[q] != scalarFinals[q] || !SameBits(&subtotals[q * typeCount], &scalarSubtotals[q * typeCount], typeCount)) {
+                levelMismatches++;
+            }
+        }
+
+        std::cout << LevelName(kernelLevel) << ": " << queries.size() << " calculations and batch results, " << levelMismatches << " mismatched.\n";
+        mismatches += levelMismatches;
+    }
+
+    AWE::DamageKernelConstants constants = {};
+    constants.residual = AWE::DamageCalculator::RESIDUAL_CONSTANT;
+    constants.elementalThreshold = static_cast<float>(AWE::DamageCalculator::ELEM_THRESHOLD_CONSTANT);
+    constants.mingateThreshold = AWE::DamageCalculator::ELEMTHRESH_MULTIP_CONSTANT * AWE::DamageCalculator::ELEM_THRESHOLD_CONSTANT;
+    std::size_t chunksChecked = 0;
+    std::size_t syntheticMismatches = CheckSyntheticBindings(bestLevel, constants, chunksChecked);
+    std::cout << "Synthetic bindings: " << chunksChecked << " chunks, " << syntheticMismatches << " mismatched.\n";
+    mismatches += syntheticMismatches;
+
+    if (mismatches != 0) {
+        std::cout << "Kernel levels disagree with the scalar path.\n";
+        return 1;
+    }
+    std::cout << "Every kernel level up to " << LevelName(bestLevel) << " matches the scalar path.\n";
+    return 0;
+}
@@ -1,12 +1,17 @@
 #include "abbreviatedkey.h"
 
 namespace AWE {
-    AbbreviatedKey::AbbreviatedKey() : _name(""), _abrv(ABRV::INVALID) {}
+    AbbreviatedKey::AbbreviatedKey() : _name(""), _abrv(ABRV::INVALID), _abrvchars() {}
     AbbreviatedKey::AbbreviatedKey(std::string name, ABRV abrv)
-        : _name(std::move(name)), _abrv(std::move(abrv)) {}
+            : _name(std::move(name)), _abrv(std::move(abrv)) {
+        for (int i = 0; i < static_cast<int>(ABRV::SIZE); i++) {
+            _abrvchars[i] = _abrv[i];
+        }
+    }
 
     const std::string& AbbreviatedKey::name() const { return _name; }
     std::string AbbreviatedKey::abrvstr() const { return _abrv.AsString(); }
+    std::span<const char, ABRV::SIZE> AbbreviatedKey::abrvspan() const { return std::span<const char, ABRV::SIZE>(_abrvchars, ABRV::SIZE); }
     unsigned long AbbreviatedKey::abrvlong() const { return _abrv.AsLong(); }
 
     bool AbbreviatedKey::Equals(const AbbreviatedKey& other) const { return _abrv.Equals(other._abrv); }
@@ -1,4 +1,5 @@
 #pragma once
+#include <span>
 #include <string>
 #include "abrv.h"
 
@@ -10,6 +11,7 @@ namespace AWE {
     protected:
         std::string _name;
         ABRV _abrv;
+        char _abrvchars[ABRV::SIZE];
     public:
         /// <summary>
         /// Default constructor. Initializes the object with an empty name and an invalid ABRV.
@@ -22,6 +24,8 @@ namespace AWE {
 
         /// <returns>The internal ABRV object in string form.</returns>
         std::string abrvstr() const;
+        /// <returns>The internal ABRV object's `char`s, cached when the key was created. Unlike abrvstr, does not allocate.</returns>
+        std::span<const char, ABRV::SIZE> abrvspan() const;
         /// <returns>The internal ABRV object in `unsigned long` form.</returns>
         ABRV_long abrvlong() const;
 
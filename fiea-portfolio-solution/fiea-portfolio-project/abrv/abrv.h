@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <string>
 
 namespace AWE {
@@ -9,25 +10,30 @@ namespace AWE {
 
     /// <summary>
     /// See ABRV typedef definition.
+    /// Only the ABRV_long is stored; the `char`s are shifted back out of it when asked for. Everything is `constexpr`, so an ABRV made of literal `char`s costs nothing at runtime.
     /// </summary>
     class FourLetterAbbreviation {
     private:
-        char _first;
-        char _second;
-        char _third;
-        char _fourth;
         ABRV_long _long;
 
     public:
         /// <summary>
         /// Default constructor. Initializes an invalid ABRV object with an `unsigned long` of 0 and all `char`s as the null character.
         /// </summary>
-        FourLetterAbbreviation();
-        FourLetterAbbreviation(char first, char second, char third, char fourth);
+        constexpr FourLetterAbbreviation() : _long(0) {}
+        constexpr FourLetterAbbreviation(char first, char second, char third, char fourth)
+            : _long(static_cast<ABRV_long>(static_cast<unsigned char>(first))
+                | (static_cast<ABRV_long>(static_cast<unsigned char>(second)) << 8)
+                | (static_cast<ABRV_long>(static_cast<unsigned char>(third)) << 16)
+                | (static_cast<ABRV_long>(static_cast<unsigned char>(fourth)) << 24)) {}
+        /// <summary>
+        /// Constructor. Recreates the ABRV which has the given ABRV_long, e.g. one made by the `_abrv` literal.
+        /// </summary>
+        constexpr explicit FourLetterAbbreviation(ABRV_long value) : _long(value) {}
 
         /// <param name="index">Should be 0, 1, 2, or 3. Passing any other index will result in a null character.</param>
         /// <returns>The respective `char`, or a null character if a bad index is passed.</returns>
-        char operator[](int index) const;
+        constexpr char operator[](int index) const { return (index >= 0 && index < static_cast<int>(SIZE)) ? static_cast<char>((_long >> (8 * index)) & 0xFF) : 0; }
 
         /// <summary>
         /// Any ABRV which is equivalent to this object is not valid.
@@ -40,34 +46,39 @@ namespace AWE {
         static const size_t SIZE = 4;
 
         /// <returns>The first `char`.</returns>
-        char first() const;
+        constexpr char first() const { return (*this)[0]; }
         /// <returns>The second `char`.</returns>
-        char second() const;
+        constexpr char second() const { return (*this)[1]; }
         /// <returns>The third `char`.</returns>
-        char third() const;
+        constexpr char third() const { return (*this)[2]; }
         /// <returns>The fourth `char`.</returns>
-        char fourth() const;
+        constexpr char fourth() const { return (*this)[3]; }
 
         /// <summary>
         /// Example:
         /// ABRV ex1 = { first = 'A', second = 'B', third = 'C', fourth = 'D' };
         /// ex1.AsString() results in "ABCD".
-        /// Not very complicated stuff.
+        /// Not very complicated stuff. Four `char`s always fit in the string's own buffer, so this does not allocate.
         /// </summary>
         /// <returns>All `char`s concatenated in order.</returns>
-        std::string AsString() const;
+        constexpr std::string AsString() const {
+            const char chars[SIZE] = { first(), second(), third(), fourth() };
+            return std::string(chars, SIZE);
+        }
 
         /// <summary>
         /// The exact method used to create this number is not that important. What is important is this: Every ABRV created with the same `char`s in the same positions will always have the same ABRV_long.
         /// </summary>
         /// <returns>All four 8-bit `char`s bitshifted into a single 32-bit number.</returns>
-        ABRV_long AsLong() const;
+        constexpr ABRV_long AsLong() const { return _long; }
 
         /// <param name="other">The other ABRV object.</param>
         /// <returns>Equivalence to the other ABRV.</returns>
-        bool Equals(FourLetterAbbreviation other) const;
+        constexpr bool Equals(FourLetterAbbreviation other) const { return _long == other._long; }
     };
 
+    inline constexpr FourLetterAbbreviation FourLetterAbbreviation::INVALID = FourLetterAbbreviation();
+
     /// <summary>
     /// FourLetterAbbreviation (abbreviated as ABRV) provides a way to give data-driven list-of-values entries a key which is at once
     /// indexable in maps at O(1) speed,
@@ -84,4 +95,20 @@ namespace AWE {
     /// The `unsigned long` value of an invalid ABRV.
     /// </summary>
     static ABRV_long const INVALID_ABRV_LONG = 0;
+
+    inline namespace literals {
+        /// <summary>
+        /// Example:
+        /// "PHYS"_abrv is the same number as ABRV('P', 'H', 'Y', 'S').AsLong(), but is always worked out while compiling, so well-known keys can be used as `case` labels and in `constexpr` tables.
+        /// Anything other than exactly four `char`s does not compile.
+        /// Outside of the AWE namespace, bring it in with `using namespace AWE::literals;`.
+        /// </summary>
+        /// <returns>The ABRV_long of the four `char`s.</returns>
+        consteval ABRV_long operator""_abrv(const char* str, std::size_t length) {
+            if (length != ABRV::SIZE) {
+                throw "An ABRV literal must be exactly four characters long.";
+            }
+            return ABRV(str[0], str[1], str[2], str[3]).AsLong();
+        }
+    }
 }
@@ -3,9 +3,13 @@
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include "state/battlerdecision.h"
+#include "state/battlerprogression.h"
 #include "state/gamebattleinfo.h"
 #include "state/gamestate.h"
 #include "state/gamestatemachine.h"
+#include "misc/contentpack.h"
+#include "misc/mappedfile.h"
+#include "store/contentsnapshot.h"
 #include "store/gamelovstorage.h"
 #include "store/gamesfmlstorage.h"
 #include "store/gamexlostorage.h"
@@ -25,26 +29,49 @@ int main() {
 
     // Storage initialization. All "storage" objects are loaded and initialized.
 
-    AWE::GameLOVStorage lov;
-    if (!lov.Initialize("res")) {
-        std::cout << "List of values failed to initialize.\n";
-        return 1;
+    auto lov = std::make_unique<AWE::GameLOVStorage>();
+    auto xlo = std::make_unique<AWE::GameXLOStorage>();
+
+    // A compiled content pack is preferred. It is only read while the storages load, so it is unmapped as soon as they are done.
+    bool isPackLoaded = false;
+    {
+        AWE::MappedFile packFile;
+        AWE::ContentPack pack;
+        isPackLoaded = packFile.Open(AWE::ContentPack::DEFAULT_FILENAME)
+            && pack.Attach(packFile.data(), packFile.size())
+            && lov->Initialize(pack)
+            && xlo->Initialize(*lov, pack);
+
+        if (packFile.isOpen() && !isPackLoaded) {
+            std::cout << AWE::ContentPack::DEFAULT_FILENAME << " could not be loaded. Falling back to the text and XML files.\n";
+        }
     }
 
-    AWE::ABRV physabrv('P', 'H', 'Y', 'S');
-    AWE::DamageInclination_shptr phys = lov.GetDamageInclination(physabrv.AsLong());
-    if (!phys) {
-        std::cout << "PHYS damage inclination was not loaded!\n";
-        return 1;
-    }
+    if (!isPackLoaded) {
+        lov = std::make_unique<AWE::GameLOVStorage>();
+        if (!lov->Initialize("res")) {
+            std::cout << "List of values failed to initialize.\n";
+            return 1;
+        }
 
-    AWE::GameXLOStorage xlo;
-    if (!xlo.Initialize(lov, phys, "res/data.xml")) {
-        std::cout << "XML-loaded objects failed to initialize.\n";
-        return 1;
+        using namespace AWE::literals;
+        AWE::DamageInclination_shptr phys = lov->GetDamageInclination("PHYS"_abrv);
+        if (!phys) {
+            std::cout << "PHYS damage inclination was not loaded!\n";
+            return 1;
+        }
+
+        xlo = std::make_unique<AWE::GameXLOStorage>();
+        if (!xlo->Initialize(*lov, phys, "res/data.xml")) {
+            std::cout << "XML-loaded objects failed to initialize.\n";
+            return 1;
+        }
     }
 
-    AWE::GameBattleInfo battle(lov, xlo);
+    // Once loaded, content is frozen. Everything the player changes goes in the progression instead.
+    auto content = std::make_shared<const AWE::ContentSnapshot>(std::move(lov), std::move(xlo));
+    AWE::BattlerProgression progression(content);
+    AWE::GameBattleInfo battle(progression, AWE::GameBattleInfo::BATTLE_ARENA_SIZE);
     AWE::GameSFMLStorage sfmls;
     if (sfmls.loadFailed()) {
         std::cout << "SFML-loaded objects failed to initialize.\n";
@@ -77,7 +104,7 @@ int main() {
     // State machine initialization. State machine is configured for the beginning of the game, which due to a special state will proceed into the battle configuration automatically.
 
     sf::Sound currentSound;
-    AWE::GameStateMachine states(xlo, scenes, battle, sfmls, currentSound);
+    AWE::GameStateMachine states(progression, scenes, battle, sfmls, currentSound);
     states.ConfigureForBeginning();
 
 
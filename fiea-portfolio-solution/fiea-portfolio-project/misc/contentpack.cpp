@@ -0,0 +1,653 @@
+#include "contentpack.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "../store/gamelovstorage.h"
+#include "../store/gamexlostorage.h"
+
+namespace AWE {
+    namespace CONTENTPACK_PRIVATE {
+        /// <summary>
+        /// Position of each section in ContentPack's arrays. Also the order the sections are written in.
+        /// </summary>
+        enum SectionPosition : std::size_t {
+            STRINGS,
+            INDICES,
+            SYMBOLS,
+            BATTLERSTATS,
+            DAMAGEINCLINATIONS,
+            DAMAGETYPES,
+            EQUIPMENTTYPES,
+            SKILLELEMENTS,
+            SKILLELEMENTGROUPS,
+            DEFAULTEQUIPMENTSLOTS,
+            INCLINATIONSTATS,
+            SKILLS,
+            SKILLDAMAGES,
+            STATSCALINGS,
+            ELEMENTBINDINGS,
+            STATVALUES,
+            CONVERSIONS,
+            EQUIPMENT,
+            BATTLERS,
+            SECTION_POSITION_COUNT
+        };
+
+        struct SectionLayout {
+            ContentPackSectionId id;
+            std::size_t recordSize;
+        };
+
+        static const SectionLayout SECTION_LAYOUTS[SECTION_POSITION_COUNT] = {
+            { ContentPackSectionId::STRINGS, sizeof(char) },
+            { ContentPackSectionId::INDICES, sizeof(ContentPackIndex) },
+            { ContentPackSectionId::SYMBOLS, sizeof(ContentPackString) },
+            { ContentPackSectionId::BATTLERSTATS, sizeof(ContentPackLOVEntry) },
+            { ContentPackSectionId::DAMAGEINCLINATIONS, sizeof(ContentPackLOVEntry) },
+            { ContentPackSectionId::DAMAGETYPES, sizeof(ContentPackLOVEntry) },
+            { ContentPackSectionId::EQUIPMENTTYPES, sizeof(ContentPackLOVEntry) },
+            { ContentPackSectionId::SKILLELEMENTS, sizeof(ContentPackLOVEntry) },
+            { ContentPackSectionId::SKILLELEMENTGROUPS, sizeof(ContentPackElementGroup) },
+            { ContentPackSectionId::DEFAULTEQUIPMENTSLOTS, sizeof(ContentPackSlotCount) },
+            { ContentPackSectionId::INCLINATIONSTATS, sizeof(ContentPackInclinationStats) },
+            { ContentPackSectionId::SKILLS, sizeof(ContentPackSkill) },
+            { ContentPackSectionId::SKILLDAMAGES, sizeof(ContentPackSkillDamage) },
+            { ContentPackSectionId::STATSCALINGS, sizeof(ContentPackStatScaling) },
+            { ContentPackSectionId::ELEMENTBINDINGS, sizeof(ContentPackElementBinding) },
+            { ContentPackSectionId::STATVALUES, sizeof(ContentPackStatValue) },
+            { ContentPackSectionId::CONVERSIONS, sizeof(ContentPackConversion) },
+            { ContentPackSectionId::EQUIPMENT, sizeof(ContentPackEquipment) },
+            { ContentPackSectionId::BATTLERS, sizeof(ContentPackBattler) }
+        };
+
+        // Records are read straight out of the file, so their layout must not depend on the compiler.
+        static_assert(sizeof(ContentPackHeader) == 24 && sizeof(ContentPackSection) == 16, "Content pack header layout changed.");
+        static_assert(sizeof(ContentPackLOVEntry) == 12 && sizeof(ContentPackElementGroup) == 24 && sizeof(ContentPackInclinationStats) == 20, "Content pack LOV layout changed.");
+        static_assert(sizeof(ContentPackSkill) == 24 && sizeof(ContentPackSkillDamage) == 28 && sizeof(ContentPackStatScaling) == 12 && sizeof(ContentPackElementBinding) == 20, "Content pack skill layout changed.");
+        static_assert(sizeof(ContentPackEquipment) == 32 && sizeof(ContentPackBattler) == 36, "Content pack equipment or battler layout changed.");
+        static_assert(std::is_trivially_copyable_v<ContentPackBattler> && std::is_trivially_copyable_v<ContentPackSkillDamage>, "Content pack records must be trivially copyable.");
+
+        /// <returns>Does the given range fit in a section of the given size?</returns>
+        bool IsInRange(ContentPackRange range, std::size_t size) {
+            return range.first <= size && range.count <= size - range.first;
+        }
+
+        /// <returns>Is every index in the given range of the index section less than the given size?</returns>
+        bool AreIndicesInRange(std::span<const ContentPackIndex> indices, ContentPackRange range, std::size_t size) {
+            if (!IsInRange(range, indices.size())) {
+                return false;
+            }
+            for (ContentPackIndex index : ContentPack::GetRange(indices, range)) {
+                if (index >= size) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// <returns>Are the keys of the given LOV section strictly increasing, and do they match the keys of the given table?</returns>
+        template <typename T>
+        bool MatchesTable(std::span<const T> entries, const std::vector<ABRV_long>& keys) {
+            if (entries.size() != keys.size()) {
+                return false;
+            }
+            for (std::size_t i = 0; i < entries.size(); i++) {
+                if (entries[i].key != keys[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Gathers the sections of a pack while the storages are walked, then lays them out and writes them.
+        /// </summary>
+        class PackBuilder {
+        private:
+            std::vector<char> _strings;
+            std::unordered_map<std::string, ContentPackString> _pooled;
+
+        public:
+            std::vector<ContentPackIndex> indices;
+            std::vector<ContentPackString> symbols;
+            std::vector<ContentPackLOVEntry> battlerStats;
+            std::vector<ContentPackLOVEntry> damageInclinations;
+            std::vector<ContentPackLOVEntry> damageTypes;
+            std::vector<ContentPackLOVEntry> equipmentTypes;
+            std::vector<ContentPackLOVEntry> skillElements;
+            std::vector<ContentPackElementGroup> skillElementGroups;
+            std::vector<ContentPackSlotCount> defaultEquipmentSlots;
+            std::vector<ContentPackInclinationStats> inclinationStats;
+            std::vector<ContentPackSkill> skills;
+            std::vector<ContentPackSkillDamage> skillDamages;
+            std::vector<ContentPackStatScaling> statScalings;
+            std::vector<ContentPackElementBinding> elementBindings;
+            std::vector<ContentPackStatValue> statValues;
+            std::vector<ContentPackConversion> conversions;
+            std::vector<ContentPackEquipment> equipment;
+            std::vector<ContentPackBattler> battlers;
+
+            /// <returns>The given string in the pool. Equal strings are only pooled once.</returns>
+            ContentPackString AddString(const std::string& str) {
+                auto found = _pooled.find(str);
+                if (found != _pooled.end()) {
+                    return found->second;
+                }
+
+                ContentPackString pooled { static_cast<std::uint32_t>(_strings.size()), static_cast<std::uint32_t>(str.size()) };
+                _strings.insert(_strings.end(), str.begin(), str.end());
+                _pooled.insert(std::make_pair(str, pooled));
+                return pooled;
+            }
+
+            /// <returns>Range of the index section holding the given indices.</returns>
+            ContentPackRange AddIndices(const std::vector<ContentPackIndex>& list) {
+                ContentPackRange range { static_cast<ContentPackIndex>(indices.size()), static_cast<std::uint32_t>(list.size()) };
+                indices.insert(indices.end(), list.begin(), list.end());
+                return range;
+            }
+
+            /// <returns>The pack, laid out with its header, section table and checksum.</returns>
+            std::vector<unsigned char> Build() const {
+                const std::pair<const void*, std::size_t> sections[SECTION_POSITION_COUNT] = {
+                    { _strings.data(), _strings.size() },
+                    { indices.data(), indices.size() },
+                    { symbols.data(), symbols.size() },
+                    { battlerStats.data(), battlerStats.size() },
+                    { damageInclinations.data(), damageInclinations.size() },
+                    { damageTypes.data(), damageTypes.size() },
+                    { equipmentTypes.data(), equipmentTypes.size() },
+                    { skillElements.data(), skillElements.size() },
+                    { skillElementGroups.data(), skillElementGroups.size() },
+                    { defaultEquipmentSlots.data(), defaultEquipmentSlots.size() },
+                    { inclinationStats.data(), inclinationStats.size() },
+                    { skills.data(), skills.size() },
+                    { skillDamages.data(), skillDamages.size() },
+                    { statScalings.data(), statScalings.size() },
+                    { elementBindings.data(), elementBindings.size() },
+                    { statValues.data(), statValues.size() },
+                    { conversions.data(), conversions.size() },
+                    { equipment.data(), equipment.size() },
+                    { battlers.data(), battlers.size() }
+                };
+
+                ContentPackSection table[SECTION_POSITION_COUNT];
+                std::size_t size = sizeof(ContentPackHeader) + sizeof(table);
+                for (std::size_t i = 0; i < SECTION_POSITION_COUNT; i++) {
+                    size = (size + ContentPack::ALIGNMENT - 1) / ContentPack::ALIGNMENT * ContentPack::ALIGNMENT;
+                    table[i] = ContentPackSection { SECTION_LAYOUTS[i].id, static_cast<std::uint32_t>(sections[i].second), size };
+                    size += sections[i].second * SECTION_LAYOUTS[i].recordSize;
+                }
+
+                // Padding stays zeroed, so the same content always compiles to the same bytes.
+                std::vector<unsigned char> pack(size, 0);
+                std::copy_n(reinterpret_cast<const unsigned char*>(table), sizeof(table), pack.data() + sizeof(ContentPackHeader));
+                for (std::size_t i = 0; i < SECTION_POSITION_COUNT; i++) {
+                    if (sections[i].second > 0) {
+                        std::copy_n(static_cast<const unsigned char*>(sections[i].first), sections[i].second * SECTION_LAYOUTS[i].recordSize, pack.data() + table[i].offset);
+                    }
+                }
+
+                ContentPackHeader header {
+                    ContentPack::MAGIC,
+                    ContentPack::VERSION,
+                    static_cast<std::uint16_t>(SECTION_POSITION_COUNT),
+                    ContentPack::Checksum(pack.data() + sizeof(ContentPackHeader), pack.size() - sizeof(ContentPackHeader)),
+                    0,
+                    pack.size()
+                };
+                std::copy_n(reinterpret_cast<const unsigned char*>(&header), sizeof(header), pack.data());
+                return pack;
+            }
+        };
+
+        /// <summary>
+        /// Adds every entry of the given table, in index order.
+        /// </summary>
+        template <typename T>
+        void AddLOVEntries(PackBuilder& builder, std::vector<ContentPackLOVEntry>& output, const LOVIndexTable<T>& table) {
+            for (const std::shared_ptr<T>& entry : table.values()) {
+                output.push_back(ContentPackLOVEntry { static_cast<std::uint32_t>(entry->abrvlong()), builder.AddString(entry->name()) });
+            }
+        }
+
+        /// <returns>Index of the given key in the given table, or CONTENTPACK_NO_INDEX if it is not in the table.</returns>
+        template <typename T>
+        ContentPackIndex GetIndex(const LOVIndexTable<T>& table, ABRV_long key) {
+            LOVIndex index = table.GetIndex(key);
+            return (index < table.size()) ? index : CONTENTPACK_NO_INDEX;
+        }
+
+        /// <returns>Index of the given entry in the given table, or CONTENTPACK_NO_INDEX if it is empty or not in the table.</returns>
+        template <typename T>
+        ContentPackIndex GetIndex(const LOVIndexTable<T>& table, const std::shared_ptr<T>& entry) {
+            return entry ? GetIndex(table, entry->abrvlong()) : CONTENTPACK_NO_INDEX;
+        }
+    }
+
+    using namespace CONTENTPACK_PRIVATE;
+
+    const std::uint32_t ContentPack::MAGIC = static_cast<std::uint32_t>("AWEP"_abrv);
+    const std::uint16_t ContentPack::VERSION = 1;
+    const char* ContentPack::DEFAULT_FILENAME = "res/content.pack";
+
+    std::uint32_t ContentPack::Checksum(const unsigned char* data, std::size_t size) {
+        std::uint32_t hash = 2166136261u;
+        for (std::size_t i = 0; i < size; i++) {
+            hash ^= data[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    ContentPack::ContentPack() : _data(nullptr), _size(0), _sections(), _counts() {}
+
+    bool ContentPack::isAttached() const { return _data != nullptr; }
+
+    template <typename T>
+    std::span<const T> ContentPack::Section(std::size_t position) const {
+        return _sections[position] ? std::span<const T>(reinterpret_cast<const T*>(_sections[position]), _counts[position]) : std::span<const T>();
+    }
+
+    bool ContentPack::Attach(const unsigned char* data, std::size_t size) {
+        Detach();
+
+        static_assert(SECTION_COUNT == SECTION_POSITION_COUNT, "Every section needs a layout.");
+        const std::size_t tableEnd = sizeof(ContentPackHeader) + SECTION_COUNT * sizeof(ContentPackSection);
+        if (!data || size < tableEnd || reinterpret_cast<std::uintptr_t>(data) % ALIGNMENT != 0) {
+            return false;
+        }
+
+        const ContentPackHeader* header = reinterpret_cast<const ContentPackHeader*>(data);
+        if (header->magic != MAGIC || header->version != VERSION || header->sectionCount != SECTION_COUNT || header->size != size) {
+            return false;
+        }
+        if (header->checksum != Checksum(data + sizeof(ContentPackHeader), size - sizeof(ContentPackHeader))) {
+            return false;
+        }
+
+        const ContentPackSection* table = reinterpret_cast<const ContentPackSection*>(data + sizeof(ContentPackHeader));
+        for (std::size_t i = 0; i < SECTION_COUNT; i++) {
+            std::size_t position = 0;
+            while (position < SECTION_COUNT && SECTION_LAYOUTS[position].id != table[i].id) {
+                position++;
+            }
+
+            // Unknown and repeated sections are refused.
+            if (position == SECTION_COUNT || _sections[position]) {
+                Detach();
+                return false;
+            }
+
+            const std::uint64_t offset = table[i].offset;
+            if (offset < tableEnd || offset > size || offset % ALIGNMENT != 0 || table[i].count > (size - offset) / SECTION_LAYOUTS[position].recordSize) {
+                Detach();
+                return false;
+            }
+
+            _sections[position] = data + offset;
+            _counts[position] = table[i].count;
+        }
+
+        _data = data;
+        _size = size;
+
+        if (!ValidateRecords()) {
+            Detach();
+            return false;
+        }
+
+        return true;
+    }
+
+    void ContentPack::Detach() {
+        _data = nullptr;
+        _size = 0;
+        _sections.fill(nullptr);
+        _counts.fill(0);
+    }
+
+    bool ContentPack::ValidateRecords() const {
+        auto isString = [this](ContentPackString str) { return IsInRange(ContentPackRange { str.offset, str.length }, strings().size()); };
+        auto isSymbol = [this](SymbolID symbol) { return symbol != SymbolTable::INVALID_ID && symbol <= symbols().size(); };
+        auto isInclination = [this](ContentPackIndex index) { return index < damageInclinations().size(); };
+        auto isStat = [this](ContentPackIndex index) { return index < battlerStats().size(); };
+
+        for (const ContentPackString& symbol : symbols()) {
+            if (!isString(symbol)) {
+                return false;
+            }
+        }
+
+        // Every LOV section has to be sorted by key, without repeats, for its positions to be the indices LOVIndexTable assigns.
+        for (std::span<const ContentPackLOVEntry> lov : { battlerStats(), damageInclinations(), damageTypes(), equipmentTypes(), skillElements() }) {
+            for (std::size_t i = 0; i < lov.size(); i++) {
+                if (!isString(lov[i].name) || lov[i].key == INVALID_ABRV_LONG || (i > 0 && lov[i - 1].key >= lov[i].key)) {
+                    return false;
+                }
+            }
+        }
+
+        std::span<const ContentPackElementGroup> groups = skillElementGroups();
+        for (std::size_t i = 0; i < groups.size(); i++) {
+            const ContentPackElementGroup& group = groups[i];
+            if (!isString(group.name) || group.key == INVALID_ABRV_LONG || (i > 0 && groups[i - 1].key >= group.key) || group.members.count < 2) {
+                return false;
+            }
+            if (!AreIndicesInRange(indices(), group.members, group.isGroups ? groups.size() : skillElements().size())) {
+                return false;
+            }
+            std::span<const ContentPackIndex> members = GetRange(indices(), group.members);
+            if (group.isGroups && std::find(members.begin(), members.end(), i) != members.end()) {
+                return false;
+            }
+        }
+
+        for (const ContentPackSlotCount& slot : defaultEquipmentSlots()) {
+            if (slot.equipmentType >= equipmentTypes().size()) {
+                return false;
+            }
+        }
+
+        for (const ContentPackInclinationStats& stats : inclinationStats()) {
+            if (!isInclination(stats.inclination) || !AreIndicesInRange(indices(), stats.attacking, battlerStats().size()) || !AreIndicesInRange(indices(), stats.defending, battlerStats().size())) {
+                return false;
+            }
+        }
+
+        for (const ContentPackSkill& skill : skills()) {
+            if (!isSymbol(skill.symbol) || !isString(skill.sound) || !IsInRange(skill.damages, skillDamages().size())) {
+                return false;
+            }
+        }
+
+        for (const ContentPackSkillDamage& damage : skillDamages()) {
+            if (damage.baseInclination != CONTENTPACK_NO_INDEX && !isInclination(damage.baseInclination)) {
+                return false;
+            }
+            auto inclinations = damageInclinations();
+            bool isKnownInclination = damage.inclinationKey == DamageInclination::AUTO_KEY.AsLong()
+                || std::binary_search(inclinations.begin(), inclinations.end(), damage.inclinationKey, [](const auto& left, const auto& right) {
+                    if constexpr (std::is_same_v<std::decay_t<decltype(left)>, ContentPackLOVEntry>) {
+                        return left.key < right;
+                    } else {
+                        return left < right.key;
+                    }
+                });
+            if (!isKnownInclination || !IsInRange(damage.statScalings, statScalings().size()) || !IsInRange(damage.elementBindings, elementBindings().size())) {
+                return false;
+            }
+        }
+
+        for (const ContentPackStatScaling& scaling : statScalings()) {
+            if (!isInclination(scaling.inclination) || !isStat(scaling.stat)) {
+                return false;
+            }
+        }
+
+        for (const ContentPackElementBinding& binding : elementBindings()) {
+            std::size_t targets = (binding.flags & ContentPackElementBinding::FLAG_GROUP) ? skillElementGroups().size() : skillElements().size();
+            if (!isInclination(binding.inclination) || binding.damageType >= damageTypes().size() || binding.target >= targets) {
+                return false;
+            }
+        }
+
+        for (const ContentPackStatValue& value : statValues()) {
+            if (!isStat(value.stat)) {
+                return false;
+            }
+        }
+
+        for (const ContentPackConversion& conversion : conversions()) {
+            if (conversion.group >= skillElementGroups().size() || conversion.element >= skillElements().size()) {
+                return false;
+            }
+        }
+
+        for (const ContentPackEquipment& eq : equipment()) {
+            if (!isSymbol(eq.symbol) || eq.equipmentType >= equipmentTypes().size() || !IsInRange(eq.bonusStats, statValues().size()) || !IsInRange(eq.conversions, conversions().size())
+                    || !AreIndicesInRange(indices(), eq.skills, skills().size())) {
+                return false;
+            }
+        }
+
+        for (const ContentPackBattler& battler : battlers()) {
+            if (!isSymbol(battler.symbol) || battler.priority > 0xFFFF || !IsInRange(battler.stats, statValues().size()) || !AreIndicesInRange(indices(), battler.startingEquipment, equipment().size())) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool ContentPack::Matches(const GameLOVStorage& lov) const {
+        return isAttached()
+            && MatchesTable(battlerStats(), lov.battlerStatIndices().keys())
+            && MatchesTable(damageInclinations(), lov.damageInclinationIndices().keys())
+            && MatchesTable(damageTypes(), lov.damageTypeIndices().keys())
+            && MatchesTable(equipmentTypes(), lov.equipmentTypeIndices().keys())
+            && MatchesTable(skillElements(), lov.skillElementIndices().keys())
+            && MatchesTable(skillElementGroups(), lov.skillElementGroupIndices().keys());
+    }
+
+    std::span<const char> ContentPack::strings() const { return Section<char>(STRINGS); }
+    std::span<const ContentPackIndex> ContentPack::indices() const { return Section<ContentPackIndex>(INDICES); }
+    std::span<const ContentPackString> ContentPack::symbols() const { return Section<ContentPackString>(SYMBOLS); }
+    std::span<const ContentPackLOVEntry> ContentPack::battlerStats() const { return Section<ContentPackLOVEntry>(BATTLERSTATS); }
+    std::span<const ContentPackLOVEntry> ContentPack::damageInclinations() const { return Section<ContentPackLOVEntry>(DAMAGEINCLINATIONS); }
+    std::span<const ContentPackLOVEntry> ContentPack::damageTypes() const { return Section<ContentPackLOVEntry>(DAMAGETYPES); }
+    std::span<const ContentPackLOVEntry> ContentPack::equipmentTypes() const { return Section<ContentPackLOVEntry>(EQUIPMENTTYPES); }
+    std::span<const ContentPackLOVEntry> ContentPack::skillElements() const { return Section<ContentPackLOVEntry>(SKILLELEMENTS); }
+    std::span<const ContentPackElementGroup> ContentPack::skillElementGroups() const { return Section<ContentPackElementGroup>(SKILLELEMENTGROUPS); }
+    std::span<const ContentPackSlotCount> ContentPack::defaultEquipmentSlots() const { return Section<ContentPackSlotCount>(DEFAULTEQUIPMENTSLOTS); }
+    std::span<const ContentPackInclinationStats> ContentPack::inclinationStats() const { return Section<ContentPackInclinationStats>(INCLINATIONSTATS); }
+    std::span<const ContentPackSkill> ContentPack::skills() const { return Section<ContentPackSkill>(SKILLS); }
+    std::span<const ContentPackSkillDamage> ContentPack::skillDamages() const { return Section<ContentPackSkillDamage>(SKILLDAMAGES); }
+    std::span<const ContentPackStatScaling> ContentPack::statScalings() const { return Section<ContentPackStatScaling>(STATSCALINGS); }
+    std::span<const ContentPackElementBinding> ContentPack::elementBindings() const { return Section<ContentPackElementBinding>(ELEMENTBINDINGS); }
+    std::span<const ContentPackStatValue> ContentPack::statValues() const { return Section<ContentPackStatValue>(STATVALUES); }
+    std::span<const ContentPackConversion> ContentPack::conversions() const { return Section<ContentPackConversion>(CONVERSIONS); }
+    std::span<const ContentPackEquipment> ContentPack::equipment() const { return Section<ContentPackEquipment>(EQUIPMENT); }
+    std::span<const ContentPackBattler> ContentPack::battlers() const { return Section<ContentPackBattler>(BATTLERS); }
+
+    std::string_view ContentPack::GetString(ContentPackString str) const { return std::string_view(strings().data() + str.offset, str.length); }
+
+    bool WriteContentPack(const GameLOVStorage& lov, const GameXLOStorage& xlo, const std::string& filename) {
+        if (!lov.isInitialized() || !xlo.isInitialized()) {
+            std::cout << "WriteContentPack: Both storages must be initialized.\n";
+            return false;
+        }
+
+        PackBuilder builder;
+
+        // Lists of values, in index order.
+
+        AddLOVEntries(builder, builder.battlerStats, lov.battlerStatIndices());
+        AddLOVEntries(builder, builder.damageInclinations, lov.damageInclinationIndices());
+        AddLOVEntries(builder, builder.damageTypes, lov.damageTypeIndices());
+        AddLOVEntries(builder, builder.equipmentTypes, lov.equipmentTypeIndices());
+        AddLOVEntries(builder, builder.skillElements, lov.skillElementIndices());
+
+        for (const SkillElementGroup_shptr& group : lov.skillElementGroupIndices().values()) {
+            std::vector<ContentPackIndex> members;
+            if (group->isGroups()) {
+                for (const SkillElementGroup_shptr& member : *group->groups()) {
+                    members.push_back(GetIndex(lov.skillElementGroupIndices(), member));
+                }
+            } else {
+                for (const SkillElement_shptr& member : group->elements()) {
+                    members.push_back(GetIndex(lov.skillElementIndices(), member));
+                }
+            }
+
+            builder.skillElementGroups.push_back(ContentPackElementGroup {
+                static_cast<std::uint32_t>(group->abrvlong()),
+                builder.AddString(group->name()),
+                group->isGroups() ? 1u : 0u,
+                builder.AddIndices(members)
+            });
+        }
+
+        // Settings, sorted by index so the same content always compiles to the same pack.
+
+        for (const EquipmentTypeCountMap::value_type& slot : xlo.defaultEquipmentSlotSchema()) {
+            builder.defaultEquipmentSlots.push_back(ContentPackSlotCount { GetIndex(lov.equipmentTypeIndices(), slot.first), slot.second });
+        }
+        std::sort(builder.defaultEquipmentSlots.begin(), builder.defaultEquipmentSlots.end(), [](const ContentPackSlotCount& left, const ContentPackSlotCount& right) { return left.equipmentType < right.equipmentType; });
+
+        for (ABRV_long inclination : lov.damageInclinationIndices().keys()) {
+            auto attacking = xlo.inclinationAttackingStats().find(inclination);
+            auto defending = xlo.inclinationDefendingStats().find(inclination);
+            if (attacking == xlo.inclinationAttackingStats().end() && defending == xlo.inclinationDefendingStats().end()) {
+                continue;
+            }
+
+            std::vector<ContentPackIndex> attackingStats;
+            if (attacking != xlo.inclinationAttackingStats().end()) {
+                for (const BattlerStat_shptr& stat : attacking->second) {
+                    attackingStats.push_back(GetIndex(lov.battlerStatIndices(), stat));
+                }
+            }
+            std::vector<ContentPackIndex> defendingStats;
+            if (defending != xlo.inclinationDefendingStats().end()) {
+                for (const BattlerStat_shptr& stat : defending->second) {
+                    defendingStats.push_back(GetIndex(lov.battlerStatIndices(), stat));
+                }
+            }
+
+            builder.inclinationStats.push_back(ContentPackInclinationStats {
+                GetIndex(lov.damageInclinationIndices(), inclination),
+                builder.AddIndices(attackingStats),
+                builder.AddIndices(defendingStats)
+            });
+        }
+
+        // Interned names, in ID order.
+
+        for (SymbolID id = 1; id <= xlo.symbols().size(); id++) {
+            builder.symbols.push_back(builder.AddString(xlo.symbols().GetName(id)));
+        }
+
+        // Skills, equipment and battlers, in the order they were loaded.
+
+        std::unordered_map<const Skill*, ContentPackIndex> skillIndices;
+        for (const SkillMap::value_type& skill : xlo.skills()) {
+            skillIndices.insert(std::make_pair(skill.second.get(), static_cast<ContentPackIndex>(builder.skills.size())));
+            ContentPackRange damages { static_cast<ContentPackIndex>(builder.skillDamages.size()), static_cast<std::uint32_t>(skill.second->damages().size()) };
+
+            for (const SkillDamage& damage : skill.second->damages()) {
+                ContentPackRange scalings { static_cast<ContentPackIndex>(builder.statScalings.size()), static_cast<std::uint32_t>(damage.statScalings().size()) };
+                for (const SkillStatScaling& scaling : damage.statScalings()) {
+                    builder.statScalings.push_back(ContentPackStatScaling {
+                        scaling.value(),
+                        GetIndex(lov.damageInclinationIndices(), scaling.inclination()),
+                        GetIndex(lov.battlerStatIndices(), scaling.battlerStat())
+                    });
+                }
+
+                ContentPackRange bindings { static_cast<ContentPackIndex>(builder.elementBindings.size()), static_cast<std::uint32_t>(damage.elementBindings().size()) };
+                for (const SkillElementBinding& binding : damage.elementBindings()) {
+                    builder.elementBindings.push_back(ContentPackElementBinding {
+                        binding.scaling(),
+                        GetIndex(lov.damageInclinationIndices(), binding.inclination()),
+                        GetIndex(lov.damageTypeIndices(), binding.damageType()),
+                        binding.IsGroupBinding() ? GetIndex(lov.skillElementGroupIndices(), binding.group()) : GetIndex(lov.skillElementIndices(), binding.element()),
+                        (binding.IsGroupBinding() ? ContentPackElementBinding::FLAG_GROUP : 0) | (binding.isPenetrating() ? ContentPackElementBinding::FLAG_PENETRATING : 0)
+                    });
+                }
+
+                builder.skillDamages.push_back(ContentPackSkillDamage {
+                    damage.baseDamage().value(),
+                    GetIndex(lov.damageInclinationIndices(), damage.baseDamage().inclination()),
+                    static_cast<std::uint32_t>(damage.inclinationKey()),
+                    scalings,
+                    bindings
+                });
+            }
+
+            builder.skills.push_back(ContentPackSkill { skill.first, skill.second->textureIndex(), builder.AddString(skill.second->soundFilename()), damages });
+        }
+
+        std::unordered_map<const Equipment*, ContentPackIndex> equipmentIndices;
+        for (const EquipmentMap::value_type& eq : xlo.equipment()) {
+            ContentPackRange bonusStats { static_cast<ContentPackIndex>(builder.statValues.size()), static_cast<std::uint32_t>(eq.second->bonusStats().size()) };
+            for (const BattlerStatValues::value_type& stat : eq.second->bonusStats()) {
+                builder.statValues.push_back(ContentPackStatValue { GetIndex(lov.battlerStatIndices(), stat.first), stat.second });
+            }
+            std::sort(builder.statValues.begin() + bonusStats.first, builder.statValues.end(), [](const ContentPackStatValue& left, const ContentPackStatValue& right) { return left.stat < right.stat; });
+
+            ContentPackRange conversions { static_cast<ContentPackIndex>(builder.conversions.size()), static_cast<std::uint32_t>(eq.second->conversions().size()) };
+            for (const SkillElementGroupConversionMap::value_type& conversion : eq.second->conversions()) {
+                builder.conversions.push_back(ContentPackConversion { GetIndex(lov.skillElementGroupIndices(), conversion.first), GetIndex(lov.skillElementIndices(), conversion.second) });
+            }
+            std::sort(builder.conversions.begin() + conversions.first, builder.conversions.end(), [](const ContentPackConversion& left, const ContentPackConversion& right) { return left.group < right.group; });
+
+            // Equipment only grants the skills loaded before it, so which ones it grants is stored rather than worked out again.
+            std::vector<ContentPackIndex> skills;
+            for (const SkillMap::value_type& skill : eq.second->skills()) {
+                auto found = skillIndices.find(skill.second.get());
+                skills.push_back(found != skillIndices.end() ? found->second : CONTENTPACK_NO_INDEX);
+            }
+
+            equipmentIndices.insert(std::make_pair(eq.second.get(), static_cast<ContentPackIndex>(builder.equipment.size())));
+            builder.equipment.push_back(ContentPackEquipment { eq.first, GetIndex(lov.equipmentTypeIndices(), eq.second->equipmentType()), bonusStats, conversions, builder.AddIndices(skills) });
+        }
+
+        for (const BattlerMap::value_type& battler : xlo.battlers()) {
+            ContentPackRange stats { static_cast<ContentPackIndex>(builder.statValues.size()), 0 };
+            for (LOVIndex index = 0; index < battler.second->stats().size(); index++) {
+                BattlerStatValue value = battler.second->GetStat(index);
+                if (value != 0) {
+                    builder.statValues.push_back(ContentPackStatValue { index, value });
+                    stats.count++;
+                }
+            }
+
+            // Equipping the list in slot order puts every equipment back in the same slot.
+            std::vector<ContentPackIndex> startingEquipment;
+            for (const auto& slot : battler.second->currentEquipment()) {
+                if (slot.second) {
+                    auto found = equipmentIndices.find(slot.second.get());
+                    startingEquipment.push_back(found != equipmentIndices.end() ? found->second : CONTENTPACK_NO_INDEX);
+                }
+            }
+
+            builder.battlers.push_back(ContentPackBattler {
+                battler.first,
+                battler.second->isCharacter() ? 1u : 0u,
+                battler.second->priority(),
+                battler.second->textureIndex(),
+                battler.second->textureType(),
+                stats,
+                builder.AddIndices(startingEquipment)
+            });
+        }
+
+        std::vector<unsigned char> pack = builder.Build();
+
+        // Anything the storages refer to which is not in their own lists would have been written as CONTENTPACK_NO_INDEX; checking the pack catches it before it ships.
+        ContentPack check;
+        if (!check.Attach(pack.data(), pack.size()) || !check.Matches(lov)) {
+            std::cout << "WriteContentPack: The storages refer to entries which are not in their own lists.\n";
+            return false;
+        }
+
+        std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cout << "WriteContentPack: " << filename << " could not be opened for writing.\n";
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(pack.data()), static_cast<std::streamsize>(pack.size()));
+        if (!file) {
+            std::cout << "WriteContentPack: " << filename << " could not be written.\n";
+            return false;
+        }
+
+        std::cout << "WriteContentPack: Wrote " << pack.size() << " bytes to " << filename << ".\n";
+        return true;
+    }
+}
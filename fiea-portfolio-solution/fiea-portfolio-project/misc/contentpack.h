@@ -0,0 +1,353 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include "../abrv/abrv.h"
+#include "../store/symboltable.h"
+
+namespace AWE {
+    // Forward declarations, defined in the store.
+    class GameLOVStorage;
+    class GameXLOStorage;
+
+    /*
+     * The content pack is the shipping format of everything GameLOVStorage and GameXLOStorage load. The `.txt` and XML files in the `res` folder stay the authoring format;
+     * the content compiler loads and validates them exactly like the game does, then writes the pack.
+     *
+     * Layout: one ContentPackHeader, one ContentPackSection per section, then the sections themselves. Every section is a flat array of one fixed-layout record type,
+     * little-endian, aligned to 8 bytes. Records never hold pointers. They refer to each other by position instead:
+     * - Names and file names are ContentPackStrings, i.e. spans of the string pool.
+     * - Lists are ContentPackRanges, i.e. spans of another section.
+     * - LOV entries are referred to by their dense index, which is their position in their section. Each LOV section is sorted by key, so positions match the indices
+     *   LOVIndexTable assigns once the lists are loaded.
+     * - Skills, equipment and battlers are referred to by their position in their own section, and their names by SymbolID, which is one past the position in the symbol section.
+     * The header's checksum covers everything after the header. ContentPack::Attach checks all of this once, so the loaders can read every record in place without checking again.
+     */
+
+    /// <summary>
+    /// Position of a record in its section.
+    /// </summary>
+    typedef std::uint32_t ContentPackIndex;
+
+    /// <summary>
+    /// Refers to no record. Only valid where a record says so.
+    /// </summary>
+    static const ContentPackIndex CONTENTPACK_NO_INDEX = 0xFFFFFFFF;
+
+    /// <summary>
+    /// Identifies each section. Every section is required, and none may appear twice.
+    /// </summary>
+    enum class ContentPackSectionId : std::uint32_t {
+        STRINGS = "STRS"_abrv,
+        INDICES = "INDX"_abrv,
+        SYMBOLS = "SYMS"_abrv,
+        BATTLERSTATS = "BSTA"_abrv,
+        DAMAGEINCLINATIONS = "DINC"_abrv,
+        DAMAGETYPES = "DTYP"_abrv,
+        EQUIPMENTTYPES = "EQTY"_abrv,
+        SKILLELEMENTS = "SKEL"_abrv,
+        SKILLELEMENTGROUPS = "SKEG"_abrv,
+        DEFAULTEQUIPMENTSLOTS = "SLOT"_abrv,
+        INCLINATIONSTATS = "INCL"_abrv,
+        SKILLS = "SKIL"_abrv,
+        SKILLDAMAGES = "SDMG"_abrv,
+        STATSCALINGS = "SSCL"_abrv,
+        ELEMENTBINDINGS = "SBND"_abrv,
+        STATVALUES = "STVL"_abrv,
+        CONVERSIONS = "ECNV"_abrv,
+        EQUIPMENT = "EQIP"_abrv,
+        BATTLERS = "BATL"_abrv
+    };
+
+    struct ContentPackHeader {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t sectionCount;
+        /// <summary>
+        /// FNV-1a hash of every byte after the header.
+        /// </summary>
+        std::uint32_t checksum;
+        std::uint32_t reserved;
+        /// <summary>
+        /// Size of the whole pack in bytes.
+        /// </summary>
+        std::uint64_t size;
+    };
+
+    struct ContentPackSection {
+        ContentPackSectionId id;
+        /// <summary>
+        /// Number of records. For the string pool, number of bytes.
+        /// </summary>
+        std::uint32_t count;
+        /// <summary>
+        /// Offset of the first record from the start of the pack.
+        /// </summary>
+        std::uint64_t offset;
+    };
+
+    /// <summary>
+    /// A string in the string pool. Not null-terminated.
+    /// </summary>
+    struct ContentPackString {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    /// <summary>
+    /// A span of records in another section. Which section depends on the record holding the range.
+    /// </summary>
+    struct ContentPackRange {
+        ContentPackIndex first;
+        std::uint32_t count;
+    };
+
+    /// <summary>
+    /// Battler stats, damage inclinations, damage types, equipment types and skill elements.
+    /// </summary>
+    struct ContentPackLOVEntry {
+        std::uint32_t key;
+        ContentPackString name;
+    };
+
+    struct ContentPackElementGroup {
+        std::uint32_t key;
+        ContentPackString name;
+        /// <summary>
+        /// Nonzero if this is a group of groups.
+        /// </summary>
+        std::uint32_t isGroups;
+        /// <summary>
+        /// Range of the index section. Indices of the group's skill elements, or of its skill element groups if this is a group of groups.
+        /// </summary>
+        ContentPackRange members;
+    };
+
+    struct ContentPackSlotCount {
+        ContentPackIndex equipmentType;
+        std::uint32_t count;
+    };
+
+    struct ContentPackInclinationStats {
+        ContentPackIndex inclination;
+        /// <summary>
+        /// Range of the index section. Indices of battler stats.
+        /// </summary>
+        ContentPackRange attacking;
+        /// <summary>
+        /// Range of the index section. Indices of battler stats.
+        /// </summary>
+        ContentPackRange defending;
+    };
+
+    struct ContentPackSkill {
+        SymbolID symbol;
+        std::uint32_t textureIndex;
+        ContentPackString sound;
+        /// <summary>
+        /// Range of the skill damage section.
+        /// </summary>
+        ContentPackRange damages;
+    };
+
+    struct ContentPackSkillDamage {
+        std::int32_t baseValue;
+        /// <summary>
+        /// Index of the base damage's inclination, or CONTENTPACK_NO_INDEX if it has none.
+        /// </summary>
+        ContentPackIndex baseInclination;
+        /// <summary>
+        /// Key rather than index, since the damage's inclination may be DamageInclination::AUTO_KEY, which is never loaded.
+        /// </summary>
+        std::uint32_t inclinationKey;
+        /// <summary>
+        /// Range of the stat scaling section.
+        /// </summary>
+        ContentPackRange statScalings;
+        /// <summary>
+        /// Range of the element binding section.
+        /// </summary>
+        ContentPackRange elementBindings;
+    };
+
+    struct ContentPackStatScaling {
+        float value;
+        ContentPackIndex inclination;
+        ContentPackIndex stat;
+    };
+
+    struct ContentPackElementBinding {
+        float scaling;
+        ContentPackIndex inclination;
+        ContentPackIndex damageType;
+        /// <summary>
+        /// Index of a skill element group if the group flag is set, or of a skill element otherwise.
+        /// </summary>
+        ContentPackIndex target;
+        std::uint32_t flags;
+
+        static const std::uint32_t FLAG_GROUP = 1;
+        static const std::uint32_t FLAG_PENETRATING = 2;
+    };
+
+    struct ContentPackStatValue {
+        ContentPackIndex stat;
+        std::uint32_t value;
+    };
+
+    struct ContentPackConversion {
+        ContentPackIndex group;
+        ContentPackIndex element;
+    };
+
+    struct ContentPackEquipment {
+        SymbolID symbol;
+        ContentPackIndex equipmentType;
+        /// <summary>
+        /// Range of the stat value section.
+        /// </summary>
+        ContentPackRange bonusStats;
+        /// <summary>
+        /// Range of the conversion section.
+        /// </summary>
+        ContentPackRange conversions;
+        /// <summary>
+        /// Range of the index section. Indices of the skills the equipment grants.
+        /// </summary>
+        ContentPackRange skills;
+    };
+
+    struct ContentPackBattler {
+        SymbolID symbol;
+        std::uint32_t isCharacter;
+        std::uint32_t priority;
+        std::uint32_t textureIndex;
+        std::uint32_t textureType;
+        /// <summary>
+        /// Range of the stat value section.
+        /// </summary>
+        ContentPackRange stats;
+        /// <summary>
+        /// Range of the index section. Indices of the battler's starting equipment, in slot order.
+        /// </summary>
+        ContentPackRange startingEquipment;
+    };
+
+    /// <summary>
+    /// Read-only view of a content pack held in memory, usually a MappedFile. Attaching checks the whole pack once; after that every record can be read in place,
+    /// and every string, range and index in it is known to be in bounds. Nothing is copied, so the memory must outlive the view.
+    /// </summary>
+    class ContentPack {
+    public:
+        /// <summary>
+        /// Identifies a content pack. Also catches packs written with the other byte order.
+        /// </summary>
+        static const std::uint32_t MAGIC;
+        /// <summary>
+        /// Incremented whenever the layout of any record changes. Packs of any other version are refused, and have to be compiled again.
+        /// </summary>
+        static const std::uint16_t VERSION;
+        /// <summary>
+        /// Default name of the pack, next to the files it was compiled from.
+        /// </summary>
+        static const char* DEFAULT_FILENAME;
+        /// <summary>
+        /// Every section starts at a multiple of this.
+        /// </summary>
+        static const std::size_t ALIGNMENT = 8;
+
+        /// <returns>Hash of the given bytes, as stored in the header's checksum.</returns>
+        static std::uint32_t Checksum(const unsigned char* data, std::size_t size);
+
+    private:
+        static const std::size_t SECTION_COUNT = 19;
+
+        const unsigned char* _data;
+        std::size_t _size;
+        std::array<const unsigned char*, SECTION_COUNT> _sections;
+        std::array<std::uint32_t, SECTION_COUNT> _counts;
+
+        /// <returns>const span over the records of the section at the given position.</returns>
+        template <typename T>
+        std::span<const T> Section(std::size_t) const;
+
+        /// <returns>Does every string, range and index of the attached sections stay in bounds?</returns>
+        bool ValidateRecords() const;
+
+    public:
+        /// <summary>
+        /// Default constructor. Nothing is attached.
+        /// </summary>
+        ContentPack();
+
+        /// <returns>Is a pack attached?</returns>
+        bool isAttached() const;
+
+        /// <summary>
+        /// Checks the given memory is a whole, valid content pack of this version and, if so, attaches to it. Whatever was attached before is detached either way.
+        /// </summary>
+        /// <returns>Whether the pack was attached.</returns>
+        bool Attach(const unsigned char* data, std::size_t size);
+        /// <summary>
+        /// Detaches from the pack. Every span handed out by this view becomes invalid once the memory goes away.
+        /// </summary>
+        void Detach();
+        /// <returns>Are the LOV sections of the attached pack made of the same keys, in the same order, as the lists of the given storage?
+        /// Skills, equipment and battlers refer to LOV entries by index, so they can only be loaded against lists they match.</returns>
+        bool Matches(const GameLOVStorage&) const;
+
+        /// <returns>The string pool.</returns>
+        std::span<const char> strings() const;
+        /// <returns>The index section, which lists of indices are ranges of.</returns>
+        std::span<const ContentPackIndex> indices() const;
+        /// <returns>Every interned name, in SymbolID order.</returns>
+        std::span<const ContentPackString> symbols() const;
+        /// <returns>Battler stats, in key order.</returns>
+        std::span<const ContentPackLOVEntry> battlerStats() const;
+        /// <returns>Damage inclinations, in key order.</returns>
+        std::span<const ContentPackLOVEntry> damageInclinations() const;
+        /// <returns>Damage types, in key order.</returns>
+        std::span<const ContentPackLOVEntry> damageTypes() const;
+        /// <returns>Equipment types, in key order.</returns>
+        std::span<const ContentPackLOVEntry> equipmentTypes() const;
+        /// <returns>Skill elements, in key order.</returns>
+        std::span<const ContentPackLOVEntry> skillElements() const;
+        /// <returns>Skill element groups, in key order.</returns>
+        std::span<const ContentPackElementGroup> skillElementGroups() const;
+        /// <returns>The default equipment slot schema.</returns>
+        std::span<const ContentPackSlotCount> defaultEquipmentSlots() const;
+        /// <returns>The attacking and defending stats of each damage inclination.</returns>
+        std::span<const ContentPackInclinationStats> inclinationStats() const;
+        /// <returns>Skills, in the order they were loaded.</returns>
+        std::span<const ContentPackSkill> skills() const;
+        /// <returns>Damages of every skill. Each skill's damages are a range of these.</returns>
+        std::span<const ContentPackSkillDamage> skillDamages() const;
+        /// <returns>Stat scalings of every skill damage.</returns>
+        std::span<const ContentPackStatScaling> statScalings() const;
+        /// <returns>Element bindings of every skill damage.</returns>
+        std::span<const ContentPackElementBinding> elementBindings() const;
+        /// <returns>Bonus stats of every equipment and stats of every battler.</returns>
+        std::span<const ContentPackStatValue> statValues() const;
+        /// <returns>Element conversions of every equipment.</returns>
+        std::span<const ContentPackConversion> conversions() const;
+        /// <returns>Equipment, in the order they were loaded.</returns>
+        std::span<const ContentPackEquipment> equipment() const;
+        /// <returns>Battlers, in the order they were loaded.</returns>
+        std::span<const ContentPackBattler> battlers() const;
+
+        /// <returns>View of the given string in the pool. Copy it if it has to outlive the pack.</returns>
+        std::string_view GetString(ContentPackString) const;
+        /// <returns>The given range of the given section.</returns>
+        template <typename T>
+        static std::span<const T> GetRange(std::span<const T> section, ContentPackRange range) { return section.subspan(range.first, range.count); }
+    };
+
+    /// <summary>
+    /// Writes everything the given storages loaded into a content pack. Both storages must be initialized.
+    /// </summary>
+    /// <returns>Whether the whole pack was written.</returns>
+    bool WriteContentPack(const GameLOVStorage&, const GameXLOStorage&, const std::string& filename);
+}
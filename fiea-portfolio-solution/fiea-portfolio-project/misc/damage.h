@@ -1,9 +1,15 @@
 #pragma once
-#include <map>
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <span>
 #include <string>
-#include <unordered_map>
 #include <vector>
+#include "damagebatch.h"
+#include "damagefixed.h"
+#include "damagekernel.h"
+#include "damagetrace.h"
+#include "textformatter.h"
 #include "../models/battler.h"
 #include "../models/lovpairs.h"
 #include "../models/skill.h"
@@ -16,16 +22,41 @@ namespace AWE {
     /// </summary>
     typedef long DamageValueFinalTotal;
     /// <summary>
-    /// Map of type-inclination pairs to intermediate damage values. Examples: 3.75 physical slashing damage, 4.00 magical aetheric damage, etc.
+    /// Array which keeps up to N elements inline and only allocates once it is asked to hold more than that. Lets damage results for ordinary content stay off the heap entirely.
     /// </summary>
-    typedef std::map<DamageTypeInclination, float, DamageTypeInclination_comp> DamageValueMap;
-    /// <summary>
-    /// Map used to report intermediate damage values keyed by either inclination or damage type.
-    /// For example, say you had the following DamageValueMap: { 3.0 physical crushing damage, 7.0 physical pyretic damage, 5.0 magical crushing damage, 9.0 magical pyretic damage }.
-    /// Then if you wanted to break that down by inclination, you'd get a map of this type looking like { 10.0 physical damage, 14.0 magical damage }.
-    /// Or if you wanted a break-down by damage type, you'd get { 8.0 crushing damage, 16.0 pyretic damage }.
-    /// </summary>
-    typedef std::unordered_map<ABRV_long, float> DamageValueSubmap;
+    template <typename T, std::size_t N>
+    class DamageInlineBuffer {
+    private:
+        std::array<T, N> _inline;
+        std::vector<T> _spilled;
+        std::size_t _size;
+
+    public:
+        DamageInlineBuffer() : _inline(), _size(0) {}
+
+        /// <returns>Number of elements.</returns>
+        std::size_t size() const { return _size; }
+        /// <returns>Pointer to the first element.</returns>
+        T* data() { return (_size <= N) ? _inline.data() : _spilled.data(); }
+        /// <returns>const pointer to the first element.</returns>
+        const T* data() const { return (_size <= N) ? _inline.data() : _spilled.data(); }
+
+        T& operator[](std::size_t index) { return data()[index]; }
+        const T& operator[](std::size_t index) const { return data()[index]; }
+
+        /// <summary>
+        /// Resizes the buffer to the given count, setting every element to the given value.
+        /// </summary>
+        void Assign(std::size_t count, const T& value) {
+            _size = count;
+            if (count <= N) {
+                _spilled.clear();
+                std::fill_n(_inline.begin(), count, value);
+            } else {
+                _spilled.assign(count, value);
+            }
+        }
+    };
 
     /// <summary>
     /// Represents base damage. Mostly needed to pair an inclination with an intermediate damage value.
@@ -36,6 +67,7 @@ namespace AWE {
         float _value;
 
     public:
+        DamageBaseDamageValue();
         DamageBaseDamageValue(DamageInclination_shptr, float);
 
         /// <returns>Value of the base damage.</returns>
@@ -45,93 +77,315 @@ namespace AWE {
     };
 
     /// <summary>
-    /// Wraps a base damage, a DamageValueMap, and an intermediate total. Skills can have multiple instances of damage - this object represents one such instance.
+    /// Intermediate damage values of one damage component keyed by either inclination or damage type, summed on demand out of the component's grid.
+    /// For example, say a component dealt { 3.0 physical crushing damage, 7.0 physical pyretic damage, 5.0 magical crushing damage, 9.0 magical pyretic damage }.
+    /// Then if you wanted to break that down by inclination, you'd get a view looking like { 10.0 physical damage, 14.0 magical damage }.
+    /// Or if you wanted a break-down by damage type, you'd get { 8.0 crushing damage, 16.0 pyretic damage }.
+    /// Views point into the Damage they came from, so they are only valid as long as it is.
+    /// </summary>
+    class DamageSubtotalView {
+    private:
+        const float* _cells;
+        const std::vector<ABRV_long>* _keys;
+        std::size_t _keyStride;
+        std::size_t _termCount;
+        std::size_t _termStride;
+
+    public:
+        /// <param name="cells">Grid cell of the first term of the first key.</param>
+        /// <param name="keys">Keys of the view, in grid order.</param>
+        /// <param name="keyStride">Distance between the first terms of consecutive keys.</param>
+        /// <param name="termCount">Number of cells summed into each key's value.</param>
+        /// <param name="termStride">Distance between consecutive terms of one key.</param>
+        DamageSubtotalView(const float* cells, const std::vector<ABRV_long>& keys, std::size_t keyStride, std::size_t termCount, std::size_t termStride);
+
+        /// <returns>Number of keys in the view. Keys whose value is 0 are included.</returns>
+        std::size_t size() const;
+        /// <returns>Key at the given index.</returns>
+        ABRV_long key(std::size_t index) const;
+        /// <returns>Value of the key at the given index.</returns>
+        float value(std::size_t index) const;
+        /// <returns>Value of the given key, or 0 if it is not in the view.</returns>
+        float GetValue(ABRV_long key) const;
+    };
+
+    /// <summary>
+    /// Read-only view of one damage component of a Damage: a base damage, a dense grid of subtotals, and an intermediate total. Skills can have multiple instances of damage - this object represents one such instance.
+    /// Views point into the Damage they came from, so they are only valid as long as it is.
     /// </summary>
     class DamageValues {
     private:
+        const DamageBatchLayout* _layout;
+        const DamageBaseDamageValue* _base;
         float _total;
-        DamageBaseDamageValue _base;
-        DamageValueMap _subtotals;
+        const float* _cells;
 
     public:
-        DamageValues(DamageBaseDamageValue&, DamageValueMap&);
+        DamageValues(const DamageBatchLayout&, const DamageBaseDamageValue&, float total, const float* cells);
 
         /// <returns>Sum of all subtotals.</returns>
         float total() const;
         /// <returns>const reference to the base damage.</returns>
         const DamageBaseDamageValue& base() const;
-        /// <returns>const reference to the subtotals.</returns>
-        const DamageValueMap& subtotals() const;
+        /// <returns>const reference to the layout the grid is indexed by.</returns>
+        const DamageBatchLayout& layout() const;
+        /// <returns>The subtotal grid. The subtotal of type index t and inclination index i is at [t * (inclination count + 1) + i]. The extra row and column hold anything keyed outside the layout.</returns>
+        std::span<const float> cells() const;
 
         /// <returns>Returns the value of a specific total indicated by damage type and inclination.</returns>
         float GetSubtotal(DamageTypeInclination) const;
-        /// <returns>Creates a map of subtotals keyed by inclinations.</returns>
-        DamageValueSubmap CreateInclinationSubtotals() const;
-        /// <returns>Creates a map of subtotals of a specific damage type keyed by inclinations.</returns>
-        DamageValueSubmap CreateInclinationSubtotals(DamageTypeKey) const;
-        /// <returns>Creates a map of subtotals keyed by damage types.</returns>
-        DamageValueSubmap CreateTypeSubtotals() const;
-        /// <returns>Creates a map of subtotals of a specific inclination keyed by damage types.</returns>
-        DamageValueSubmap CreateTypeSubtotals(DamageInclinationKey) const;
+        /// <returns>View of subtotals keyed by inclinations.</returns>
+        DamageSubtotalView CreateInclinationSubtotals() const;
+        /// <returns>View of subtotals of a specific damage type keyed by inclinations.</returns>
+        DamageSubtotalView CreateInclinationSubtotals(DamageTypeKey) const;
+        /// <returns>View of subtotals keyed by damage types.</returns>
+        DamageSubtotalView CreateTypeSubtotals() const;
+        /// <returns>View of subtotals of a specific inclination keyed by damage types.</returns>
+        DamageSubtotalView CreateTypeSubtotals(DamageInclinationKey) const;
     };
 
-    typedef std::vector<DamageValues> DamageValuesList;
-
     /// <summary>
     /// Represents the "grand total" of all damage calculation. Skills can have multiple instances of damage - this object aggregates all of them.
+    /// Every component's subtotals are kept in a dense [type x inclination] grid sized from the layout, inline for up to INLINE_COMPONENTS components and INLINE_CELLS cells, so results
+    /// for ordinary content never allocate.
     /// </summary>
     class Damage {
+    public:
+        /// <summary>Number of components kept inline.</summary>
+        static const std::size_t INLINE_COMPONENTS = 4;
+        /// <summary>Number of grid cells, across all components, kept inline.</summary>
+        static const std::size_t INLINE_CELLS = 128;
+
     private:
         DamageValueFinalTotal _final;
-        DamageValuesList _values;
+        const DamageBatchLayout* _layout;
+        std::size_t _cellCount;
+        DamageInlineBuffer<DamageBaseDamageValue, INLINE_COMPONENTS> _bases;
+        DamageInlineBuffer<float, INLINE_COMPONENTS> _totals;
+        DamageInlineBuffer<float, INLINE_CELLS> _cells;
 
     public:
-        Damage(DamageValuesList&);
+        /// <summary>
+        /// Creates damage with the given number of components, every one of them 0. Fill in each component with base and GetCells, then call SumTotals.
+        /// </summary>
+        Damage(const DamageBatchLayout&, std::size_t componentCount);
 
         /// <returns>The total amount of damage.</returns>
         DamageValueFinalTotal final() const;
-        /// <returns>const reference to the values.</returns>
-        const DamageValuesList& values() const;
+        /// <returns>const reference to the layout every component's grid is indexed by.</returns>
+        const DamageBatchLayout& layout() const;
+        /// <returns>Number of damage components.</returns>
+        std::size_t componentCount() const;
+        /// <returns>Number of grid cells of each component.</returns>
+        std::size_t cellCount() const;
+        /// <returns>View of the given component.</returns>
+        DamageValues GetValues(std::size_t component) const;
+
+        /// <returns>Mutable grid of the given component, laid out as described by DamageValues::cells.</returns>
+        float* GetCells(std::size_t component);
+        /// <param name="component">Component to set the base damage of.</param>
+        /// <param name="">New base damage.</param>
+        /// <returns>Old base damage.</returns>
+        DamageBaseDamageValue base(std::size_t component, const DamageBaseDamageValue&);
+        /// <summary>
+        /// Sums every component's total, then rounds their sum up into the final total.
+        /// </summary>
+        void SumTotals();
+        /// <summary>
+        /// Sums every component's total, but takes the final total as given. Used when the values are only a display copy of a more exact calculation.
+        /// </summary>
+        void SumTotals(DamageValueFinalTotal final);
 
+        /// <summary>
+        /// Writes the same text as ToString into the given formatter, without allocating.
+        /// </summary>
+        /// <param name="damageTypes">Map which can convert damage type keys to qualified damage type objects. Used to get the ABRVs of damage types.</param>
+        void Format(TextFormatter&, const DamageTypeMap& damageTypes) const;
+        /// <returns>Number of characters Format may write at most for damage with this layout.</returns>
+        std::size_t MaxFormattedSize() const;
         /// <param name="damageTypes">Map which can convert damage type keys to qualified damage type objects. Used to get string forms of damage types.</param>
         /// <returns>A string representation of this object.</returns>
         std::string ToString(const DamageTypeMap& damageTypes) const;
     };
 
     /// <summary>
-    /// The damage calculator.
+    /// Arithmetic used by a damage calculator.
+    /// </summary>
+    enum class DamageCalculatorMode : unsigned short {
+        /// <summary>Single-precision floating point. Fastest, but results may differ between compilers and platforms.</summary>
+        FLOAT,
+        /// <summary>Q16.16 fixed point. Results are bit-exact on every compiler and platform, so recorded battles replay identically.</summary>
+        FIXED
+    };
+
+    /// <summary>
+    /// Summary of how far the fixed-point mode strays from the float mode over a set of calculations.
+    /// </summary>
+    struct DamageModeToleranceReport {
+        /// <summary>Number of calculations compared.</summary>
+        std::size_t count;
+        /// <summary>Number of calculations whose final totals differ.</summary>
+        std::size_t finalMismatches;
+        /// <summary>Largest absolute difference between final totals.</summary>
+        DamageValueFinalTotal maxFinalDifference;
+        /// <summary>Largest absolute difference between any two matching subtotals or base damages.</summary>
+        float maxSubtotalDifference;
+        /// <summary>Largest difference between any two matching subtotals or base damages, relative to the float value. Values under 1 are compared as if they were 1.</summary>
+        float maxRelativeDifference;
+
+        /// <returns>A string representation of this object.</returns>
+        std::string ToString() const;
+    };
+
+    /// <summary>
+    /// Tuning constants of the damage formula, as shipped. A balance variant is another struct with the same members, which BasicDamageCalculator can then be specialized on.
+    /// Every member must be constexpr so the calculator can fold them into its arithmetic.
     /// </summary>
-    class DamageCalculator {
+    struct DamagePolicy_Standard {
+        /// <summary>This number * 2.5 should be roughly what a "late-game" affinity value should look like.</summary>
+        static constexpr unsigned int ELEM_THRESHOLD_CONSTANT = 20U;
+        /// <summary>Helps determine minumum multiplier for nonpenetrating damage. The higher this number is, each point of affinity will be less effective at raising the minimum.</summary>
+        static constexpr float ELEMTHRESH_MULTIP_CONSTANT = 10U;
+        /// <summary>Maximum multiplier for bonuses from nonpenetrating damage.</summary>
+        static constexpr float NONPEN_BONUS_MAX = 2.0f;
+        /// <summary>Needs to be between or equal to 0.0f and/or 1.0f. The amount of reduction penetrating damage ignores.</summary>
+        static constexpr float PENETRATION_EFFECTIVENESS = 1.0f;
+        /// <summary>Should be roughly double the highest expected value for a battler stat.</summary>
+        static constexpr float REDUCTION_CONSTANT = 2000.0f;
+        /// <summary>Attacking stats must be (1 + this number) times greater than their defensive counterparts to achieve parity.</summary>
+        static constexpr float RESIDUAL_CONSTANT = 0.1f;
+    };
+
+    /// <summary>
+    /// The damage calculator, specialized on a policy of tuning constants. Calculators with different policies are unrelated types, so several can run side by side with no runtime branching.
+    /// Member definitions live in damage.inl, included at the end of this header, so any translation unit can instantiate its own policy. The standard policy is instantiated once in damage.cpp.
+    /// </summary>
+    template <typename Policy>
+    class BasicDamageCalculator {
     private:
         const GameLOVStorage* _lov;
         const GameXLOStorage* _xlo;
+        DamageBatchLayout _batchLayout;
+        DamageKernelLevel _kernelLevel;
+        DamageKernelConstants _kernelConstants;
+        DamageCalculatorMode _mode;
+        DamageFixedConstants _fixedConstants;
+        DamageFixed _fixedReduction;
+        DamageFixed _fixedNonpenBonusMax;
+        DamageFixed _fixedPenetrationEffectiveness;
 
         template <typename T> T range(T value, T min, T max) const;
         template <typename T> T mingate(T value, T min) const;
         template <typename T> T maxgate(T value, T max) const;
 
+        /// <param name="trace">Receives the intermediate terms if TraceSink is enabled. Otherwise never touched, and may be null.</param>
+        /// <returns>Damage reduction of one inclination, from 0.f to 1.f, given the attacking and defending stat totals for that inclination and the defender's total resistances.</returns>
+        template <typename TraceSink = DamageTraceNull>
+        float CalculateDamageReduction(unsigned long attackingStatTotal, unsigned long defendingStatTotal, long defendingResistTotal, DamageTraceInclination* trace = nullptr) const;
+        /// <returns>The damage reduction penetrating bindings use in place of the given one.</returns>
+        float CalculatePenetratedDamageReduction(float damageReduction) const;
+        /// <returns>Bonus multiplier for nonpenetrating bindings of one inclination.</returns>
+        float CalculateBonusScaling(float elementalStatDamage, unsigned long defendingStatTotal) const;
+        /// <param name="trace">Receives the intermediate terms and the damage if TraceSink is enabled. Otherwise never touched, and may be null.</param>
+        /// <returns>Damage dealt by a single element binding.</returns>
+        template <typename TraceSink = DamageTraceNull>
+        float CalculateBindingDamage(bool isPenetrating, float scaling, ElementalAffinityValue affinity, DamageResistanceValue resistance, float damageReduction, float elementalStatDamage, unsigned long defendingStatTotal,
+            float damageSourcePercentage, DamageTraceBinding* trace = nullptr) const;
+
+        /// <returns>Fixed-point counterpart of CalculateDamageReduction.</returns>
+        DamageFixed CalculateDamageReductionFixed(unsigned long attackingStatTotal, unsigned long defendingStatTotal, long defendingResistTotal) const;
+        /// <returns>Fixed-point counterpart of CalculatePenetratedDamageReduction.</returns>
+        DamageFixed CalculatePenetratedDamageReductionFixed(DamageFixed damageReduction) const;
+        /// <returns>Fixed-point counterpart of CalculateBonusScaling.</returns>
+        DamageFixed CalculateBonusScalingFixed(DamageFixed elementalStatDamage, unsigned long defendingStatTotal) const;
+
+        /// <summary>
+        /// Sums the attacking and defending stats of one plan inclination, using the battler instances' own totals when they have them.
+        /// </summary>
+        void CalculateStatTotals(const DamagePlan&, const DamagePlanInclination&, const BattlerInstance& attacker, const BattlerInstance& defender, unsigned long& attackingStatTotal, unsigned long& defendingStatTotal) const;
+        /// <returns>Damage calculated in float mode, with every inclination and binding recorded into the trace sink.</returns>
+        template <typename TraceSink>
+        Damage CalculateDamageFloat(const Skill& skill, const BattlerInstance& attacker, const BattlerInstance& defender, TraceSink& trace) const;
+        /// <returns>Damage calculated in fixed-point mode. The final total is taken from the fixed-point sum; the float values are only for display.</returns>
+        Damage CalculateDamageFixed(const Skill& skill, const BattlerInstance& attacker, const BattlerInstance& defender) const;
+
     public:
-        DamageCalculator(const GameLOVStorage&, const GameXLOStorage&);
+        BasicDamageCalculator(const GameLOVStorage&, const GameXLOStorage&);
 
-        /// <summary>This number * 2.5 should be roughly what a "late-game" affinity value should look like.</summary>
-        static const unsigned int ELEM_THRESHOLD_CONSTANT;
-        /// <summary>Helps determine minumum multiplier for nonpenetrating damage. The higher this number is, each point of affinity will be less effective at raising the minimum.</summary>
-        static const float ELEMTHRESH_MULTIP_CONSTANT;
-        /// <summary>Maximum multiplier for bonuses from nonpenetrating damage.</summary>
-        static const float NONPEN_BONUS_MAX;
-        /// <summary>Needs to be between or equal to 0.0f and/or 1.0f. The amount of reduction penetrating damage ignores.</summary>
-        static const float PENETRATION_EFFECTIVENESS;
-        /// <summary>Should be roughly double the highest expected value for a battler stat.</summary>
-        static const float REDUCTION_CONSTANT;
-        /// <summary>Attacking stats must be (1 + this number) times greater than their defensive counterparts to achieve parity.</summary>
-        static const float RESIDUAL_CONSTANT;
+        /// <summary>The policy this calculator was specialized on.</summary>
+        typedef Policy policy_type;
+
+        /// <summary>See DamagePolicy_Standard::ELEM_THRESHOLD_CONSTANT.</summary>
+        static constexpr unsigned int ELEM_THRESHOLD_CONSTANT = Policy::ELEM_THRESHOLD_CONSTANT;
+        /// <summary>See DamagePolicy_Standard::ELEMTHRESH_MULTIP_CONSTANT.</summary>
+        static constexpr float ELEMTHRESH_MULTIP_CONSTANT = Policy::ELEMTHRESH_MULTIP_CONSTANT;
+        /// <summary>See DamagePolicy_Standard::NONPEN_BONUS_MAX.</summary>
+        static constexpr float NONPEN_BONUS_MAX = Policy::NONPEN_BONUS_MAX;
+        /// <summary>See DamagePolicy_Standard::PENETRATION_EFFECTIVENESS.</summary>
+        static constexpr float PENETRATION_EFFECTIVENESS = Policy::PENETRATION_EFFECTIVENESS;
+        /// <summary>See DamagePolicy_Standard::REDUCTION_CONSTANT.</summary>
+        static constexpr float REDUCTION_CONSTANT = Policy::REDUCTION_CONSTANT;
+        /// <summary>See DamagePolicy_Standard::RESIDUAL_CONSTANT.</summary>
+        static constexpr float RESIDUAL_CONSTANT = Policy::RESIDUAL_CONSTANT;
 
         /// <returns>const pointer to the LOV storage this damage calculator uses.</returns>
         const GameLOVStorage* lov() const;
         /// <returns>const pointer to the XLO storage this damage calculator uses.</returns>
         const GameXLOStorage* xlo() const;
+        /// <returns>Instruction set used for element bindings by untraced float calculations, single or batched. Defaults to the best one the CPU supports. Traced calculations always evaluate bindings one at a time.</returns>
+        DamageKernelLevel kernelLevel() const;
+        /// <param name="">New instruction set for untraced float calculations. Levels the CPU does not support fall back to the next lower one.</param>
+        /// <returns>Old instruction set for untraced float calculations.</returns>
+        DamageKernelLevel kernelLevel(DamageKernelLevel);
+        /// <returns>const reference to the dense layout used by batch calculations. Per-type subtotals are ordered by its damage types.</returns>
+        const DamageBatchLayout& batchLayout() const;
+        /// <returns>Arithmetic used by every calculation. Defaults to FLOAT.</returns>
+        DamageCalculatorMode mode() const;
+        /// <param name="">New arithmetic for every calculation.</param>
+        /// <returns>Old arithmetic.</returns>
+        DamageCalculatorMode mode(DamageCalculatorMode);
 
         /// <returns>Resultant damage from attacker using skill on defender.</returns>
-        Damage CalculateDamage(const Skill_shptr& skill, const BattlerInstance_shptr& attacker, const BattlerInstance_shptr& defender) const;
+        Damage CalculateDamage(const Skill& skill, const BattlerInstance& attacker, const BattlerInstance& defender) const;
+        /// <summary>
+        /// Same as CalculateDamage, but records every intermediate term into the given trace sink: one calculation, then one record per inclination and per element binding.
+        /// Only float mode is traced. In fixed-point mode the sink still sees the calculation and its final total, but no inclinations or bindings.
+        /// Any sink can be used. DamageTraceNull and DamageTraceBuffer are already instantiated for the standard policy in damage.cpp.
+        /// </summary>
+        /// <returns>Resultant damage from attacker using skill on defender, identical to the untraced result.</returns>
+        template <typename TraceSink>
+        Damage CalculateDamage(const Skill& skill, const BattlerInstance& attacker, const BattlerInstance& defender, TraceSink& trace) const;
+        /// <summary>
+        /// Prices every query at once. Each result is identical to the final value of CalculateDamage for the same skill, attacker, and defender.
+        /// </summary>
+        /// <param name="queries">The skill, attacker, and defender of each calculation.</param>
+        /// <param name="out">Receives the final damage total of each query. Must be at least as long as queries.</param>
+        /// <param name="typeSubtotals">Optional. If not empty, receives every query's damage subtotaled by type: the subtotal of type t for query q is written to
+        /// [q * batchLayout().types().size() + t]. Must then be at least that long.</param>
+        /// <returns>False if an output is too short or any query has an empty pointer, in which case the outputs are left unspecified.</returns>
+        bool CalculateDamageBatch(std::span<const DamageQuery> queries, std::span<DamageValueFinalTotal> out, std::span<float> typeSubtotals = {}) const;
+        /// <summary>
+        /// Prices every query at once using the given scratch buffers. Reusing buffers across batches avoids reallocating them.
+        /// </summary>
+        bool CalculateDamageBatch(std::span<const DamageQuery> queries, std::span<DamageValueFinalTotal> out, DamageBatchBuffers& buffers, std::span<float> typeSubtotals = {}) const;
+        /// <summary>
+        /// Calculates every query in both modes and compares the results. The calculator's own mode is not used or changed.
+        /// </summary>
+        /// <returns>The comparison. Queries with an empty pointer are skipped.</returns>
+        DamageModeToleranceReport CreateModeToleranceReport(std::span<const DamageQuery> queries) const;
     };
+
+    /// <summary>
+    /// The damage calculator the game uses.
+    /// </summary>
+    typedef BasicDamageCalculator<DamagePolicy_Standard> DamageCalculator;
+}
+
+#include "damage.inl"
+
+namespace AWE {
+    // Instantiated in damage.cpp.
+    extern template class BasicDamageCalculator<DamagePolicy_Standard>;
+    extern template Damage BasicDamageCalculator<DamagePolicy_Standard>::CalculateDamage<DamageTraceNull>(const Skill&, const BattlerInstance&, const BattlerInstance&, DamageTraceNull&) const;
+    extern template Damage BasicDamageCalculator<DamagePolicy_Standard>::CalculateDamage<DamageTraceBuffer>(const Skill&, const BattlerInstance&, const BattlerInstance&, DamageTraceBuffer&) const;
 }
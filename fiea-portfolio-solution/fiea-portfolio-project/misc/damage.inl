@@ -0,0 +1,688 @@
+#pragma once
+#include <algorithm>
+#include <math.h>
+#include "../models/damagesource.h"
+
+// Member definitions of BasicDamageCalculator, included at the end of damage.h.
+
+namespace AWE {
+
+    /* BasicDamageCalculator */
+
+    template <typename Policy>
+    BasicDamageCalculator<Policy>::BasicDamageCalculator(const GameLOVStorage& lov, const GameXLOStorage& xlo)
+            : _lov(&lov)
+            , _xlo(&xlo)
+            , _batchLayout(lov)
+            , _kernelLevel(DetectDamageKernelLevel())
+            , _mode(DamageCalculatorMode::FLOAT) {
+        _kernelConstants.residual = RESIDUAL_CONSTANT;
+        _kernelConstants.elementalThreshold = static_cast<float>(ELEM_THRESHOLD_CONSTANT);
+        _kernelConstants.mingateThreshold = ELEMTHRESH_MULTIP_CONSTANT * ELEM_THRESHOLD_CONSTANT;
+
+        // Converted once here, so the fixed-point path itself never touches a float.
+        _fixedConstants.residual = DamageFixedFromFloat(RESIDUAL_CONSTANT);
+        _fixedConstants.elementalThreshold = DamageFixedFromInt(ELEM_THRESHOLD_CONSTANT);
+        _fixedConstants.mingateThreshold = DamageFixedFromFloat(ELEMTHRESH_MULTIP_CONSTANT * ELEM_THRESHOLD_CONSTANT);
+        _fixedReduction = DamageFixedFromFloat(REDUCTION_CONSTANT);
+        _fixedNonpenBonusMax = DamageFixedFromFloat(NONPEN_BONUS_MAX);
+        _fixedPenetrationEffectiveness = DamageFixedFromFloat(PENETRATION_EFFECTIVENESS);
+    }
+
+    template <typename Policy> const GameLOVStorage* BasicDamageCalculator<Policy>::lov() const { return _lov; }
+    template <typename Policy> const GameXLOStorage* BasicDamageCalculator<Policy>::xlo() const { return _xlo; }
+    template <typename Policy> DamageKernelLevel BasicDamageCalculator<Policy>::kernelLevel() const { return _kernelLevel; }
+    template <typename Policy> const DamageBatchLayout& BasicDamageCalculator<Policy>::batchLayout() const { return _batchLayout; }
+    template <typename Policy> DamageCalculatorMode BasicDamageCalculator<Policy>::mode() const { return _mode; }
+
+    template <typename Policy> DamageKernelLevel BasicDamageCalculator<Policy>::kernelLevel(DamageKernelLevel newval) { DamageKernelLevel oldval = _kernelLevel; _kernelLevel = newval; return oldval; }
+    template <typename Policy> DamageCalculatorMode BasicDamageCalculator<Policy>::mode(DamageCalculatorMode newval) { DamageCalculatorMode oldval = _mode; _mode = newval; return oldval; }
+
+    template <typename Policy> template <typename T> T BasicDamageCalculator<Policy>::range(T value, T min, T max) const { return (value > max) ? max : ((value < min) ? min : value); }
+    template <typename Policy> template <typename T> T BasicDamageCalculator<Policy>::mingate(T value, T min) const { return (value < min) ? min : value; }
+    template <typename Policy> template <typename T> T BasicDamageCalculator<Policy>::maxgate(T value, T max) const { return (value > max) ? max : value; }
+
+    template <typename Policy> template <typename TraceSink>
+    float BasicDamageCalculator<Policy>::CalculateDamageReduction(unsigned long attackingStatTotal, unsigned long defendingStatTotal, long defendingResistTotal, DamageTraceInclination* trace) const {
+        // The "main" component of damage reduction. This is almost equivalent to/can basically be thought of as a ratio of attacking stats to defending stats.
+        // It's not an exact ratio because of the RESIDUAL_CONSTANT expression - essentially, the attacking stats have to be (1 + resid const) times greater than defending to achieve parity.
+        // This ratio may end up being greater than 1, but it's capped at 1 at a later stage in calculation.
+        float damageReduction_stats = ((attackingStatTotal - (RESIDUAL_CONSTANT * defendingStatTotal)) / (defendingStatTotal > 0UL ? static_cast<float>(defendingStatTotal) : 1.0f));
+
+        // The "secondary" component of damage reduction. This is a ratio of the REDUCTION_CONSTANT (note this is different from RESIDUAL_CONSTANT, their names look similar) to the sum of
+        // the REDUCTION_CONSTANT and defending stats and defending resistances. This expression should be close to 1 for small values of stats and resistances because the reduction constant
+        // is a rather large number. This is meant to come into effect later in the game as stats become larger - the idea being, defensive investment always means *something*, even if
+        // the aggresor has considerably greater attacking stats. Note also that attacking stats cannot affect this component of damage reduction, so this can be quite dangerous for
+        // balancing if some counter measures are not put into place...
+        float damageReduction_resists = REDUCTION_CONSTANT / (REDUCTION_CONSTANT + defendingResistTotal + defendingStatTotal);
+
+        // ...such as this term. This is a minimum value for the secondary damage reduction. It's very similar to the previous calculation, only with the attacking stat total playing a role
+        // at the cost of the large REDUCTION_CONSTANT value being doubled in the denominator.
+        float damageReduction_resists_min = (REDUCTION_CONSTANT + (0.5f * attackingStatTotal)) / ((REDUCTION_CONSTANT * 2.0f) + defendingResistTotal + defendingStatTotal);
+
+        // In the end, the final damage reduction is the result of passing every value through a range and multiplying them all together.
+        float damageReduction = range<float>(damageReduction_stats, 0.0f, 1.0f) * range<float>(damageReduction_resists, range<float>(damageReduction_resists_min, 0.0f, 1.0f), 1.0f);
+
+        if constexpr (TraceSink::ENABLED) {
+            trace->damageReduction_stats = damageReduction_stats;
+            trace->damageReduction_resists = damageReduction_resists;
+            trace->damageReduction_resists_min = damageReduction_resists_min;
+            trace->damageReduction = damageReduction;
+        }
+
+        return damageReduction;
+    }
+
+    template <typename Policy>
+    float BasicDamageCalculator<Policy>::CalculatePenetratedDamageReduction(float damageReduction) const {
+        return range<float>(PENETRATION_EFFECTIVENESS + mingate<float>(damageReduction * (1.0f - PENETRATION_EFFECTIVENESS), 0.0f), 0.0f, 1.0f);
+    }
+
+    template <typename Policy>
+    float BasicDamageCalculator<Policy>::CalculateBonusScaling(float elementalStatDamage, unsigned long defendingStatTotal) const {
+        /*
+         * This bonus scaling term was one of the only terms which did not end up working the way I thought it would.
+         * Right now, it results in most all non-penetrating damage being doubled.
+         *
+         * The original idea of this term was that because penetrating damage just gets to flat-out ignore damage reduction, I was worried penetrating damage would just be
+         * "strictly better" than nonpenetrating damage and that I would feel inclined to give every powerful ability penetrating damage. To combat this, I thought it would
+         * be a good idea to create a term which can provide a bonus for using nonpenetrating damage which may not be apparent at lower stat values but would begin to be
+         * noticeable with higher stat investments.
+         *
+         * I eventually reasoned that a good implementation of this bonus would be as a sort of logical inverse to damage reduction. Where damage reduction gets capped at
+         * 1, assuming the player has more attacking stats than the defender's defensive stats, this term could have a floor of 1 and would become greater if the attacker's
+         * stats far exceeded the defensive stats of their opponent. I especially liked this because it created a clear role for penetrating damage vs nonpenetrating damage:
+         * if you don't think your offenses greatly surpass their defenses, use penetrating damage, otherwise prefer nonpenetrating damage.
+         *
+         * In principle, it's a good idea. The problem is that I neglected to realize something rather obvious: at lower stat values, it's quite easy for an attacker's
+         * attacking stats to be close to double the defender's defensive stats, especially because I use two attacking stats and one defensive stat. The easy "band-aid" solution
+         * would be to give each battler an equipment which gives them bonus defenses (as would actually happen in a real version of this game), or to double each battler's
+         * defenses. Unfortunately, by the time I realized what was happening I had already balanced the game around the current damage values, so I decided to leave it as
+         * is for now for simplicity's sake, and because people like seeing bigger numbers, and finally as a testimony to how drastic the consequences can be to overlooking
+         * even one small detail in a combat system this complicated.
+         *
+         * If I were to test a "real" version of this game with armor and continue to be unhappy with how the results play out (right now it might make things rather swingy
+         * at low levels), a potential long-term solution would be to create a new constant whose value is something like 20 or so, and simply subtract this value from the
+         * bonus numerator. That way, the player would have to get their stats to a high enough level to see this bonus, and because of the range this term can't go any lower
+         * than 1 so I wouldn't have to worry about accidentally making anything negative.
+         */
+        return range<float>(
+            (elementalStatDamage - (RESIDUAL_CONSTANT * defendingStatTotal)) / (defendingStatTotal > 0UL ? static_cast<float>(defendingStatTotal) : 1.0f),
+            1.0f,
+            NONPEN_BONUS_MAX);
+    }
+
+    template <typename Policy> template <typename TraceSink>
+    float BasicDamageCalculator<Policy>::CalculateBindingDamage(bool isPenetrating, float scaling, ElementalAffinityValue affinity, DamageResistanceValue resistance, float damageReduction, float elementalStatDamage, unsigned long defendingStatTotal,
+            float damageSourcePercentage, DamageTraceBinding* trace) const {
+        // RESIDUAL_CONSTANT comes into play once again here, fulfilling much the same purpose as before.
+        float affinityReduced = mingate<float>(affinity - (RESIDUAL_CONSTANT * resistance), 0.0f);
+
+        // The elemental threshold constant can be thought of in the following way: If the difference between the attacker's affinity and the defender's resistance is equal
+        // to the threshold constant, the defender will take 100% more of that kind of damage. If the difference is double the threshold constant, the defender will take
+        // 200% more of that kind of damage. If the difference is NEGATIVE (-) and equal to half the threshold constant, the defender will take 50% less of that kind of damage,
+        // and so on. Of course, due to the RESIDUAL_CONSTANT expression above that's not *exactly* how it works, but it's close enough to give a clear picture of what's going on.
+        float multiplier = mingate<float>(1.0f + ((affinityReduced - resistance) / ELEM_THRESHOLD_CONSTANT), 0.0f);
+
+        if constexpr (TraceSink::ENABLED) {
+            trace->affinityReduced = affinityReduced;
+            trace->multiplier = multiplier;
+            trace->multiplier_mingate = 0.0f;
+        }
+
+        if (isPenetrating) {
+            float penetratedDamageReduction = CalculatePenetratedDamageReduction(damageReduction);
+            float damage = penetratedDamageReduction * scaling * multiplier * elementalStatDamage * damageSourcePercentage;
+            if constexpr (TraceSink::ENABLED) {
+                trace->damage = damage;
+            }
+            return damage;
+        } else {
+            float bonusScaling = CalculateBonusScaling(elementalStatDamage, defendingStatTotal);
+
+            // This is another advantage nonpenetrating damage has over penetrating damage. It's possible, with enough resistance investment on the defender's part, to completely
+            // reduce the amount of penetrating damage one takes to 0. This "mingate" term makes this not so for nonpenetrating damage.
+            float multiplier_mingate = mingate<float>(1.0f - ((ELEMTHRESH_MULTIP_CONSTANT * ELEM_THRESHOLD_CONSTANT) / ((ELEMTHRESH_MULTIP_CONSTANT * ELEM_THRESHOLD_CONSTANT) + affinity)), 0.0f);
+
+            float damage = damageReduction * scaling * mingate<float>(multiplier, multiplier_mingate) * bonusScaling * elementalStatDamage * damageSourcePercentage;
+            if constexpr (TraceSink::ENABLED) {
+                trace->multiplier_mingate = multiplier_mingate;
+                trace->damage = damage;
+            }
+            return damage;
+        }
+    }
+
+    template <typename Policy>
+    DamageFixed BasicDamageCalculator<Policy>::CalculateDamageReductionFixed(unsigned long attackingStatTotal, unsigned long defendingStatTotal, long defendingResistTotal) const {
+        // Same three terms as CalculateDamageReduction, see there for what each of them means.
+        DamageFixed attacking = DamageFixedFromInt(attackingStatTotal);
+        DamageFixed defending = DamageFixedFromInt(defendingStatTotal);
+        DamageFixed resists = DamageFixedFromInt(defendingResistTotal);
+
+        DamageFixed damageReduction_stats = DamageFixedDivide(DamageFixedSubtract(attacking, DamageFixedMultiply(_fixedConstants.residual, defending)), defendingStatTotal > 0UL ? defending : DAMAGEFIXED_ONE);
+        DamageFixed damageReduction_resists = DamageFixedDivide(_fixedReduction, DamageFixedAdd(DamageFixedAdd(_fixedReduction, resists), defending));
+        DamageFixed damageReduction_resists_min = DamageFixedDivide(
+            DamageFixedAdd(_fixedReduction, attacking / 2),
+            DamageFixedAdd(DamageFixedAdd(DamageFixedAdd(_fixedReduction, _fixedReduction), resists), defending));
+
+        return DamageFixedMultiply(
+            range<DamageFixed>(damageReduction_stats, 0, DAMAGEFIXED_ONE),
+            range<DamageFixed>(damageReduction_resists, range<DamageFixed>(damageReduction_resists_min, 0, DAMAGEFIXED_ONE), DAMAGEFIXED_ONE));
+    }
+
+    template <typename Policy>
+    DamageFixed BasicDamageCalculator<Policy>::CalculatePenetratedDamageReductionFixed(DamageFixed damageReduction) const {
+        DamageFixed ignored = mingate<DamageFixed>(DamageFixedMultiply(damageReduction, DamageFixedSubtract(DAMAGEFIXED_ONE, _fixedPenetrationEffectiveness)), 0);
+        return range<DamageFixed>(DamageFixedAdd(_fixedPenetrationEffectiveness, ignored), 0, DAMAGEFIXED_ONE);
+    }
+
+    template <typename Policy>
+    DamageFixed BasicDamageCalculator<Policy>::CalculateBonusScalingFixed(DamageFixed elementalStatDamage, unsigned long defendingStatTotal) const {
+        DamageFixed defending = DamageFixedFromInt(defendingStatTotal);
+        return range<DamageFixed>(
+            DamageFixedDivide(DamageFixedSubtract(elementalStatDamage, DamageFixedMultiply(_fixedConstants.residual, defending)), defendingStatTotal > 0UL ? defending : DAMAGEFIXED_ONE),
+            DAMAGEFIXED_ONE,
+            _fixedNonpenBonusMax);
+    }
+
+    template <typename Policy>
+    void BasicDamageCalculator<Policy>::CalculateStatTotals(const DamagePlan& plan, const DamagePlanInclination& damageInclination, const BattlerInstance& attacker, const BattlerInstance& defender,
+            unsigned long& attackingStatTotal, unsigned long& defendingStatTotal) const {
+        // Battler instances built from this calculator's stat lists already know their stat totals for every inclination.
+        defendingStatTotal = 0;
+        if (defender.defendingStatLists() == &_xlo->inclinationDefendingStats()) {
+            defendingStatTotal = defender.GetDefendingStatTotal(damageInclination.key);
+        } else {
+            for (BattlerStatKey defendingStat : plan.GetDefendingStats(damageInclination)) {
+                defendingStatTotal += defender.GetStat(defendingStat);
+            }
+        }
+
+        attackingStatTotal = 0;
+        if (attacker.attackingStatLists() == &_xlo->inclinationAttackingStats()) {
+            attackingStatTotal = attacker.GetAttackingStatTotal(damageInclination.attackingKey);
+        } else {
+            for (BattlerStatKey attackingStat : plan.GetAttackingStats(damageInclination)) {
+                attackingStatTotal += attacker.GetStat(attackingStat);
+            }
+        }
+    }
+
+    template <typename Policy>
+    Damage BasicDamageCalculator<Policy>::CalculateDamage(const Skill& skill, const BattlerInstance& attacker, const BattlerInstance& defender) const {
+        DamageTraceNull trace;
+        return CalculateDamage(skill, attacker, defender, trace);
+    }
+
+    template <typename Policy> template <typename TraceSink>
+    Damage BasicDamageCalculator<Policy>::CalculateDamage(const Skill& skill, const BattlerInstance& attacker, const BattlerInstance& defender, TraceSink& trace) const {
+        if (_mode == DamageCalculatorMode::FIXED) {
+            trace.BeginCalculation(skill, attacker, defender);
+            Damage damage = CalculateDamageFixed(skill, attacker, defender);
+            trace.EndCalculation(damage.final());
+            return damage;
+        }
+
+        return CalculateDamageFloat(skill, attacker, defender, trace);
+    }
+
+    template <typename Policy> template <typename TraceSink>
+    Damage BasicDamageCalculator<Policy>::CalculateDamageFloat(const Skill& skill, const BattlerInstance& attacker, const BattlerInstance& defender, TraceSink& trace) const {
+        trace.BeginCalculation(skill, attacker, defender);
+
+        // Skills loaded through the XLO storage are compiled at load time. Anything else gets compiled on the spot.
+        DamagePlan uncompiledPlan;
+        if (!skill.damagePlan().isCompiled()) {
+            uncompiledPlan = DamagePlan(skill.damages(), _lov->damageInclinations(), _xlo->inclinationAttackingStats(), _xlo->inclinationDefendingStats());
+        }
+        const DamagePlan& plan = skill.damagePlan().isCompiled() ? skill.damagePlan() : uncompiledPlan;
+        const std::vector<SkillDamage>& skillDamages = skill.damages();
+
+        // Sum total of ALL resistances the battler has against this inclination of damage. Used for the secondary component of damage reduction.
+        long defendingResistTotal = defender.resistTotal();
+
+        // For each damage component of the skill, we will calculate the damage values. The final damage object will be the total of each of these calculations.
+        std::span<const DamagePlanComponent> components = plan.components();
+        Damage damage(_batchLayout, components.size());
+        std::size_t inclinationStride = _batchLayout.inclinations().size() + 1;
+
+        for (std::size_t componentIndex = 0; componentIndex < components.size(); componentIndex++) {
+            const DamagePlanComponent& component = components[componentIndex];
+            std::span<const DamagePlanInclination> inclinations = plan.GetInclinations(component);
+            float* subtotals = damage.GetCells(componentIndex);
+            float baseDamageReduction = 0.0f;
+
+            // Most damage is calculated per inclination. In other words, calculate all physical damage first, then all magical damage, etc.
+            // Only the inclinations this component actually touches were compiled into the plan.
+            for (std::size_t inclinationIndex = 0; inclinationIndex < inclinations.size(); inclinationIndex++) {
+                const DamagePlanInclination& damageInclination = inclinations[inclinationIndex];
+                DamagePlanIndex inclinationCell = _batchLayout.GetInclinationIndex(damageInclination.key);
+
+                // The attacking stats are compared against the defending stats to determine total damage reduction.
+                // An inclination's "attacking stats" are used to calculate damage reduction, and do not have a bearing on actual damage totals outside of that.
+                unsigned long attackingStatTotal;
+                unsigned long defendingStatTotal;
+                CalculateStatTotals(plan, damageInclination, attacker, defender, attackingStatTotal, defendingStatTotal);
+
+                DamageTraceInclination inclinationTrace;
+                if constexpr (TraceSink::ENABLED) {
+                    inclinationTrace.component = static_cast<unsigned short>(componentIndex);
+                    inclinationTrace.inclination = damageInclination.key;
+                    inclinationTrace.attackingStatTotal = attackingStatTotal;
+                    inclinationTrace.defendingStatTotal = defendingStatTotal;
+                    inclinationTrace.defendingResistTotal = defendingResistTotal;
+                }
+
+                float damageReduction = CalculateDamageReduction<TraceSink>(attackingStatTotal, defendingStatTotal, defendingResistTotal, &inclinationTrace);
+                if (inclinationIndex == component.baseInclination) {
+                    baseDamageReduction = damageReduction;
+                }
+
+                // All damage which scales off of stats are calculated here. This is the damage which then gets "split" into elemental damage.
+                // I use quotes around "split" there because there does not necessarily need to be a 1:1 correlation to the total elemental damage to this stat damage total.
+                // Some skills will use less than 100% of the damage, other skills will use close to double or triple this amount in elemental damage. It all depends on the skill's design.
+                float elementalStatDamage = 0.0f;
+                for (const DamagePlanStatScaling& statScaling : plan.GetStatScalings(damageInclination)) {
+                    elementalStatDamage += attacker.GetStat(statScaling.stat) * statScaling.value;
+                }
+
+                DamageKernelInclination kernelInclination = {};
+                kernelInclination.damageReduction = damageReduction;
+                kernelInclination.penetratedDamageReduction = CalculatePenetratedDamageReduction(damageReduction);
+                kernelInclination.bonusScaling = CalculateBonusScaling(elementalStatDamage, defendingStatTotal);
+                kernelInclination.elementalStatDamage = elementalStatDamage;
+
+                if constexpr (TraceSink::ENABLED) {
+                    inclinationTrace.penetratedDamageReduction = kernelInclination.penetratedDamageReduction;
+                    inclinationTrace.bonusScaling = kernelInclination.bonusScaling;
+                    inclinationTrace.elementalStatDamage = elementalStatDamage;
+                    trace.RecordInclination(inclinationTrace);
+                }
+
+                std::span<const DamagePlanBinding> bindings = plan.GetBindings(damageInclination);
+
+                if constexpr (TraceSink::ENABLED) {
+                    // Traced calculations evaluate one binding at a time, since the trace wants every intermediate term. The kernel gives bit-identical damage, so tracing never changes a result.
+                    for (const DamagePlanBinding& elementBinding : bindings) {
+                        auto typeincl = DamageTypeInclination(elementBinding.damageType, damageInclination.key);
+                        // Group bindings were flattened into their elements when the plan was compiled.
+                        ElementalAffinityValue affinity = 0;
+                        for (SkillElementKey element : plan.GetElements(elementBinding)) {
+                            affinity += attacker.affinities().GetValue(element, typeincl.first);
+                        }
+                        DamageResistanceValue resistance = defender.resistances().GetValue(typeincl);
+                        float& subtotal = subtotals[(_batchLayout.GetTypeIndex(typeincl.first) * inclinationStride) + inclinationCell];
+
+                        float damageSourcePercentage = DetermineDamageSourcePercentage(attacker.GetDamageSource(typeincl));
+
+                        DamageTraceBinding bindingTrace;
+                        bindingTrace.component = static_cast<unsigned short>(componentIndex);
+                        bindingTrace.damageType = elementBinding.damageType;
+                        bindingTrace.inclination = damageInclination.key;
+                        bindingTrace.isPenetrating = elementBinding.isPenetrating;
+                        bindingTrace.scaling = elementBinding.scaling;
+                        bindingTrace.affinity = affinity;
+                        bindingTrace.resistance = resistance;
+                        bindingTrace.damageSourcePercentage = damageSourcePercentage;
+
+                        subtotal += CalculateBindingDamage<TraceSink>(elementBinding.isPenetrating, elementBinding.scaling, affinity, resistance, damageReduction, elementalStatDamage, defendingStatTotal,
+                            damageSourcePercentage, &bindingTrace);
+
+                        trace.RecordBinding(bindingTrace);
+                    }
+                } else {
+                    // Same chunking as CalculateDamageBatch, so a single hit gets the same SIMD kernel a batch does.
+                    for (std::size_t chunkBegin = 0; chunkBegin < bindings.size(); chunkBegin += DAMAGEKERNEL_WIDTH) {
+                        std::size_t chunkCount = std::min<std::size_t>(DAMAGEKERNEL_WIDTH, bindings.size() - chunkBegin);
+                        std::size_t cells[DAMAGEKERNEL_WIDTH];
+                        float scalings[DAMAGEKERNEL_WIDTH];
+                        ElementalAffinityValue affinityValues[DAMAGEKERNEL_WIDTH];
+                        DamageResistanceValue resistanceValues[DAMAGEKERNEL_WIDTH];
+                        float damageSourcePercentages[DAMAGEKERNEL_WIDTH];
+                        int penetrating[DAMAGEKERNEL_WIDTH];
+                        float bindingDamage[DAMAGEKERNEL_WIDTH];
+
+                        for (std::size_t i = 0; i < chunkCount; i++) {
+                            const DamagePlanBinding& elementBinding = bindings[chunkBegin + i];
+                            auto typeincl = DamageTypeInclination(elementBinding.damageType, damageInclination.key);
+
+                            ElementalAffinityValue affinity = 0;
+                            for (SkillElementKey element : plan.GetElements(elementBinding)) {
+                                affinity += attacker.affinities().GetValue(element, typeincl.first);
+                            }
+
+                            cells[i] = (_batchLayout.GetTypeIndex(typeincl.first) * inclinationStride) + inclinationCell;
+                            scalings[i] = elementBinding.scaling;
+                            affinityValues[i] = affinity;
+                            resistanceValues[i] = defender.resistances().GetValue(typeincl);
+                            damageSourcePercentages[i] = DetermineDamageSourcePercentage(attacker.GetDamageSource(typeincl));
+                            penetrating[i] = elementBinding.isPenetrating ? 1 : 0;
+                        }
+
+                        DamageKernelBindings kernelBindings = { scalings, affinityValues, resistanceValues, damageSourcePercentages, penetrating };
+                        EvaluateBindingDamage(_kernelLevel, _kernelConstants, kernelInclination, kernelBindings, chunkCount, bindingDamage);
+
+                        for (std::size_t i = 0; i < chunkCount; i++) {
+                            subtotals[cells[i]] += bindingDamage[i];
+                        }
+                    }
+                }
+            }
+
+            damage.base(componentIndex, DamageBaseDamageValue(skillDamages[componentIndex].baseDamage().inclination(), baseDamageReduction * component.baseDamage));
+        }
+
+        damage.SumTotals();
+        trace.EndCalculation(damage.final());
+        return damage;
+    }
+
+    template <typename Policy>
+    Damage BasicDamageCalculator<Policy>::CalculateDamageFixed(const Skill& skill, const BattlerInstance& attacker, const BattlerInstance& defender) const {
+        // Mirrors CalculateDamageFloat step for step. Every value stays in fixed point until it is copied into the Damage object for display.
+        DamagePlan uncompiledPlan;
+        if (!skill.damagePlan().isCompiled()) {
+            uncompiledPlan = DamagePlan(skill.damages(), _lov->damageInclinations(), _xlo->inclinationAttackingStats(), _xlo->inclinationDefendingStats());
+        }
+        const DamagePlan& plan = skill.damagePlan().isCompiled() ? skill.damagePlan() : uncompiledPlan;
+        const std::vector<SkillDamage>& skillDamages = skill.damages();
+
+        long long sum = 0;
+        long defendingResistTotal = defender.resistTotal();
+
+        std::span<const DamagePlanComponent> components = plan.components();
+        Damage damage(_batchLayout, components.size());
+        std::size_t inclinationStride = _batchLayout.inclinations().size() + 1;
+        DamageInlineBuffer<DamageFixed, Damage::INLINE_CELLS> fixedSubtotals;
+
+        for (std::size_t componentIndex = 0; componentIndex < components.size(); componentIndex++) {
+            const DamagePlanComponent& component = components[componentIndex];
+            std::span<const DamagePlanInclination> inclinations = plan.GetInclinations(component);
+            fixedSubtotals.Assign(damage.cellCount(), 0);
+            DamageFixed baseDamageReduction = 0;
+
+            for (std::size_t inclinationIndex = 0; inclinationIndex < inclinations.size(); inclinationIndex++) {
+                const DamagePlanInclination& damageInclination = inclinations[inclinationIndex];
+                DamagePlanIndex inclinationCell = _batchLayout.GetInclinationIndex(damageInclination.key);
+
+                unsigned long attackingStatTotal;
+                unsigned long defendingStatTotal;
+                CalculateStatTotals(plan, damageInclination, attacker, defender, attackingStatTotal, defendingStatTotal);
+
+                DamageFixed damageReduction = CalculateDamageReductionFixed(attackingStatTotal, defendingStatTotal, defendingResistTotal);
+                if (inclinationIndex == component.baseInclination) {
+                    baseDamageReduction = damageReduction;
+                }
+
+                DamageFixed elementalStatDamage = 0;
+                for (const DamagePlanStatScaling& statScaling : plan.GetStatScalings(damageInclination)) {
+                    elementalStatDamage = DamageFixedAdd(elementalStatDamage, DamageFixedMultiply(DamageFixedFromInt(attacker.GetStat(statScaling.stat)), statScaling.fixedValue));
+                }
+
+                DamageFixedInclination fixedInclination = {};
+                fixedInclination.damageReduction = damageReduction;
+                fixedInclination.penetratedDamageReduction = CalculatePenetratedDamageReductionFixed(damageReduction);
+                fixedInclination.bonusScaling = CalculateBonusScalingFixed(elementalStatDamage, defendingStatTotal);
+                fixedInclination.elementalStatDamage = elementalStatDamage;
+
+                std::span<const DamagePlanBinding> bindings = plan.GetBindings(damageInclination);
+                for (std::size_t chunkBegin = 0; chunkBegin < bindings.size(); chunkBegin += DAMAGEKERNEL_WIDTH) {
+                    std::size_t chunkCount = std::min<std::size_t>(DAMAGEKERNEL_WIDTH, bindings.size() - chunkBegin);
+                    DamageFixed scalings[DAMAGEKERNEL_WIDTH];
+                    ElementalAffinityValue affinityValues[DAMAGEKERNEL_WIDTH];
+                    DamageResistanceValue resistanceValues[DAMAGEKERNEL_WIDTH];
+                    DamageFixed damageSourcePercentages[DAMAGEKERNEL_WIDTH];
+                    int penetrating[DAMAGEKERNEL_WIDTH];
+                    DamageFixed bindingDamage[DAMAGEKERNEL_WIDTH];
+
+                    for (std::size_t i = 0; i < chunkCount; i++) {
+                        const DamagePlanBinding& elementBinding = bindings[chunkBegin + i];
+                        auto typeincl = DamageTypeInclination(elementBinding.damageType, damageInclination.key);
+
+                        ElementalAffinityValue affinity = 0;
+                        for (SkillElementKey element : plan.GetElements(elementBinding)) {
+                            affinity += attacker.affinities().GetValue(element, typeincl.first);
+                        }
+
+                        scalings[i] = elementBinding.fixedScaling;
+                        affinityValues[i] = affinity;
+                        resistanceValues[i] = defender.resistances().GetValue(typeincl);
+                        damageSourcePercentages[i] = DetermineDamageSourcePercentageFixed(attacker.GetDamageSource(typeincl));
+                        penetrating[i] = elementBinding.isPenetrating ? 1 : 0;
+                    }
+
+                    DamageFixedBindings fixedBindings = { scalings, affinityValues, resistanceValues, damageSourcePercentages, penetrating };
+                    EvaluateBindingDamageFixed(_fixedConstants, fixedInclination, fixedBindings, chunkCount, bindingDamage);
+
+                    for (std::size_t i = 0; i < chunkCount; i++) {
+                        DamageFixed& subtotal = fixedSubtotals[(_batchLayout.GetTypeIndex(bindings[chunkBegin + i].damageType) * inclinationStride) + inclinationCell];
+                        subtotal = DamageFixedAdd(subtotal, bindingDamage[i]);
+                    }
+                }
+            }
+
+            DamageFixed baseDamage = DamageFixedMultiply(baseDamageReduction, DamageFixedFromInt(component.baseDamage));
+            sum += baseDamage;
+
+            float* subtotals = damage.GetCells(componentIndex);
+            for (std::size_t cell = 0; cell < damage.cellCount(); cell++) {
+                sum += fixedSubtotals[cell];
+                subtotals[cell] = DamageFixedToFloat(fixedSubtotals[cell]);
+            }
+
+            damage.base(componentIndex, DamageBaseDamageValue(skillDamages[componentIndex].baseDamage().inclination(), DamageFixedToFloat(baseDamage)));
+        }
+
+        damage.SumTotals(DamageFixedCeil(sum));
+        return damage;
+    }
+
+    template <typename Policy>
+    bool BasicDamageCalculator<Policy>::CalculateDamageBatch(std::span<const DamageQuery> queries, std::span<DamageValueFinalTotal> out, std::span<float> typeSubtotals) const {
+        DamageBatchBuffers buffers;
+        return CalculateDamageBatch(queries, out, buffers, typeSubtotals);
+    }
+
+    template <typename Policy>
+    bool BasicDamageCalculator<Policy>::CalculateDamageBatch(std::span<const DamageQuery> queries, std::span<DamageValueFinalTotal> out, DamageBatchBuffers& buffers, std::span<float> typeSubtotals) const {
+        std::size_t typeCount = _batchLayout.types().size();
+        bool wantsTypeSubtotals = !typeSubtotals.empty();
+
+        if (out.size() < queries.size() || (wantsTypeSubtotals && typeSubtotals.size() < (queries.size() * typeCount))) {
+            return false;
+        }
+
+        if (_mode == DamageCalculatorMode::FIXED) {
+            // The fixed-point path has no columnar form yet, so each query is calculated on its own. Results are still exact, just not gathered.
+            for (std::size_t q = 0; q < queries.size(); q++) {
+                const DamageQuery& query = queries[q];
+                if (query.skill == nullptr || query.attacker == nullptr || query.defender == nullptr) {
+                    return false;
+                }
+
+                Damage damage = CalculateDamageFixed(*query.skill, *query.attacker, *query.defender);
+                out[q] = damage.final();
+
+                if (wantsTypeSubtotals) {
+                    std::fill_n(typeSubtotals.begin() + (q * typeCount), typeCount, 0.0f);
+                    std::size_t inclinationStride = _batchLayout.inclinations().size() + 1;
+                    for (std::size_t component = 0; component < damage.componentCount(); component++) {
+                        std::span<const float> cells = damage.GetValues(component).cells();
+                        for (std::size_t t = 0; t < typeCount; t++) {
+                            for (std::size_t i = 0; i < inclinationStride; i++) {
+                                typeSubtotals[(q * typeCount) + t] += cells[(t * inclinationStride) + i];
+                            }
+                        }
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        if (!buffers.Gather(_batchLayout, *_lov, *_xlo, queries)) {
+            return false;
+        }
+
+        std::size_t battlerCount = buffers._battlers.size();
+        std::size_t inclinationStride = _batchLayout.inclinations().size() + 1;
+        std::size_t typeStride = typeCount + 1;
+        const BattlerStatValue* stats = buffers._stats.data();
+        const DamageResistanceValue* resistances = buffers._resistances.data();
+        const float* sourcePercentages = buffers._sourcePercentages.data();
+        const ElementalAffinityValue* affinities = buffers._affinities.data();
+        float* subtotals = buffers._subtotals.data();
+        std::size_t subtotalCount = buffers._subtotals.size();
+
+        // Same calculation as CalculateDamage, reading gathered columns instead of battler maps. Subtotals are accumulated in the same order and summed in the same
+        // type-then-inclination order Damage uses, so the results are bit-identical.
+        for (std::size_t q = 0; q < queries.size(); q++) {
+            const DamageBatchBuffers::PlanSlot& slot = buffers._plans[buffers._queryPlans[q]];
+            const DamagePlan& plan = *slot.plan;
+            std::size_t attacker = buffers._queryAttackers[q];
+            std::size_t defender = buffers._queryDefenders[q];
+            long defendingResistTotal = buffers._resistTotals[defender];
+            float sum = 0.0f;
+
+            if (wantsTypeSubtotals) {
+                std::fill_n(typeSubtotals.begin() + (q * typeCount), typeCount, 0.0f);
+            }
+
+            for (const DamagePlanComponent& component : plan.components()) {
+                std::fill_n(subtotals, subtotalCount, 0.0f);
+                float baseDamageReduction = 0.0f;
+
+                for (DamagePlanIndex inclinationIndex = 0; inclinationIndex < component.inclinations.count; inclinationIndex++) {
+                    std::size_t planInclination = component.inclinations.begin + inclinationIndex;
+                    const DamagePlanInclination& damageInclination = plan.inclinations()[planInclination];
+                    std::size_t inclination = buffers._inclinationIndices[slot.inclinationsBegin + planInclination];
+
+                    unsigned long defendingStatTotal = 0;
+                    for (DamagePlanIndex i = 0; i < damageInclination.defendingStats.count; i++) {
+                        defendingStatTotal += stats[(buffers._statIndices[slot.statsBegin + damageInclination.defendingStats.begin + i] * battlerCount) + defender];
+                    }
+
+                    unsigned long attackingStatTotal = 0;
+                    for (DamagePlanIndex i = 0; i < damageInclination.attackingStats.count; i++) {
+                        attackingStatTotal += stats[(buffers._statIndices[slot.statsBegin + damageInclination.attackingStats.begin + i] * battlerCount) + attacker];
+                    }
+
+                    float damageReduction = CalculateDamageReduction(attackingStatTotal, defendingStatTotal, defendingResistTotal);
+                    if (inclinationIndex == component.baseInclination) {
+                        baseDamageReduction = damageReduction;
+                    }
+
+                    float elementalStatDamage = 0.0f;
+                    for (DamagePlanIndex i = 0; i < damageInclination.statScalings.count; i++) {
+                        std::size_t scaling = damageInclination.statScalings.begin + i;
+                        elementalStatDamage += stats[(buffers._statScalingIndices[slot.statScalingsBegin + scaling] * battlerCount) + attacker] * plan.statScalings()[scaling].value;
+                    }
+
+                    DamageKernelInclination kernelInclination = {};
+                    kernelInclination.damageReduction = damageReduction;
+                    kernelInclination.penetratedDamageReduction = CalculatePenetratedDamageReduction(damageReduction);
+                    kernelInclination.bonusScaling = CalculateBonusScaling(elementalStatDamage, defendingStatTotal);
+                    kernelInclination.elementalStatDamage = elementalStatDamage;
+
+                    // Bindings are gathered into kernel-sized chunks, evaluated together, then added to their subtotals in their original order.
+                    for (DamagePlanIndex chunkBegin = 0; chunkBegin < damageInclination.bindings.count; chunkBegin += DAMAGEKERNEL_WIDTH) {
+                        std::size_t chunkCount = std::min<std::size_t>(DAMAGEKERNEL_WIDTH, damageInclination.bindings.count - chunkBegin);
+                        std::size_t rows[DAMAGEKERNEL_WIDTH];
+                        float scalings[DAMAGEKERNEL_WIDTH];
+                        ElementalAffinityValue affinityValues[DAMAGEKERNEL_WIDTH];
+                        DamageResistanceValue resistanceValues[DAMAGEKERNEL_WIDTH];
+                        float damageSourcePercentages[DAMAGEKERNEL_WIDTH];
+                        int penetrating[DAMAGEKERNEL_WIDTH];
+                        float bindingDamage[DAMAGEKERNEL_WIDTH];
+
+                        for (std::size_t i = 0; i < chunkCount; i++) {
+                            std::size_t binding = damageInclination.bindings.begin + chunkBegin + i;
+                            const DamagePlanBinding& elementBinding = plan.bindings()[binding];
+                            std::size_t dmgtype = buffers._bindingTypeIndices[slot.bindingsBegin + binding];
+                            rows[i] = (dmgtype * inclinationStride) + inclination;
+
+                            ElementalAffinityValue affinity = 0;
+                            for (DamagePlanIndex e = 0; e < elementBinding.elements.count; e++) {
+                                std::size_t element = buffers._elementIndices[slot.elementsBegin + elementBinding.elements.begin + e];
+                                affinity += affinities[(((element * typeStride) + dmgtype) * battlerCount) + attacker];
+                            }
+
+                            scalings[i] = elementBinding.scaling;
+                            affinityValues[i] = affinity;
+                            resistanceValues[i] = resistances[(rows[i] * battlerCount) + defender];
+                            damageSourcePercentages[i] = sourcePercentages[(rows[i] * battlerCount) + attacker];
+                            penetrating[i] = elementBinding.isPenetrating ? 1 : 0;
+                        }
+
+                        DamageKernelBindings kernelBindings = { scalings, affinityValues, resistanceValues, damageSourcePercentages, penetrating };
+                        EvaluateBindingDamage(_kernelLevel, _kernelConstants, kernelInclination, kernelBindings, chunkCount, bindingDamage);
+
+                        for (std::size_t i = 0; i < chunkCount; i++) {
+                            subtotals[rows[i]] += bindingDamage[i];
+                        }
+                    }
+                }
+
+                float total = baseDamageReduction * component.baseDamage;
+                for (std::size_t row = 0; row < subtotalCount; row++) {
+                    total += subtotals[row];
+                }
+                sum += total;
+
+                if (wantsTypeSubtotals) {
+                    for (std::size_t t = 0; t < typeCount; t++) {
+                        for (std::size_t i = 0; i < inclinationStride; i++) {
+                            typeSubtotals[(q * typeCount) + t] += subtotals[(t * inclinationStride) + i];
+                        }
+                    }
+                }
+            }
+
+            out[q] = static_cast<DamageValueFinalTotal>(std::ceil(sum));
+        }
+
+        return true;
+    }
+
+    template <typename Policy>
+    DamageModeToleranceReport BasicDamageCalculator<Policy>::CreateModeToleranceReport(std::span<const DamageQuery> queries) const {
+        DamageModeToleranceReport report = {};
+
+        auto compare = [&report](float floatValue, float fixedValue) {
+            float difference = std::fabs(floatValue - fixedValue);
+            report.maxSubtotalDifference = std::max(report.maxSubtotalDifference, difference);
+            report.maxRelativeDifference = std::max(report.maxRelativeDifference, difference / std::max(std::fabs(floatValue), 1.0f));
+        };
+
+        for (const DamageQuery& query : queries) {
+            if (query.skill == nullptr || query.attacker == nullptr || query.defender == nullptr) {
+                continue;
+            }
+
+            DamageTraceNull trace;
+            Damage floatDamage = CalculateDamageFloat(*query.skill, *query.attacker, *query.defender, trace);
+            Damage fixedDamage = CalculateDamageFixed(*query.skill, *query.attacker, *query.defender);
+            report.count++;
+
+            DamageValueFinalTotal finalDifference = std::labs(floatDamage.final() - fixedDamage.final());
+            if (finalDifference != 0) {
+                report.finalMismatches++;
+                report.maxFinalDifference = std::max(report.maxFinalDifference, finalDifference);
+            }
+
+            // Both modes walk the same plan with the same layout, so they always produce the same components with the same grids.
+            for (std::size_t i = 0; i < floatDamage.componentCount() && i < fixedDamage.componentCount(); i++) {
+                DamageValues floatValues = floatDamage.GetValues(i);
+                DamageValues fixedValues = fixedDamage.GetValues(i);
+
+                compare(floatValues.base().value(), fixedValues.base().value());
+                for (std::size_t cell = 0; cell < floatValues.cells().size(); cell++) {
+                    compare(floatValues.cells()[cell], fixedValues.cells()[cell]);
+                }
+            }
+        }
+
+        return report;
+    }
+}
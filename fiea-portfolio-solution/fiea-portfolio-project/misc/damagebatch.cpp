@@ -0,0 +1,169 @@
+#include "damagebatch.h"
+#include <algorithm>
+#include "../models/damagesource.h"
+
+namespace AWE {
+
+    /* DamageBatchLayout */
+
+    DamageBatchLayout::DamageBatchLayout() {}
+    // The storage's index tables are already sorted by key, so the layout's indices are the same as the storage's.
+    DamageBatchLayout::DamageBatchLayout(const GameLOVStorage& lov)
+        : _stats(lov.battlerStatIndices().keys()), _types(lov.damageTypeIndices().keys()), _inclinations(lov.damageInclinationIndices().keys()), _elements(lov.skillElementIndices().keys()) {}
+
+    const std::vector<BattlerStatKey>& DamageBatchLayout::stats() const { return _stats; }
+    const std::vector<DamageTypeKey>& DamageBatchLayout::types() const { return _types; }
+    const std::vector<DamageInclinationKey>& DamageBatchLayout::inclinations() const { return _inclinations; }
+    const std::vector<SkillElementKey>& DamageBatchLayout::elements() const { return _elements; }
+
+    DamagePlanIndex DamageBatchLayout::GetStatIndex(BattlerStatKey key) const {
+        auto found = std::lower_bound(_stats.begin(), _stats.end(), key);
+        return static_cast<DamagePlanIndex>((found != _stats.end() && *found == key) ? (found - _stats.begin()) : _stats.size());
+    }
+    DamagePlanIndex DamageBatchLayout::GetTypeIndex(DamageTypeKey key) const {
+        auto found = std::lower_bound(_types.begin(), _types.end(), key);
+        return static_cast<DamagePlanIndex>((found != _types.end() && *found == key) ? (found - _types.begin()) : _types.size());
+    }
+    DamagePlanIndex DamageBatchLayout::GetInclinationIndex(DamageInclinationKey key) const {
+        auto found = std::lower_bound(_inclinations.begin(), _inclinations.end(), key);
+        return static_cast<DamagePlanIndex>((found != _inclinations.end() && *found == key) ? (found - _inclinations.begin()) : _inclinations.size());
+    }
+    DamagePlanIndex DamageBatchLayout::GetElementIndex(SkillElementKey key) const {
+        auto found = std::lower_bound(_elements.begin(), _elements.end(), key);
+        return static_cast<DamagePlanIndex>((found != _elements.end() && *found == key) ? (found - _elements.begin()) : _elements.size());
+    }
+
+
+    /* DamageBatchBuffers */
+
+    DamageBatchBuffers::DamageBatchBuffers() : _layout(nullptr) {}
+
+    unsigned int DamageBatchBuffers::AddBattler(const BattlerInstance* battler) {
+        auto inserted = _battlerColumns.try_emplace(battler, static_cast<unsigned int>(_battlers.size()));
+        if (inserted.second) {
+            _battlers.push_back(battler);
+        }
+
+        return inserted.first->second;
+    }
+
+    unsigned int DamageBatchBuffers::AddPlan(const Skill* skill, const GameLOVStorage& lov, const GameXLOStorage& xlo) {
+        auto inserted = _planSlots.try_emplace(skill, static_cast<unsigned int>(_plans.size()));
+        if (!inserted.second) {
+            return inserted.first->second;
+        }
+
+        const DamagePlan* plan = &skill->damagePlan();
+        if (!plan->isCompiled()) {
+            _uncompiledPlans.push_back(DamagePlan(skill->damages(), lov.damageInclinations(), xlo.inclinationAttackingStats(), xlo.inclinationDefendingStats()));
+            plan = &_uncompiledPlans.back();
+        }
+
+        PlanSlot slot = {};
+        slot.skill = skill;
+        slot.plan = plan;
+
+        slot.inclinationsBegin = static_cast<unsigned int>(_inclinationIndices.size());
+        for (const DamagePlanInclination& inclination : plan->inclinations()) {
+            _inclinationIndices.push_back(_layout->GetInclinationIndex(inclination.key));
+        }
+
+        slot.statsBegin = static_cast<unsigned int>(_statIndices.size());
+        for (BattlerStatKey stat : plan->stats()) {
+            _statIndices.push_back(_layout->GetStatIndex(stat));
+        }
+
+        slot.statScalingsBegin = static_cast<unsigned int>(_statScalingIndices.size());
+        for (const DamagePlanStatScaling& scaling : plan->statScalings()) {
+            _statScalingIndices.push_back(_layout->GetStatIndex(scaling.stat));
+        }
+
+        slot.bindingsBegin = static_cast<unsigned int>(_bindingTypeIndices.size());
+        for (const DamagePlanBinding& binding : plan->bindings()) {
+            _bindingTypeIndices.push_back(_layout->GetTypeIndex(binding.damageType));
+        }
+
+        slot.elementsBegin = static_cast<unsigned int>(_elementIndices.size());
+        for (SkillElementKey element : plan->elements()) {
+            _elementIndices.push_back(_layout->GetElementIndex(element));
+        }
+
+        _plans.push_back(slot);
+        return static_cast<unsigned int>(_plans.size() - 1);
+    }
+
+    void DamageBatchBuffers::GatherBattlers() {
+        const std::vector<BattlerStatKey>& stats = _layout->stats();
+        const std::vector<DamageTypeKey>& types = _layout->types();
+        const std::vector<DamageInclinationKey>& inclinations = _layout->inclinations();
+        std::size_t battlerCount = _battlers.size();
+        std::size_t inclinationStride = inclinations.size() + 1;
+        std::size_t typeStride = types.size() + 1;
+
+        // Every array gets one extra row at the end for keys which are not in the layout. Those rows stay zero.
+        _stats.assign((stats.size() + 1) * battlerCount, 0);
+        _resistTotals.assign(battlerCount, 0);
+        _resistances.assign(typeStride * inclinationStride * battlerCount, 0);
+        _sourcePercentages.assign(typeStride * inclinationStride * battlerCount, 0.0f);
+        _affinities.assign((_layout->elements().size() + 1) * typeStride * battlerCount, 0);
+
+        for (std::size_t b = 0; b < battlerCount; b++) {
+            const BattlerInstance& battler = *_battlers[b];
+
+            for (std::size_t s = 0; s < stats.size(); s++) {
+                _stats[(s * battlerCount) + b] = battler.GetStat(stats[s]);
+            }
+
+            // Sum total of ALL resistances, same as the single-query path. Keys outside the layout still count towards it.
+            _resistTotals[b] = battler.resistTotal();
+
+            for (std::size_t t = 0; t < types.size(); t++) {
+                for (std::size_t i = 0; i < inclinations.size(); i++) {
+                    std::size_t row = (t * inclinationStride) + i;
+                    _resistances[(row * battlerCount) + b] = battler.resistances().GetValue(types[t], inclinations[i]);
+                    _sourcePercentages[(row * battlerCount) + b] = DetermineDamageSourcePercentage(battler.GetDamageSource(types[t], inclinations[i]));
+                }
+            }
+
+            for (const ElementalAffinities::const_iterator::value_type& affinity : battler.affinities()) {
+                DamagePlanIndex element = _layout->GetElementIndex(affinity.first.first);
+                DamagePlanIndex dmgtype = _layout->GetTypeIndex(affinity.first.second);
+                if (element < _layout->elements().size() && dmgtype < types.size()) {
+                    _affinities[(((element * typeStride) + dmgtype) * battlerCount) + b] = affinity.second;
+                }
+            }
+        }
+    }
+
+    bool DamageBatchBuffers::Gather(const DamageBatchLayout& layout, const GameLOVStorage& lov, const GameXLOStorage& xlo, std::span<const DamageQuery> queries) {
+        _layout = &layout;
+        _battlers.clear();
+        _battlerColumns.clear();
+        _plans.clear();
+        _planSlots.clear();
+        _uncompiledPlans.clear();
+        _inclinationIndices.clear();
+        _statIndices.clear();
+        _statScalingIndices.clear();
+        _bindingTypeIndices.clear();
+        _elementIndices.clear();
+        _queryAttackers.clear();
+        _queryDefenders.clear();
+        _queryPlans.clear();
+
+        for (const DamageQuery& query : queries) {
+            if (query.skill == nullptr || query.attacker == nullptr || query.defender == nullptr) {
+                return false;
+            }
+
+            _queryPlans.push_back(AddPlan(query.skill, lov, xlo));
+            _queryAttackers.push_back(AddBattler(query.attacker));
+            _queryDefenders.push_back(AddBattler(query.defender));
+        }
+
+        GatherBattlers();
+        _subtotals.assign((layout.types().size() + 1) * (layout.inclinations().size() + 1), 0.0f);
+
+        return true;
+    }
+}
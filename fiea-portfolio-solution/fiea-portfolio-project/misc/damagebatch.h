@@ -0,0 +1,132 @@
+#pragma once
+#include <deque>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "../models/battler.h"
+#include "../models/damageplan.h"
+#include "../models/skill.h"
+#include "../store/gamelovstorage.h"
+#include "../store/gamexlostorage.h"
+
+namespace AWE {
+    // Forward declaration, defined in damage.h
+    template <typename Policy> class BasicDamageCalculator;
+
+    /// <summary>
+    /// One (skill, attacker, defender) triple to be priced by DamageCalculator::CalculateDamageBatch. None of the pointers are owned by the query.
+    /// </summary>
+    struct DamageQuery {
+        const Skill* skill;
+        const BattlerInstance* attacker;
+        const BattlerInstance* defender;
+    };
+
+    /// <summary>
+    /// Dense indices for every LOV the damage formula reads, copied from the LOV storage's index tables, so a layout index is the same as the storage's LOVIndex. Each list is sorted by key, so index order
+    /// matches the ordering DamageTypeInclination_comp uses.
+    /// A key which is not in the layout resolves to the size of its list, which batch buffers reserve as an always-zero slot.
+    /// </summary>
+    class DamageBatchLayout {
+    private:
+        std::vector<BattlerStatKey> _stats;
+        std::vector<DamageTypeKey> _types;
+        std::vector<DamageInclinationKey> _inclinations;
+        std::vector<SkillElementKey> _elements;
+
+    public:
+        DamageBatchLayout();
+        DamageBatchLayout(const GameLOVStorage&);
+
+        /// <returns>const reference to all battler stat keys, in index order.</returns>
+        const std::vector<BattlerStatKey>& stats() const;
+        /// <returns>const reference to all damage type keys, in index order.</returns>
+        const std::vector<DamageTypeKey>& types() const;
+        /// <returns>const reference to all damage inclination keys, in index order.</returns>
+        const std::vector<DamageInclinationKey>& inclinations() const;
+        /// <returns>const reference to all skill element keys, in index order.</returns>
+        const std::vector<SkillElementKey>& elements() const;
+
+        /// <returns>Index of the given battler stat, or the number of stats if it is not in the layout.</returns>
+        DamagePlanIndex GetStatIndex(BattlerStatKey) const;
+        /// <returns>Index of the given damage type, or the number of types if it is not in the layout.</returns>
+        DamagePlanIndex GetTypeIndex(DamageTypeKey) const;
+        /// <returns>Index of the given damage inclination, or the number of inclinations if it is not in the layout.</returns>
+        DamagePlanIndex GetInclinationIndex(DamageInclinationKey) const;
+        /// <returns>Index of the given skill element, or the number of elements if it is not in the layout.</returns>
+        DamagePlanIndex GetElementIndex(SkillElementKey) const;
+    };
+
+    /// <summary>
+    /// Structure-of-arrays scratch space for DamageCalculator::CalculateDamageBatch. Every battler and skill referenced by a batch is gathered exactly once, after which a query is nothing
+    /// but indices into these arrays. Reusing one object across batches lets the arrays keep their capacity, so steady-state batches do not allocate.
+    /// </summary>
+    class DamageBatchBuffers {
+    private:
+        /// <summary>
+        /// Where one skill's translated indices begin in the shared index arrays. Each begins at the same offset its plan's flat array would.
+        /// </summary>
+        struct PlanSlot {
+            const Skill* skill;
+            const DamagePlan* plan;
+            unsigned int inclinationsBegin;
+            unsigned int statsBegin;
+            unsigned int statScalingsBegin;
+            unsigned int bindingsBegin;
+            unsigned int elementsBegin;
+        };
+
+        const DamageBatchLayout* _layout;
+
+        // Per battler. Row-major by field, column-major by battler: value of row r for battler b lives at [r * battler count + b].
+        std::vector<BattlerStatValue> _stats;
+        std::vector<long> _resistTotals;
+        std::vector<DamageResistanceValue> _resistances;
+        std::vector<float> _sourcePercentages;
+        std::vector<ElementalAffinityValue> _affinities;
+
+        // Per skill.
+        std::vector<PlanSlot> _plans;
+        std::deque<DamagePlan> _uncompiledPlans;
+        std::vector<DamagePlanIndex> _inclinationIndices;
+        std::vector<DamagePlanIndex> _statIndices;
+        std::vector<DamagePlanIndex> _statScalingIndices;
+        std::vector<DamagePlanIndex> _bindingTypeIndices;
+        std::vector<DamagePlanIndex> _elementIndices;
+
+        // Per query.
+        std::vector<unsigned int> _queryAttackers;
+        std::vector<unsigned int> _queryDefenders;
+        std::vector<unsigned int> _queryPlans;
+
+        // Gathered battlers, in column order.
+        std::vector<const BattlerInstance*> _battlers;
+
+        // Column of every gathered battler and slot of every gathered skill, so gathering stays linear in the number of queries. Cleared per batch, capacity kept.
+        std::unordered_map<const BattlerInstance*, unsigned int> _battlerColumns;
+        std::unordered_map<const Skill*, unsigned int> _planSlots;
+
+        // Per component, reset for every component of every query. Indexed by type index * (inclination count + 1) + inclination index.
+        std::vector<float> _subtotals;
+
+        /// <returns>Column of the given battler, adding it if it has not been seen yet in this batch.</returns>
+        unsigned int AddBattler(const BattlerInstance*);
+        /// <returns>Index of the given skill's plan slot, translating its plan if it has not been seen yet in this batch.</returns>
+        unsigned int AddPlan(const Skill*, const GameLOVStorage&, const GameXLOStorage&);
+        /// <summary>
+        /// Fills the per-battler arrays once every battler in the batch is known.
+        /// </summary>
+        void GatherBattlers();
+
+        template <typename Policy> friend class BasicDamageCalculator;
+
+    public:
+        DamageBatchBuffers();
+
+        /// <summary>
+        /// Gathers every battler and skill the given queries reference. Any previously gathered data is discarded.
+        /// </summary>
+        /// <returns>False if any query has an empty pointer, true otherwise.</returns>
+        bool Gather(const DamageBatchLayout&, const GameLOVStorage&, const GameXLOStorage&, std::span<const DamageQuery>);
+    };
+}
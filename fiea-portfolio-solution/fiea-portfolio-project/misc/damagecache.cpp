@@ -0,0 +1,148 @@
+#include "damagecache.h"
+#include <cstring>
+
+namespace AWE {
+
+    /* DamageCache */
+
+    DamageCache::Slot::Slot() : sequence(0) {
+        for (std::atomic<Word>& word : words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    DamageCache::DamageCache(const DamageCalculator& calc, std::size_t capacity) : _calc(&calc), _slots(capacity > 0 ? capacity : 1), _hits(0), _misses(0) {}
+
+    const std::size_t DamageCache::DEFAULT_CAPACITY = 256;
+
+    const DamageCalculator* DamageCache::calc() const { return _calc; }
+    std::size_t DamageCache::capacity() const { return _slots.size(); }
+    unsigned long DamageCache::hits() const { return _hits.load(std::memory_order_relaxed); }
+    unsigned long DamageCache::misses() const { return _misses.load(std::memory_order_relaxed); }
+
+    DamageCache::Slot& DamageCache::GetSlot(const Skill* skill, BattlerInstanceVersion attackerVersion, BattlerInstanceVersion defenderVersion) {
+        std::uint64_t hash = reinterpret_cast<std::uintptr_t>(skill);
+        hash = (hash ^ attackerVersion) * 0x9E3779B97F4A7C15ULL;
+        hash = (hash ^ defenderVersion) * 0x9E3779B97F4A7C15ULL;
+        return _slots[(hash >> 32) % _slots.size()];
+    }
+
+    bool DamageCache::Load(Slot& slot, Record& record) const {
+        unsigned long before = slot.sequence.load(std::memory_order_acquire);
+        if (before == 0 || (before & 1) != 0) {
+            return false;
+        }
+
+        Word words[RECORD_WORDS];
+        for (std::size_t i = 0; i < RECORD_WORDS; i++) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+
+        // If the sequence moved while the words were being read, they may be a mix of two records.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+
+        Record loaded;
+        std::memcpy(&loaded, words, sizeof(Record));
+        if (loaded.skill != record.skill || loaded.attackerVersion != record.attackerVersion || loaded.defenderVersion != record.defenderVersion || loaded.mode != record.mode) {
+            return false;
+        }
+
+        record = loaded;
+        return true;
+    }
+
+    void DamageCache::Store(Slot& slot, const Record& record) {
+        unsigned long sequence = slot.sequence.load(std::memory_order_relaxed);
+        if ((sequence & 1) != 0 || !slot.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed)) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Word words[RECORD_WORDS] = {};
+        std::memcpy(words, &record, sizeof(Record));
+        for (std::size_t i = 0; i < RECORD_WORDS; i++) {
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    Damage DamageCache::CalculateDamage(const Skill& skill, const BattlerInstance& attacker, const BattlerInstance& defender) {
+        Record record = {};
+        record.skill = &skill;
+        record.attackerVersion = attacker.version();
+        record.defenderVersion = defender.version();
+        record.mode = _calc->mode();
+
+        Slot& slot = GetSlot(record.skill, record.attackerVersion, record.defenderVersion);
+        const std::vector<SkillDamage>& skillDamages = skill.damages();
+
+        if (Load(slot, record) && record.componentCount == skillDamages.size()) {
+            _hits.fetch_add(1, std::memory_order_relaxed);
+
+            // Every subtotal goes back into the same grid cell it came from, so the totals sum to the same bits. The final total is recorded as is,
+            // since the fixed-point mode does not derive it from the float values.
+            Damage damage(_calc->batchLayout(), record.componentCount);
+            std::size_t subtotal = 0;
+            for (std::size_t component = 0; component < record.componentCount; component++) {
+                float* cells = damage.GetCells(component);
+                for (; subtotal < record.subtotalEnds[component]; subtotal++) {
+                    cells[record.subtotalCells[subtotal]] = record.subtotalValues[subtotal];
+                }
+
+                damage.base(component, DamageBaseDamageValue(skillDamages[component].baseDamage().inclination(), record.baseValues[component]));
+            }
+
+            damage.SumTotals(record.final);
+            return damage;
+        }
+
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        Damage damage = _calc->CalculateDamage(skill, attacker, defender);
+
+        // Damage which does not fit into a record is just not cached.
+        if (damage.componentCount() > MAX_COMPONENTS) {
+            return damage;
+        }
+
+        record.final = damage.final();
+        record.componentCount = static_cast<unsigned short>(damage.componentCount());
+        record.subtotalCount = 0;
+        for (std::size_t component = 0; component < damage.componentCount(); component++) {
+            DamageValues values = damage.GetValues(component);
+            std::span<const float> cells = values.cells();
+
+            record.baseValues[component] = values.base().value();
+            for (std::size_t cell = 0; cell < cells.size(); cell++) {
+                if (cells[cell] == 0.0f) {
+                    continue;
+                }
+                if (record.subtotalCount == MAX_SUBTOTALS) {
+                    return damage;
+                }
+
+                record.subtotalCells[record.subtotalCount] = static_cast<unsigned short>(cell);
+                record.subtotalValues[record.subtotalCount] = cells[cell];
+                record.subtotalCount++;
+            }
+            record.subtotalEnds[component] = record.subtotalCount;
+        }
+
+        Store(slot, record);
+        return damage;
+    }
+
+    void DamageCache::Clear() {
+        for (Slot& slot : _slots) {
+            slot.sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void DamageCache::ResetCounters() {
+        _hits.store(0, std::memory_order_relaxed);
+        _misses.store(0, std::memory_order_relaxed);
+    }
+}
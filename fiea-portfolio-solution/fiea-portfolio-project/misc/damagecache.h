@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "damage.h"
+#include "../models/battler.h"
+#include "../models/skill.h"
+
+namespace AWE {
+    /// <summary>
+    /// Bounded memo of damage calculations keyed by skill, by the versions of both battler instances, and by the calculator's mode. Since a battler instance's version changes with every mutation which can affect damage,
+    /// a matching entry is always the damage the calculator would produce. Lookups never block: each slot is guarded by a sequence counter, and a lookup which races with a write is simply a miss.
+    /// Skills are keyed by address, so the cache should be cleared if skills are ever reloaded.
+    /// </summary>
+    class DamageCache {
+    public:
+        /// <summary>Damage with more components than this is calculated every time.</summary>
+        static const std::size_t MAX_COMPONENTS = 4;
+        /// <summary>Damage with more nonzero subtotals than this, across all components, is calculated every time.</summary>
+        static const std::size_t MAX_SUBTOTALS = 16;
+
+    private:
+        /// <summary>
+        /// Flattened copy of a Damage object. Trivially copyable, so it can be copied in and out of a slot word by word.
+        /// </summary>
+        struct Record {
+            const Skill* skill;
+            BattlerInstanceVersion attackerVersion;
+            BattlerInstanceVersion defenderVersion;
+            DamageCalculatorMode mode;
+            DamageValueFinalTotal final;
+            unsigned short componentCount;
+            unsigned short subtotalCount;
+            float baseValues[MAX_COMPONENTS];
+            unsigned short subtotalEnds[MAX_COMPONENTS];
+            /// <summary>Grid cell of each nonzero subtotal within its component. Every other cell is 0.</summary>
+            unsigned short subtotalCells[MAX_SUBTOTALS];
+            float subtotalValues[MAX_SUBTOTALS];
+        };
+
+        typedef std::uint64_t Word;
+        static const std::size_t RECORD_WORDS = (sizeof(Record) + sizeof(Word) - 1) / sizeof(Word);
+
+        /// <summary>
+        /// One entry of the cache. The sequence is odd while the slot is being written and even otherwise.
+        /// </summary>
+        struct Slot {
+            std::atomic<unsigned long> sequence;
+            std::atomic<Word> words[RECORD_WORDS];
+
+            Slot();
+        };
+
+        const DamageCalculator* _calc;
+        std::vector<Slot> _slots;
+        std::atomic<unsigned long> _hits;
+        std::atomic<unsigned long> _misses;
+
+        /// <returns>The slot the given key maps to.</returns>
+        Slot& GetSlot(const Skill*, BattlerInstanceVersion attackerVersion, BattlerInstanceVersion defenderVersion);
+        /// <returns>true if the slot held a record with the same key as the one given, which is then overwritten with the slot's record. false otherwise.</returns>
+        bool Load(Slot&, Record&) const;
+        /// <summary>
+        /// Writes the record into the slot. If another thread is already writing that slot, the record is dropped.
+        /// </summary>
+        void Store(Slot&, const Record&);
+
+    public:
+        /// <param name="calc">Calculator used for misses. Must outlive the cache.</param>
+        /// <param name="capacity">Number of slots. Keys which map to the same slot evict each other.</param>
+        DamageCache(const DamageCalculator& calc, std::size_t capacity = DEFAULT_CAPACITY);
+
+        DamageCache(const DamageCache&) = delete;
+        DamageCache& operator=(const DamageCache&) = delete;
+
+        /// <summary>Number of slots used when no capacity is given.</summary>
+        static const std::size_t DEFAULT_CAPACITY;
+
+        /// <returns>const pointer to the damage calculator this cache sits in front of.</returns>
+        const DamageCalculator* calc() const;
+        /// <returns>Number of slots in the cache.</returns>
+        std::size_t capacity() const;
+        /// <returns>Number of lookups which were answered by the cache.</returns>
+        unsigned long hits() const;
+        /// <returns>Number of lookups which had to be calculated.</returns>
+        unsigned long misses() const;
+
+        /// <returns>Resultant damage from attacker using skill on defender, identical to DamageCalculator::CalculateDamage.</returns>
+        Damage CalculateDamage(const Skill& skill, const BattlerInstance& attacker, const BattlerInstance& defender);
+        /// <summary>
+        /// Empties every slot. Must not be called while other threads are using the cache.
+        /// </summary>
+        void Clear();
+        /// <summary>
+        /// Sets the hit and miss counts back to 0.
+        /// </summary>
+        void ResetCounters();
+    };
+}
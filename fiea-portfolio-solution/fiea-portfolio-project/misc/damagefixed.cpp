@@ -0,0 +1,113 @@
+#include "damagefixed.h"
+#include <cmath>
+#include <limits>
+
+namespace AWE {
+    namespace DAMAGEFIXED_PRIVATE {
+        inline DamageFixed Saturate(std::int64_t value) {
+            if (value > std::numeric_limits<DamageFixed>::max()) {
+                return std::numeric_limits<DamageFixed>::max();
+            }
+            if (value < std::numeric_limits<DamageFixed>::min()) {
+                return std::numeric_limits<DamageFixed>::min();
+            }
+            return static_cast<DamageFixed>(value);
+        }
+
+        inline DamageFixed FromInt(std::int64_t value) {
+            return Saturate(value * DAMAGEFIXED_ONE);
+        }
+
+        inline DamageFixed Multiply(DamageFixed a, DamageFixed b) {
+            return Saturate((static_cast<std::int64_t>(a) * b) >> DAMAGEFIXED_FRACTION_BITS);
+        }
+
+        inline DamageFixed Divide(DamageFixed dividend, DamageFixed divisor) {
+            if (divisor == 0) {
+                return (dividend > 0) ? std::numeric_limits<DamageFixed>::max() : ((dividend < 0) ? std::numeric_limits<DamageFixed>::min() : 0);
+            }
+            return Saturate((static_cast<std::int64_t>(dividend) * DAMAGEFIXED_ONE) / divisor);
+        }
+
+        inline DamageFixed Add(DamageFixed a, DamageFixed b) {
+            return Saturate(static_cast<std::int64_t>(a) + b);
+        }
+
+        inline DamageFixed Subtract(DamageFixed a, DamageFixed b) {
+            return Saturate(static_cast<std::int64_t>(a) - b);
+        }
+
+        inline DamageFixed Mingate(DamageFixed value, DamageFixed min) {
+            return (value < min) ? min : value;
+        }
+    }
+
+    DamageFixed DamageFixedFromInt(long long value) {
+        // Anything this large saturates anyway, and clamping first keeps the multiplication from overflowing.
+        if (value > std::numeric_limits<DamageFixed>::max()) {
+            value = std::numeric_limits<DamageFixed>::max();
+        } else if (value < std::numeric_limits<DamageFixed>::min()) {
+            value = std::numeric_limits<DamageFixed>::min();
+        }
+        return DAMAGEFIXED_PRIVATE::FromInt(value);
+    }
+
+    DamageFixed DamageFixedFromFloat(float value) {
+        if (std::isnan(value)) {
+            return 0;
+        }
+
+        // Scaling by a power of two is exact in double, so the only rounding is the final one.
+        double scaled = static_cast<double>(value) * DAMAGEFIXED_ONE;
+        if (scaled >= static_cast<double>(std::numeric_limits<DamageFixed>::max())) {
+            return std::numeric_limits<DamageFixed>::max();
+        }
+        if (scaled <= static_cast<double>(std::numeric_limits<DamageFixed>::min())) {
+            return std::numeric_limits<DamageFixed>::min();
+        }
+        return static_cast<DamageFixed>(std::llround(scaled));
+    }
+
+    float DamageFixedToFloat(DamageFixed value) {
+        return static_cast<float>(static_cast<double>(value) / DAMAGEFIXED_ONE);
+    }
+
+    DamageFixed DamageFixedMultiply(DamageFixed a, DamageFixed b) { return DAMAGEFIXED_PRIVATE::Multiply(a, b); }
+    DamageFixed DamageFixedDivide(DamageFixed dividend, DamageFixed divisor) { return DAMAGEFIXED_PRIVATE::Divide(dividend, divisor); }
+    DamageFixed DamageFixedAdd(DamageFixed a, DamageFixed b) { return DAMAGEFIXED_PRIVATE::Add(a, b); }
+    DamageFixed DamageFixedSubtract(DamageFixed a, DamageFixed b) { return DAMAGEFIXED_PRIVATE::Subtract(a, b); }
+
+    long DamageFixedCeil(long long value) {
+        return static_cast<long>((value + (DAMAGEFIXED_ONE - 1)) >> DAMAGEFIXED_FRACTION_BITS);
+    }
+
+    DamageFixed DetermineDamageSourcePercentageFixed(DamageSourceValue val) {
+        if (val < 1) {
+            return 0;
+        }
+        if (val >= DAMAGESOURCE_MAXVALUE) {
+            return DAMAGEFIXED_ONE;
+        }
+        return static_cast<DamageFixed>((static_cast<std::int64_t>(val) * DAMAGEFIXED_ONE) / DAMAGESOURCE_MAXVALUE);
+    }
+
+    void EvaluateBindingDamageFixed(const DamageFixedConstants& constants, const DamageFixedInclination& inclination, const DamageFixedBindings& bindings, std::size_t count, DamageFixed* output) {
+        using namespace DAMAGEFIXED_PRIVATE;
+
+        for (std::size_t i = 0; i < count; i++) {
+            DamageFixed affinity = FromInt(bindings.affinities[i]);
+            DamageFixed resistance = FromInt(bindings.resistances[i]);
+
+            DamageFixed affinityReduced = Mingate(Subtract(affinity, Multiply(constants.residual, resistance)), 0);
+            DamageFixed multiplier = Mingate(Add(DAMAGEFIXED_ONE, Divide(Subtract(affinityReduced, resistance), constants.elementalThreshold)), 0);
+            DamageFixed multiplier_mingate = Mingate(Subtract(DAMAGEFIXED_ONE, Divide(constants.mingateThreshold, Add(constants.mingateThreshold, affinity))), 0);
+
+            // Same terms as the float formula, but multiplied largest first so the fractions lose as few bits as possible.
+            DamageFixed scaled = Multiply(inclination.elementalStatDamage, bindings.scalings[i]);
+            DamageFixed penetrating = Multiply(Multiply(Multiply(scaled, multiplier), inclination.penetratedDamageReduction), bindings.damageSourcePercentages[i]);
+            DamageFixed nonpenetrating = Multiply(Multiply(Multiply(Multiply(scaled, Mingate(multiplier, multiplier_mingate)), inclination.bonusScaling), inclination.damageReduction), bindings.damageSourcePercentages[i]);
+
+            output[i] = (bindings.penetrating[i] != 0) ? penetrating : nonpenetrating;
+        }
+    }
+}
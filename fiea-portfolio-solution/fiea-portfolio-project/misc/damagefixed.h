@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "../models/damageresistances.h"
+#include "../models/damagesource.h"
+#include "../models/elementalaffinities.h"
+
+namespace AWE {
+    /// <summary>
+    /// Signed Q16.16 fixed-point number used by the fixed-point damage mode. Every operation on it is plain integer arithmetic, so results are identical on every compiler and platform.
+    /// </summary>
+    typedef std::int32_t DamageFixed;
+
+    /// <summary>
+    /// Number of fractional bits in a DamageFixed.
+    /// </summary>
+    static const int DAMAGEFIXED_FRACTION_BITS = 16;
+    /// <summary>
+    /// 1.0 as a DamageFixed.
+    /// </summary>
+    static const DamageFixed DAMAGEFIXED_ONE = 1 << DAMAGEFIXED_FRACTION_BITS;
+
+    /// <returns>The given integer as a DamageFixed, saturated to the representable range.</returns>
+    DamageFixed DamageFixedFromInt(long long);
+    /// <returns>The given float rounded to the nearest DamageFixed, saturated to the representable range. Only meant for content and constants, never for intermediate values.</returns>
+    DamageFixed DamageFixedFromFloat(float);
+    /// <returns>The given DamageFixed as a float. Only meant for display, never for further calculation.</returns>
+    float DamageFixedToFloat(DamageFixed);
+    /// <returns>Sum of the two values, saturated.</returns>
+    DamageFixed DamageFixedAdd(DamageFixed, DamageFixed);
+    /// <returns>Difference of the two values, saturated.</returns>
+    DamageFixed DamageFixedSubtract(DamageFixed, DamageFixed);
+    /// <returns>Product of the two values, rounded towards negative infinity and saturated.</returns>
+    DamageFixed DamageFixedMultiply(DamageFixed, DamageFixed);
+    /// <returns>Quotient of the two values, rounded towards zero and saturated. Dividing by zero saturates in the direction of the dividend's sign, or returns 0 if the dividend is also 0.</returns>
+    DamageFixed DamageFixedDivide(DamageFixed dividend, DamageFixed divisor);
+    /// <returns>Smallest integer which is not less than the given value.</returns>
+    long DamageFixedCeil(long long);
+
+    /// <returns>Fixed-point counterpart of DetermineDamageSourcePercentage.</returns>
+    DamageFixed DetermineDamageSourcePercentageFixed(DamageSourceValue);
+
+    /// <summary>
+    /// Formula constants the fixed-point binding evaluation needs, already converted to DamageFixed.
+    /// </summary>
+    struct DamageFixedConstants {
+        DamageFixed residual;
+        DamageFixed elementalThreshold;
+        DamageFixed mingateThreshold;
+    };
+
+    /// <summary>
+    /// Fixed-point terms which are shared by every binding of one inclination.
+    /// </summary>
+    struct DamageFixedInclination {
+        DamageFixed damageReduction;
+        DamageFixed penetratedDamageReduction;
+        DamageFixed bonusScaling;
+        DamageFixed elementalStatDamage;
+    };
+
+    /// <summary>
+    /// Structure-of-arrays view of the bindings to evaluate in fixed point. Every array must hold at least as many entries as the count given.
+    /// </summary>
+    struct DamageFixedBindings {
+        const DamageFixed* scalings;
+        const ElementalAffinityValue* affinities;
+        const DamageResistanceValue* resistances;
+        const DamageFixed* damageSourcePercentages;
+        /// <summary>Nonzero for penetrating bindings.</summary>
+        const int* penetrating;
+    };
+
+    /// <summary>
+    /// Fixed-point counterpart of EvaluateBindingDamage. The loop only uses 32- and 64-bit integer operations and selects, with no branches on the data, so it can be vectorized with integer SIMD.
+    /// </summary>
+    /// <param name="count">Number of bindings to evaluate.</param>
+    /// <param name="output">Receives the damage of each binding. Must hold at least count entries.</param>
+    void EvaluateBindingDamageFixed(const DamageFixedConstants& constants, const DamageFixedInclination& inclination, const DamageFixedBindings& bindings, std::size_t count, DamageFixed* output);
+}
@@ -0,0 +1,183 @@
+#include "damagekernel.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define AWE_DAMAGEKERNEL_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC allows AVX2 intrinsics in any function, it's up to the caller to check the CPU first.
+#define AWE_DAMAGEKERNEL_TARGET_AVX2
+#else
+#define AWE_DAMAGEKERNEL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace AWE {
+    namespace DAMAGEKERNEL_PRIVATE {
+        float EvaluateScalar(const DamageKernelConstants& constants, const DamageKernelInclination& inclination, const DamageKernelBindings& bindings, std::size_t i) {
+            float affinity = static_cast<float>(bindings.affinities[i]);
+            float resistance = static_cast<float>(bindings.resistances[i]);
+
+            float affinityReduced = affinity - (constants.residual * resistance);
+            affinityReduced = (affinityReduced < 0.0f) ? 0.0f : affinityReduced;
+
+            float multiplier = 1.0f + ((affinityReduced - resistance) / constants.elementalThreshold);
+            multiplier = (multiplier < 0.0f) ? 0.0f : multiplier;
+
+            if (bindings.penetrating[i] != 0) {
+                return inclination.penetratedDamageReduction * bindings.scalings[i] * multiplier * inclination.elementalStatDamage * bindings.damageSourcePercentages[i];
+            }
+
+            float multiplier_mingate = 1.0f - (constants.mingateThreshold / (constants.mingateThreshold + affinity));
+            multiplier_mingate = (multiplier_mingate < 0.0f) ? 0.0f : multiplier_mingate;
+            multiplier = (multiplier < multiplier_mingate) ? multiplier_mingate : multiplier;
+
+            return inclination.damageReduction * bindings.scalings[i] * multiplier * inclination.bonusScaling * inclination.elementalStatDamage * bindings.damageSourcePercentages[i];
+        }
+
+        void EvaluateRangeScalar(const DamageKernelConstants& constants, const DamageKernelInclination& inclination, const DamageKernelBindings& bindings, std::size_t begin, std::size_t end, float* output) {
+            for (std::size_t i = begin; i < end; i++) {
+                output[i] = EvaluateScalar(constants, inclination, bindings, i);
+            }
+        }
+
+#ifdef AWE_DAMAGEKERNEL_X86
+        // mingate(value, min) == (value < min) ? min : value. _mm_max_ps is not used because it treats -0.f and NaN differently than the scalar comparison does.
+        inline __m128 Mingate128(__m128 value, __m128 min) {
+            __m128 less = _mm_cmplt_ps(value, min);
+            return _mm_or_ps(_mm_and_ps(less, min), _mm_andnot_ps(less, value));
+        }
+
+        void EvaluateSSE2(const DamageKernelConstants& constants, const DamageKernelInclination& inclination, const DamageKernelBindings& bindings, std::size_t count, float* output) {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 residual = _mm_set1_ps(constants.residual);
+            const __m128 threshold = _mm_set1_ps(constants.elementalThreshold);
+            const __m128 mingateThreshold = _mm_set1_ps(constants.mingateThreshold);
+            const __m128 damageReduction = _mm_set1_ps(inclination.damageReduction);
+            const __m128 penetratedDamageReduction = _mm_set1_ps(inclination.penetratedDamageReduction);
+            const __m128 bonusScaling = _mm_set1_ps(inclination.bonusScaling);
+            const __m128 elementalStatDamage = _mm_set1_ps(inclination.elementalStatDamage);
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m128 affinity = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bindings.affinities + i)));
+                __m128 resistance = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bindings.resistances + i)));
+                __m128 scaling = _mm_loadu_ps(bindings.scalings + i);
+                __m128 damageSourcePercentage = _mm_loadu_ps(bindings.damageSourcePercentages + i);
+                __m128 isNonpenetrating = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bindings.penetrating + i)), _mm_setzero_si128()));
+
+                __m128 affinityReduced = Mingate128(_mm_sub_ps(affinity, _mm_mul_ps(residual, resistance)), zero);
+                __m128 multiplier = Mingate128(_mm_add_ps(one, _mm_div_ps(_mm_sub_ps(affinityReduced, resistance), threshold)), zero);
+
+                __m128 penetrating = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(penetratedDamageReduction, scaling), multiplier), elementalStatDamage), damageSourcePercentage);
+
+                __m128 multiplier_mingate = Mingate128(_mm_sub_ps(one, _mm_div_ps(mingateThreshold, _mm_add_ps(mingateThreshold, affinity))), zero);
+                __m128 nonpenetrating = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(damageReduction, scaling), Mingate128(multiplier, multiplier_mingate)), bonusScaling), elementalStatDamage), damageSourcePercentage);
+
+                _mm_storeu_ps(output + i, _mm_or_ps(_mm_and_ps(isNonpenetrating, nonpenetrating), _mm_andnot_ps(isNonpenetrating, penetrating)));
+            }
+
+            EvaluateRangeScalar(constants, inclination, bindings, i, count, output);
+        }
+
+        AWE_DAMAGEKERNEL_TARGET_AVX2 inline __m256 Mingate256(__m256 value, __m256 min) {
+            return _mm256_blendv_ps(value, min, _mm256_cmp_ps(value, min, _CMP_LT_OS));
+        }
+
+        AWE_DAMAGEKERNEL_TARGET_AVX2 void EvaluateAVX2(const DamageKernelConstants& constants, const DamageKernelInclination& inclination, const DamageKernelBindings& bindings, std::size_t count, float* output) {
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 residual = _mm256_set1_ps(constants.residual);
+            const __m256 threshold = _mm256_set1_ps(constants.elementalThreshold);
+            const __m256 mingateThreshold = _mm256_set1_ps(constants.mingateThreshold);
+            const __m256 damageReduction = _mm256_set1_ps(inclination.damageReduction);
+            const __m256 penetratedDamageReduction = _mm256_set1_ps(inclination.penetratedDamageReduction);
+            const __m256 bonusScaling = _mm256_set1_ps(inclination.bonusScaling);
+            const __m256 elementalStatDamage = _mm256_set1_ps(inclination.elementalStatDamage);
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                __m256 affinity = _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bindings.affinities + i)));
+                __m256 resistance = _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bindings.resistances + i)));
+                __m256 scaling = _mm256_loadu_ps(bindings.scalings + i);
+                __m256 damageSourcePercentage = _mm256_loadu_ps(bindings.damageSourcePercentages + i);
+                __m256 isPenetrating = _mm256_castsi256_ps(_mm256_xor_si256(
+                    _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bindings.penetrating + i)), _mm256_setzero_si256()),
+                    _mm256_set1_epi32(-1)));
+
+                __m256 affinityReduced = Mingate256(_mm256_sub_ps(affinity, _mm256_mul_ps(residual, resistance)), zero);
+                __m256 multiplier = Mingate256(_mm256_add_ps(one, _mm256_div_ps(_mm256_sub_ps(affinityReduced, resistance), threshold)), zero);
+
+                __m256 penetrating = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(penetratedDamageReduction, scaling), multiplier), elementalStatDamage), damageSourcePercentage);
+
+                __m256 multiplier_mingate = Mingate256(_mm256_sub_ps(one, _mm256_div_ps(mingateThreshold, _mm256_add_ps(mingateThreshold, affinity))), zero);
+                __m256 nonpenetrating = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(damageReduction, scaling), Mingate256(multiplier, multiplier_mingate)), bonusScaling), elementalStatDamage), damageSourcePercentage);
+
+                _mm256_storeu_ps(output + i, _mm256_blendv_ps(nonpenetrating, penetrating, isPenetrating));
+            }
+
+            // Leftovers of four or more still get a vector pass.
+            if (i < count) {
+                EvaluateSSE2(constants, inclination, DamageKernelBindings {
+                    bindings.scalings + i, bindings.affinities + i, bindings.resistances + i, bindings.damageSourcePercentages + i, bindings.penetrating + i
+                }, count - i, output + i);
+            }
+        }
+
+        bool IsAVX2Supported() {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return false;
+            }
+
+            // The OS must also be saving the YMM registers on context switches.
+            __cpuid(info, 1);
+            bool hasOSXSAVE = (info[2] & (1 << 27)) != 0;
+            bool hasAVX = (info[2] & (1 << 28)) != 0;
+            if (!hasOSXSAVE || !hasAVX || (_xgetbv(0) & 0x6) != 0x6) {
+                return false;
+            }
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+    }
+
+    DamageKernelLevel DetectDamageKernelLevel() {
+#ifdef AWE_DAMAGEKERNEL_X86
+        // Every x86 target this project builds for has SSE2, so only AVX2 needs to be detected.
+        static const DamageKernelLevel detected = DAMAGEKERNEL_PRIVATE::IsAVX2Supported() ? DamageKernelLevel::AVX2 : DamageKernelLevel::SSE2;
+        return detected;
+#else
+        return DamageKernelLevel::SCALAR;
+#endif
+    }
+
+    void EvaluateBindingDamage(DamageKernelLevel level, const DamageKernelConstants& constants, const DamageKernelInclination& inclination, const DamageKernelBindings& bindings, std::size_t count, float* output) {
+        DamageKernelLevel supported = DetectDamageKernelLevel();
+        if (level > supported) {
+            level = supported;
+        }
+
+        switch (level) {
+#ifdef AWE_DAMAGEKERNEL_X86
+        case DamageKernelLevel::AVX2:
+            DAMAGEKERNEL_PRIVATE::EvaluateAVX2(constants, inclination, bindings, count, output);
+            break;
+        case DamageKernelLevel::SSE2:
+            DAMAGEKERNEL_PRIVATE::EvaluateSSE2(constants, inclination, bindings, count, output);
+            break;
+#endif
+        default:
+            DAMAGEKERNEL_PRIVATE::EvaluateRangeScalar(constants, inclination, bindings, 0, count, output);
+            break;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include "../models/damageresistances.h"
+#include "../models/elementalaffinities.h"
+
+namespace AWE {
+    /// <summary>
+    /// Enumerates the instruction sets the element binding kernel can run on. Each level can also run everything below it.
+    /// </summary>
+    enum class DamageKernelLevel : unsigned short {
+        SCALAR,
+        SSE2,
+        AVX2
+    };
+
+    /// <summary>
+    /// Formula constants the kernel needs, already converted to float.
+    /// </summary>
+    struct DamageKernelConstants {
+        /// <summary>DamageCalculator::RESIDUAL_CONSTANT.</summary>
+        float residual;
+        /// <summary>DamageCalculator::ELEM_THRESHOLD_CONSTANT.</summary>
+        float elementalThreshold;
+        /// <summary>DamageCalculator::ELEMTHRESH_MULTIP_CONSTANT * DamageCalculator::ELEM_THRESHOLD_CONSTANT.</summary>
+        float mingateThreshold;
+    };
+
+    /// <summary>
+    /// Terms which are shared by every binding of one inclination.
+    /// </summary>
+    struct DamageKernelInclination {
+        float damageReduction;
+        float penetratedDamageReduction;
+        float bonusScaling;
+        float elementalStatDamage;
+    };
+
+    /// <summary>
+    /// Structure-of-arrays view of the bindings to evaluate. Every array must hold at least as many entries as the count given to the kernel.
+    /// </summary>
+    struct DamageKernelBindings {
+        const float* scalings;
+        const ElementalAffinityValue* affinities;
+        const DamageResistanceValue* resistances;
+        const float* damageSourcePercentages;
+        /// <summary>Nonzero for penetrating bindings.</summary>
+        const int* penetrating;
+    };
+
+    /// <summary>
+    /// Maximum number of bindings which callers should gather before invoking the kernel. Matches the widest vector the kernel uses.
+    /// </summary>
+    static const std::size_t DAMAGEKERNEL_WIDTH = 8;
+
+    /// <returns>The highest kernel level both this build and the running CPU support.</returns>
+    DamageKernelLevel DetectDamageKernelLevel();
+
+    /// <summary>
+    /// Evaluates the damage dealt by each given binding. Results are bit-identical at every level: the vector paths compute both the penetrating and the nonpenetrating
+    /// result for every lane and blend them with a mask, using the exact operation order of the scalar path.
+    /// </summary>
+    /// <param name="level">Kernel to use. Levels the build or CPU does not support fall back to the next lower one.</param>
+    /// <param name="count">Number of bindings to evaluate.</param>
+    /// <param name="output">Receives the damage of each binding. Must hold at least count entries.</param>
+    void EvaluateBindingDamage(DamageKernelLevel level, const DamageKernelConstants& constants, const DamageKernelInclination& inclination, const DamageKernelBindings& bindings, std::size_t count, float* output);
+}
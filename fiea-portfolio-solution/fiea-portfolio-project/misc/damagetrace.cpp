@@ -0,0 +1,169 @@
+#include "damagetrace.h"
+#include <cstdint>
+
+namespace AWE {
+    namespace DAMAGETRACE_PRIVATE {
+        // Keys are ABRVs packed into a long, first letter in the lowest byte.
+        void WriteKey(std::ostream& out, ABRV_long key) {
+            for (int i = 0; i < 4; i++) {
+                char letter = static_cast<char>((key >> (8 * i)) & 0xFF);
+                out << (letter == 0 ? '_' : letter);
+            }
+        }
+
+        template <typename T> void WriteBinary(std::ostream& out, T value) {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void WriteBinaryString(std::ostream& out, const std::string& value) {
+            std::uint16_t length = static_cast<std::uint16_t>(value.size() > 0xFFFF ? 0xFFFF : value.size());
+            WriteBinary(out, length);
+            out.write(value.data(), length);
+        }
+    }
+
+    /* DamageTraceBuffer */
+
+    DamageTraceBuffer::DamageTraceBuffer(std::size_t calculationCapacity, std::size_t inclinationCapacity, std::size_t bindingCapacity) : _overflowed(false), _isCalculationOpen(false) {
+        _calculations.reserve(calculationCapacity);
+        _inclinations.reserve(inclinationCapacity);
+        _bindings.reserve(bindingCapacity);
+    }
+
+    const unsigned int DamageTraceBuffer::BINARY_VERSION = 1;
+
+    const std::vector<DamageTraceCalculation>& DamageTraceBuffer::calculations() const { return _calculations; }
+    const std::vector<DamageTraceInclination>& DamageTraceBuffer::inclinations() const { return _inclinations; }
+    const std::vector<DamageTraceBinding>& DamageTraceBuffer::bindings() const { return _bindings; }
+    bool DamageTraceBuffer::overflowed() const { return _overflowed; }
+
+    void DamageTraceBuffer::BeginCalculation(const Skill& skill, const BattlerInstance& attacker, const BattlerInstance& defender) {
+        _isCalculationOpen = _calculations.size() < _calculations.capacity();
+        if (!_isCalculationOpen) {
+            _overflowed = true;
+            return;
+        }
+
+        _calculations.push_back({ &skill, &attacker, &defender, 0, _inclinations.size(), 0, _bindings.size(), 0 });
+    }
+
+    void DamageTraceBuffer::RecordInclination(const DamageTraceInclination& inclination) {
+        if (_inclinations.size() == _inclinations.capacity()) {
+            _overflowed = true;
+            return;
+        }
+
+        _inclinations.push_back(inclination);
+    }
+
+    void DamageTraceBuffer::RecordBinding(const DamageTraceBinding& binding) {
+        if (_bindings.size() == _bindings.capacity()) {
+            _overflowed = true;
+            return;
+        }
+
+        _bindings.push_back(binding);
+    }
+
+    void DamageTraceBuffer::EndCalculation(long final) {
+        // If the calculation itself was dropped, its inclinations and bindings are still in the arrays, but no calculation points at them.
+        if (!_isCalculationOpen) {
+            return;
+        }
+        _isCalculationOpen = false;
+
+        DamageTraceCalculation& calculation = _calculations.back();
+        calculation.final = final;
+        calculation.inclinationsCount = _inclinations.size() - calculation.inclinationsBegin;
+        calculation.bindingsCount = _bindings.size() - calculation.bindingsBegin;
+    }
+
+    void DamageTraceBuffer::Clear() {
+        _calculations.clear();
+        _inclinations.clear();
+        _bindings.clear();
+        _overflowed = false;
+        _isCalculationOpen = false;
+    }
+
+    void DamageTraceBuffer::DumpText(std::ostream& out) const {
+        using DAMAGETRACE_PRIVATE::WriteKey;
+
+        for (const DamageTraceCalculation& calculation : _calculations) {
+            out << "C " << calculation.skill->name() << " | " << calculation.attacker->name() << " > " << calculation.defender->name() << " = " << calculation.final << '\n';
+
+            for (std::size_t i = calculation.inclinationsBegin; i < calculation.inclinationsBegin + calculation.inclinationsCount; i++) {
+                const DamageTraceInclination& inclination = _inclinations[i];
+                out << " I " << inclination.component << ' ';
+                WriteKey(out, inclination.inclination);
+                out << " atk " << inclination.attackingStatTotal << " def " << inclination.defendingStatTotal << " res " << inclination.defendingResistTotal
+                    << " drs " << inclination.damageReduction_stats << " drr " << inclination.damageReduction_resists << " drm " << inclination.damageReduction_resists_min
+                    << " dr " << inclination.damageReduction << " pdr " << inclination.penetratedDamageReduction << " bon " << inclination.bonusScaling
+                    << " esd " << inclination.elementalStatDamage << '\n';
+            }
+
+            for (std::size_t i = calculation.bindingsBegin; i < calculation.bindingsBegin + calculation.bindingsCount; i++) {
+                const DamageTraceBinding& binding = _bindings[i];
+                out << "  B " << binding.component << ' ';
+                WriteKey(out, binding.damageType);
+                out << ' ';
+                WriteKey(out, binding.inclination);
+                out << (binding.isPenetrating ? " pen" : " non") << " sc " << binding.scaling << " aff " << binding.affinity << " res " << binding.resistance
+                    << " src " << binding.damageSourcePercentage << " afr " << binding.affinityReduced << " mul " << binding.multiplier
+                    << " mmg " << binding.multiplier_mingate << " dmg " << binding.damage << '\n';
+            }
+        }
+    }
+
+    void DamageTraceBuffer::DumpBinary(std::ostream& out) const {
+        using DAMAGETRACE_PRIVATE::WriteBinary;
+        using DAMAGETRACE_PRIVATE::WriteBinaryString;
+
+        out.write("AWDT", 4);
+        WriteBinary<std::uint32_t>(out, BINARY_VERSION);
+        WriteBinary<std::uint32_t>(out, static_cast<std::uint32_t>(_calculations.size()));
+        WriteBinary<std::uint32_t>(out, static_cast<std::uint32_t>(_inclinations.size()));
+        WriteBinary<std::uint32_t>(out, static_cast<std::uint32_t>(_bindings.size()));
+
+        for (const DamageTraceCalculation& calculation : _calculations) {
+            WriteBinaryString(out, calculation.skill->name());
+            WriteBinaryString(out, calculation.attacker->name());
+            WriteBinaryString(out, calculation.defender->name());
+            WriteBinary<std::int32_t>(out, calculation.final);
+            WriteBinary<std::uint32_t>(out, static_cast<std::uint32_t>(calculation.inclinationsBegin));
+            WriteBinary<std::uint32_t>(out, static_cast<std::uint32_t>(calculation.inclinationsCount));
+            WriteBinary<std::uint32_t>(out, static_cast<std::uint32_t>(calculation.bindingsBegin));
+            WriteBinary<std::uint32_t>(out, static_cast<std::uint32_t>(calculation.bindingsCount));
+        }
+
+        for (const DamageTraceInclination& inclination : _inclinations) {
+            WriteBinary<std::uint16_t>(out, inclination.component);
+            WriteBinary<std::uint32_t>(out, static_cast<std::uint32_t>(inclination.inclination));
+            WriteBinary<std::uint32_t>(out, static_cast<std::uint32_t>(inclination.attackingStatTotal));
+            WriteBinary<std::uint32_t>(out, static_cast<std::uint32_t>(inclination.defendingStatTotal));
+            WriteBinary<std::int32_t>(out, static_cast<std::int32_t>(inclination.defendingResistTotal));
+            WriteBinary(out, inclination.damageReduction_stats);
+            WriteBinary(out, inclination.damageReduction_resists);
+            WriteBinary(out, inclination.damageReduction_resists_min);
+            WriteBinary(out, inclination.damageReduction);
+            WriteBinary(out, inclination.penetratedDamageReduction);
+            WriteBinary(out, inclination.bonusScaling);
+            WriteBinary(out, inclination.elementalStatDamage);
+        }
+
+        for (const DamageTraceBinding& binding : _bindings) {
+            WriteBinary<std::uint16_t>(out, binding.component);
+            WriteBinary<std::uint32_t>(out, static_cast<std::uint32_t>(binding.damageType));
+            WriteBinary<std::uint32_t>(out, static_cast<std::uint32_t>(binding.inclination));
+            WriteBinary<std::uint8_t>(out, binding.isPenetrating ? 1 : 0);
+            WriteBinary(out, binding.scaling);
+            WriteBinary<std::int32_t>(out, binding.affinity);
+            WriteBinary<std::int32_t>(out, binding.resistance);
+            WriteBinary(out, binding.damageSourcePercentage);
+            WriteBinary(out, binding.affinityReduced);
+            WriteBinary(out, binding.multiplier);
+            WriteBinary(out, binding.multiplier_mingate);
+            WriteBinary(out, binding.damage);
+        }
+    }
+}
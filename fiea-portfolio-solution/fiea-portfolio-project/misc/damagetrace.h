@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include <vector>
+#include "../models/battler.h"
+#include "../models/skill.h"
+
+namespace AWE {
+    /// <summary>
+    /// Every intermediate term of one inclination of one damage component.
+    /// </summary>
+    struct DamageTraceInclination {
+        unsigned short component;
+        DamageInclinationKey inclination;
+        unsigned long attackingStatTotal;
+        unsigned long defendingStatTotal;
+        long defendingResistTotal;
+        float damageReduction_stats;
+        float damageReduction_resists;
+        float damageReduction_resists_min;
+        float damageReduction;
+        float penetratedDamageReduction;
+        float bonusScaling;
+        float elementalStatDamage;
+    };
+
+    /// <summary>
+    /// Every intermediate term of one element binding, along with the damage it contributed.
+    /// </summary>
+    struct DamageTraceBinding {
+        unsigned short component;
+        DamageTypeKey damageType;
+        DamageInclinationKey inclination;
+        bool isPenetrating;
+        float scaling;
+        ElementalAffinityValue affinity;
+        DamageResistanceValue resistance;
+        float damageSourcePercentage;
+        float affinityReduced;
+        float multiplier;
+        /// <summary>Always 0 for penetrating bindings, which do not use it.</summary>
+        float multiplier_mingate;
+        float damage;
+    };
+
+    /// <summary>
+    /// One traced call to CalculateDamage, along with where its inclinations and bindings are in the trace.
+    /// </summary>
+    struct DamageTraceCalculation {
+        const Skill* skill;
+        const BattlerInstance* attacker;
+        const BattlerInstance* defender;
+        long final;
+        std::size_t inclinationsBegin;
+        std::size_t inclinationsCount;
+        std::size_t bindingsBegin;
+        std::size_t bindingsCount;
+    };
+
+    /// <summary>
+    /// Trace sink which records nothing. The damage calculator checks ENABLED at compile time, so calculations using this sink compile to the same code as untraced ones.
+    /// </summary>
+    struct DamageTraceNull {
+        static constexpr bool ENABLED = false;
+
+        void BeginCalculation(const Skill&, const BattlerInstance&, const BattlerInstance&) {}
+        void RecordInclination(const DamageTraceInclination&) {}
+        void RecordBinding(const DamageTraceBinding&) {}
+        void EndCalculation(long) {}
+    };
+
+    /// <summary>
+    /// Trace sink which records into arrays allocated up front. Recording never allocates: once an array is full, further records are dropped and overflowed() becomes true.
+    /// Skills and battler instances are recorded by address, so they must still be alive when the trace is dumped.
+    /// </summary>
+    class DamageTraceBuffer {
+    private:
+        std::vector<DamageTraceCalculation> _calculations;
+        std::vector<DamageTraceInclination> _inclinations;
+        std::vector<DamageTraceBinding> _bindings;
+        bool _overflowed;
+        bool _isCalculationOpen;
+
+    public:
+        static constexpr bool ENABLED = true;
+
+        /// <param name="calculationCapacity">Maximum number of calculations to record.</param>
+        /// <param name="inclinationCapacity">Maximum number of inclinations to record, across all calculations.</param>
+        /// <param name="bindingCapacity">Maximum number of bindings to record, across all calculations.</param>
+        DamageTraceBuffer(std::size_t calculationCapacity, std::size_t inclinationCapacity, std::size_t bindingCapacity);
+
+        /// <returns>const reference to the recorded calculations.</returns>
+        const std::vector<DamageTraceCalculation>& calculations() const;
+        /// <returns>const reference to the recorded inclinations of every calculation.</returns>
+        const std::vector<DamageTraceInclination>& inclinations() const;
+        /// <returns>const reference to the recorded bindings of every calculation.</returns>
+        const std::vector<DamageTraceBinding>& bindings() const;
+        /// <returns>true if anything was dropped because the buffer was full.</returns>
+        bool overflowed() const;
+
+        void BeginCalculation(const Skill&, const BattlerInstance& attacker, const BattlerInstance& defender);
+        void RecordInclination(const DamageTraceInclination&);
+        void RecordBinding(const DamageTraceBinding&);
+        void EndCalculation(long final);
+
+        /// <summary>
+        /// Discards everything recorded. Capacity is kept.
+        /// </summary>
+        void Clear();
+
+        /// <summary>
+        /// Writes the trace as text, one line per record. Calculation lines start with "C", inclination lines with " I", and binding lines with "  B".
+        /// </summary>
+        void DumpText(std::ostream&) const;
+        /// <summary>
+        /// Writes the trace in a compact binary form: the 4 bytes "AWDT", a 32-bit format version, then the record counts followed by the records themselves, in native byte order.
+        /// Calculations are written with the names of their skill and battlers in place of the pointers, each as a 16-bit length followed by the characters.
+        /// </summary>
+        void DumpBinary(std::ostream&) const;
+
+        /// <summary>Version written by DumpBinary.</summary>
+        static const unsigned int BINARY_VERSION;
+    };
+}
@@ -105,5 +105,5 @@ namespace AWE {
     /// <summary>
     /// Four-letter symbol which is at the end of every file to indicate completion. Should be at the beginning of a new line by itself. Its absence will result in a load error.
     /// </summary>
-    static ABRV const LOAD_FILE_END_ABRV = ABRV('<', '@', '!', '>');
+    constexpr ABRV LOAD_FILE_END_ABRV = ABRV('<', '@', '!', '>');
 }
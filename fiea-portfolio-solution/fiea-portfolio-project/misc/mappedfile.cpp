@@ -0,0 +1,112 @@
+#include "mappedfile.h"
+#include <cstdint>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AWE {
+    MappedFile::MappedFile() : _data(nullptr), _size(0), _file(nullptr), _mapping(nullptr) {}
+    MappedFile::~MappedFile() { Close(); }
+
+    const unsigned char* MappedFile::data() const { return _data; }
+    std::size_t MappedFile::size() const { return _size; }
+    bool MappedFile::isOpen() const { return _data != nullptr; }
+
+#if defined(_WIN32)
+    bool MappedFile::Open(const std::string& filename) {
+        Close();
+
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 || static_cast<unsigned long long>(size.QuadPart) > SIZE_MAX) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            return false;
+        }
+
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        _data = static_cast<const unsigned char*>(view);
+        _size = static_cast<std::size_t>(size.QuadPart);
+        _file = file;
+        _mapping = mapping;
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (_data) {
+            UnmapViewOfFile(_data);
+        }
+        if (_mapping) {
+            CloseHandle(static_cast<HANDLE>(_mapping));
+        }
+        if (_file) {
+            CloseHandle(static_cast<HANDLE>(_file));
+        }
+
+        _data = nullptr;
+        _size = 0;
+        _file = nullptr;
+        _mapping = nullptr;
+    }
+#else
+    bool MappedFile::Open(const std::string& filename) {
+        Close();
+
+        int file = open(filename.c_str(), O_RDONLY);
+        if (file < 0) {
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(file, &info) != 0 || info.st_size <= 0) {
+            close(file);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        // The mapping keeps its own reference to the file.
+        close(file);
+        if (view == MAP_FAILED) {
+            return false;
+        }
+
+        _data = static_cast<const unsigned char*>(view);
+        _size = static_cast<std::size_t>(info.st_size);
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (_data) {
+            munmap(const_cast<unsigned char*>(_data), _size);
+        }
+
+        _data = nullptr;
+        _size = 0;
+        _file = nullptr;
+        _mapping = nullptr;
+    }
+#endif
+}
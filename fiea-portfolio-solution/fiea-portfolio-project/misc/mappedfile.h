@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace AWE {
+    /// <summary>
+    /// A whole file mapped read-only into memory. The operating system pages the file in as it is read, so opening even a large file costs next to nothing,
+    /// and nothing is copied out of it unless the reader copies it.
+    /// </summary>
+    class MappedFile {
+    private:
+        const unsigned char* _data;
+        std::size_t _size;
+        /// <summary>
+        /// Handles of the open file and its mapping. Only the first is used outside of Windows.
+        /// </summary>
+        void* _file;
+        void* _mapping;
+
+    public:
+        /// <summary>
+        /// Default constructor. Nothing is mapped.
+        /// </summary>
+        MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        /// <returns>const pointer to the first byte of the file, or nullptr if nothing is mapped.</returns>
+        const unsigned char* data() const;
+        /// <returns>Size of the file in bytes, or 0 if nothing is mapped.</returns>
+        std::size_t size() const;
+        /// <returns>Is a file mapped?</returns>
+        bool isOpen() const;
+
+        /// <summary>
+        /// Maps the given file, closing the file mapped before, if any. Empty files cannot be mapped.
+        /// </summary>
+        /// <returns>Whether the file was mapped.</returns>
+        bool Open(const std::string& filename);
+        /// <summary>
+        /// Unmaps the file. Every pointer into it becomes invalid.
+        /// </summary>
+        void Close();
+    };
+}
@@ -0,0 +1,72 @@
+#include "textformatter.h"
+#include <algorithm>
+#include <charconv>
+
+namespace AWE {
+
+    /* TextFormatter */
+
+    TextFormatter::TextFormatter(std::span<char> buffer) : _begin(buffer.data()), _end(buffer.data() + buffer.size()), _cursor(buffer.data()), _truncated(false) {}
+
+    std::string_view TextFormatter::view() const { return std::string_view(_begin, _cursor - _begin); }
+    std::size_t TextFormatter::size() const { return _cursor - _begin; }
+    std::size_t TextFormatter::capacity() const { return _end - _begin; }
+    bool TextFormatter::truncated() const { return _truncated; }
+
+    void TextFormatter::Clear() {
+        _cursor = _begin;
+        _truncated = false;
+    }
+
+    TextFormatter& TextFormatter::Append(char c) {
+        if (_cursor == _end) {
+            _truncated = true;
+            return *this;
+        }
+
+        *_cursor++ = c;
+        return *this;
+    }
+
+    TextFormatter& TextFormatter::Append(std::string_view str) {
+        std::size_t count = std::min<std::size_t>(str.size(), _end - _cursor);
+        _cursor = std::copy_n(str.data(), count, _cursor);
+        _truncated = _truncated || count < str.size();
+        return *this;
+    }
+
+    TextFormatter& TextFormatter::Append(char c, std::size_t count) {
+        std::size_t fits = std::min<std::size_t>(count, _end - _cursor);
+        _cursor = std::fill_n(_cursor, fits, c);
+        _truncated = _truncated || fits < count;
+        return *this;
+    }
+
+    TextFormatter& TextFormatter::AppendABRV(const AbbreviatedKey& key) {
+        std::span<const char, ABRV::SIZE> abrv = key.abrvspan();
+        return Append(std::string_view(abrv.data(), abrv.size()));
+    }
+
+    TextFormatter& TextFormatter::AppendInteger(long long value) {
+        // Numbers are never cut in half. If one does not fit, none of it is written.
+        std::to_chars_result result = std::to_chars(_cursor, _end, value);
+        if (result.ec != std::errc()) {
+            _truncated = true;
+            return *this;
+        }
+
+        _cursor = result.ptr;
+        return *this;
+    }
+
+    TextFormatter& TextFormatter::AppendFloat(float value, int precision) {
+        std::to_chars_result result = std::to_chars(_cursor, _end, value, std::chars_format::fixed, precision);
+        if (result.ec != std::errc()) {
+            _truncated = true;
+            return *this;
+        }
+
+        _cursor = result.ptr;
+        return *this;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include "../abrv/abbreviatedkey.h"
+
+namespace AWE {
+    /// <summary>
+    /// Writes text into a buffer owned by the caller, without ever allocating. Numbers are written with std::to_chars, and ABRVs are copied straight out of their keys.
+    /// Text which does not fit is cut off, and truncated() becomes true. The buffer must outlive the formatter and anything holding its view.
+    /// Meant to be kept around and cleared between uses, e.g. for damage popups or battle log lines.
+    /// </summary>
+    class TextFormatter {
+    private:
+        char* _begin;
+        char* _end;
+        char* _cursor;
+        bool _truncated;
+
+    public:
+        TextFormatter(std::span<char> buffer);
+
+        /// <returns>View of everything written so far. Invalidated by Clear.</returns>
+        std::string_view view() const;
+        /// <returns>Number of characters written so far.</returns>
+        std::size_t size() const;
+        /// <returns>Number of characters the buffer can hold.</returns>
+        std::size_t capacity() const;
+        /// <returns>true if anything was cut off because the buffer was full.</returns>
+        bool truncated() const;
+
+        /// <summary>
+        /// Discards everything written, keeping the buffer.
+        /// </summary>
+        void Clear();
+
+        TextFormatter& Append(char);
+        TextFormatter& Append(std::string_view);
+        /// <summary>
+        /// Appends the given character the given number of times. Useful for padding columns.
+        /// </summary>
+        TextFormatter& Append(char, std::size_t count);
+        /// <summary>
+        /// Appends the four letters of the key's ABRV.
+        /// </summary>
+        TextFormatter& AppendABRV(const AbbreviatedKey&);
+        TextFormatter& AppendInteger(long long);
+        /// <param name="precision">Number of digits after the decimal point.</param>
+        TextFormatter& AppendFloat(float, int precision);
+    };
+}
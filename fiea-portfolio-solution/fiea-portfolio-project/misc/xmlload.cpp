@@ -40,8 +40,7 @@ namespace AWE {
 
         LoadDataVisitor::LoadDataVisitor(const GameLOVStorage& store, DamageInclination_shptr nullBaseDamageInclination)
             : XMLVisitor()
-            , _inSettings(false)
-            , _isFailed(false)
+            , _symbols(nullptr)
             , _skills(nullptr)
             , _equipment(nullptr)
             , _battlers(nullptr)
@@ -50,13 +49,16 @@ namespace AWE {
             , _inclinationDefendingStats(nullptr)
             , _lov(&store)
             , _nullBaseDamageInclination(std::move(nullBaseDamageInclination))
-            , _currentBattlerPriority(0)
+            , _isFailed(false)
+            , _inSettings(false)
             , _currentSkillTextureIndex(0)
+            , _isCurrentBattlerCharacter(false)
+            , _currentBattlerPriority(0)
             , _currentBattlerTextureIndex(0)
-            , _currentBattlerTextureType(0)
-            , _isCurrentBattlerCharacter(false) {}
+            , _currentBattlerTextureType(0) {}
 
         LoadDataVisitor::LoadDataVisitor(
+            SymbolTable* symbols,
             SkillMap* skillMap,
             EquipmentMap* equipmentMap,
             BattlerMap* battlerMap,
@@ -66,8 +68,7 @@ namespace AWE {
             const GameLOVStorage& store,
             DamageInclination_shptr nullBaseDamageInclination
         ) : XMLVisitor()
-            , _inSettings(false)
-            , _isFailed(false)
+            , _symbols(std::move(symbols))
             , _skills(std::move(skillMap))
             , _equipment(std::move(equipmentMap))
             , _battlers(std::move(battlerMap))
@@ -76,11 +77,13 @@ namespace AWE {
             , _inclinationDefendingStats(std::move(inclinationDefendingStats))
             , _lov(&store)
             , _nullBaseDamageInclination(std::move(nullBaseDamageInclination))
-            , _currentBattlerPriority(0)
+            , _isFailed(false)
+            , _inSettings(false)
             , _currentSkillTextureIndex(0)
+            , _isCurrentBattlerCharacter(false)
+            , _currentBattlerPriority(0)
             , _currentBattlerTextureIndex(0)
-            , _currentBattlerTextureType(0)
-            , _isCurrentBattlerCharacter(false) {}
+            , _currentBattlerTextureType(0) {}
 
         void LoadDataVisitor::LogToCout(const std::string& message) const {
             std::cout << "LoadDataVisitor ==> " << message << "\n";
@@ -712,7 +715,7 @@ namespace AWE {
             }
 
             std::string equipname(attr->Value());
-            auto found = _equipment->find(equipname);
+            auto found = _equipment->find(_symbols->Find(equipname));
             if (found == _equipment->end()) {
                 LogToCout(equipname + " is not a valid equipment. (Perhaps it hasn't been loaded yet?)");
                 return false;
@@ -766,7 +769,7 @@ namespace AWE {
                 return false;
             }
 
-            _skills->insert(std::make_pair(_currentSkillName, Skill_shptr(_currentDamages
+            _skills->insert(std::make_pair(_symbols->Intern(_currentSkillName), Skill_shptr(_currentDamages
                 ? new Skill(_currentSkillName, *_currentDamages, _currentSkillTextureIndex, _currentSkillSoundFilename)
                 : new Skill(_currentSkillName, _currentSkillTextureIndex, _currentSkillSoundFilename))));
 
@@ -829,9 +832,9 @@ namespace AWE {
                 _currentStats = std::make_unique<BattlerStatValues>(BattlerStatValues());
             }
 
-            DamageResistances _;
-            DamageSourceMap fullDamageSources = CreateFullDamageSources(_lov->damageInclinations(), _lov->damageTypes());
-            _equipment->insert(std::make_pair(_currentEquipmentName, std::make_shared<Equipment>(Equipment(
+            DamageResistances _(_lov->damageTypeIndices(), _lov->damageInclinationIndices());
+            DamageSourceMatrix fullDamageSources = CreateFullDamageSources(_lov->damageInclinationIndices(), _lov->damageTypeIndices());
+            _equipment->insert(std::make_pair(_symbols->Intern(_currentEquipmentName), std::make_shared<Equipment>(Equipment(
                 _currentEquipmentName,
                 _,
                 fullDamageSources,
@@ -861,19 +864,21 @@ namespace AWE {
                 _currentStats = std::make_unique<BattlerStatValues>(BattlerStatValues());
             }
 
-            DamageResistances _;
-            DamageSourceMap fullDamageSources = CreateFullDamageSources(_lov->damageInclinations(), _lov->damageTypes());
-            ElementalAffinities __;
-            _battlers->insert(std::make_pair(_currentBattlerName, std::make_shared<Battler>(Battler(
+            BattlerStatBlock stats(_lov->battlerStatIndices(), *_currentStats);
+            DamageResistances _(_lov->damageTypeIndices(), _lov->damageInclinationIndices());
+            DamageSourceMatrix fullDamageSources = CreateFullDamageSources(_lov->damageInclinationIndices(), _lov->damageTypeIndices());
+            ElementalAffinities __(_lov->skillElementIndices(), _lov->damageTypeIndices(), _lov->skillElementGroupIndices());
+            _battlers->insert(std::make_pair(_symbols->Intern(_currentBattlerName), std::make_shared<const Battler>(Battler(
                 _currentBattlerName,
                 _isCurrentBattlerCharacter,
                 _currentBattlerPriority,
                 _currentBattlerTextureIndex,
                 _currentBattlerTextureType,
-                *_currentStats,
+                stats,
                 _,
                 fullDamageSources,
                 __,
+                *_defaultEquipmentSchema,
                 _currentStartingEquipment
             ))));
 
@@ -889,6 +894,9 @@ namespace AWE {
         }
 
         bool LoadDataVisitor::VisitEnter(const XMLDocument& doc) {
+            if (_symbols == nullptr) {
+                _symbols = &_mySymbols;
+            }
             if (_skills == nullptr) {
                 _skills = &_mySkills;
             }
@@ -972,6 +980,7 @@ namespace AWE {
 
         bool LoadDataVisitor::isFailed() const { return _isFailed; }
 
+        const SymbolTable& LoadDataVisitor::mySymbols() const { return _mySymbols; }
         const SkillMap& LoadDataVisitor::mySkills() const { return _mySkills; }
         const EquipmentMap& LoadDataVisitor::myEquipment() const { return _myEquipment; }
         const BattlerMap& LoadDataVisitor::myBattlers() const { return _myBattlers; }
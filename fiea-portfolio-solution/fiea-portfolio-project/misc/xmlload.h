@@ -31,6 +31,7 @@ namespace AWE {
              * These may simply be the "_my" fields defined below, OR they could be collections outside
              * this visitor entirely. Which is determined by the constructor used.
              */
+            SymbolTable* _symbols;
             SkillMap* _skills;
             EquipmentMap* _equipment;
             BattlerMap* _battlers;
@@ -44,6 +45,7 @@ namespace AWE {
              * external destination is given, the pointers will automatically point to these internal
              * collections.
              */
+            SymbolTable _mySymbols;
             SkillMap _mySkills;
             EquipmentMap _myEquipment;
             BattlerMap _myBattlers;
@@ -163,7 +165,7 @@ namespace AWE {
             /// Constructor. Allows the collection destinations to be externalized.
             /// Uses the LOV storage for lookup of ABRV values, and the damage inclination will be the "null damage inclination".
             /// </summary>
-            LoadDataVisitor(SkillMap*, EquipmentMap*, BattlerMap*, EquipmentTypeCountMap*, DamageInclinationStatListMap* atk, DamageInclinationStatListMap* def, const GameLOVStorage&, DamageInclination_shptr);
+            LoadDataVisitor(SymbolTable*, SkillMap*, EquipmentMap*, BattlerMap*, EquipmentTypeCountMap*, DamageInclinationStatListMap* atk, DamageInclinationStatListMap* def, const GameLOVStorage&, DamageInclination_shptr);
 
             /// <summary>
             /// Enters a XML document.
@@ -181,6 +183,8 @@ namespace AWE {
             /// <returns>Did the load fail?</returns>
             bool isFailed() const;
 
+            /// <returns>const reference to the internal symbol table. Note this may not be the table which interned the loaded names.</returns>
+            const SymbolTable& mySymbols() const;
             /// <returns>const reference to the internal skill map. Note this may not be the collection which was populated by the load.</returns>
             const SkillMap& mySkills() const;
             /// <returns>const reference to the internal equipment map. Note this may not be the collection which was populated by the load.</returns>
@@ -7,9 +7,9 @@ namespace AWE {
         unsigned short priority,
         unsigned int textureIndex,
         unsigned int textureType,
-        BattlerStatValues& stats,
+        BattlerStatBlock& stats,
         DamageResistances& resists,
-        DamageSourceMap& innateDamageSources,
+        DamageSourceMatrix& innateDamageSources,
         ElementalAffinities& affinities,
         EquipmentSlots& startingEquipment
     )   : _name(std::move(name))
@@ -28,10 +28,11 @@ namespace AWE {
         unsigned short priority,
         unsigned int textureIndex,
         unsigned int textureType,
-        BattlerStatValues& stats,
+        BattlerStatBlock& stats,
         DamageResistances& resists,
-        DamageSourceMap& innateDamageSources,
+        DamageSourceMatrix& innateDamageSources,
         ElementalAffinities& affinities,
+        const EquipmentTypeCountMap& schema,
         const EquipmentList& startingEquipment
     )       : _name(std::move(name))
             , _isCharacter(isCharacter)
@@ -42,7 +43,8 @@ namespace AWE {
             , _resistances(std::move(resists))
             , _innateDamageSources(std::move(innateDamageSources))
             , _affinities(std::move(affinities)) 
-            , _currentEquipment(std::move(EquipmentSlots())) {
+            , _currentEquipment(schema) {
+        // Equipment beyond the schema's slots still gets a slot of its own, the same as a battler with no schema.
         for (const Equipment_shptr& equipment : startingEquipment) {
             _currentEquipment.ForceEquip(equipment);
         }
@@ -56,89 +58,204 @@ namespace AWE {
     const DamageResistances& Battler::resistances() const { return _resistances; }
     const ElementalAffinities& Battler::affinities() const { return _affinities; }
     const EquipmentSlots& Battler::currentEquipment() const { return _currentEquipment; }
+    const BattlerStatBlock& Battler::stats() const { return _stats; }
 
-    BattlerStatValue Battler::GetStat(BattlerStatKey key) const { return _stats.contains(key) ? _stats.at(key) : 0; }
+    BattlerStatValue Battler::GetStat(BattlerStatKey key) const { return _stats.GetValue(key); }
+    BattlerStatValue Battler::GetStat(LOVIndex index) const { return _stats.GetValue(index); }
     DamageSourceValue Battler::GetInnateDamageSource(DamageTypeKey dmgtype, DamageInclinationKey dmgincl) const { return GetInnateDamageSource(DamageTypeInclination(dmgtype, dmgincl)); }
-    DamageSourceValue Battler::GetInnateDamageSource(DamageTypeInclination key) const { return _innateDamageSources.contains(key) ? _innateDamageSources.at(key) : 0; }
+    DamageSourceValue Battler::GetInnateDamageSource(DamageTypeInclination key) const { return _innateDamageSources.GetValue(key); }
 
-    BattlerStatValue Battler::AdjustStat(BattlerStatKey key, int delta) {
-        auto found = _stats.find(key);
-        if (found == _stats.end()) {
-            found = _stats.insert(_stats.begin(), std::make_pair(key, 0));
+    std::shared_ptr<BattlerSnapshot> Battler::BuildSnapshot(const DamageInclinationStatListMap* attackingStats, const DamageInclinationStatListMap* defendingStats) const {
+        auto snapshot = std::make_shared<BattlerSnapshot>(BattlerSnapshot {
+            BattlerInstance::NewVersion(),
+            _stats,
+            _resistances,
+            _innateDamageSources,
+            _affinities,
+            SkillMap(),
+            std::map<SkillKey, unsigned int>(),
+            attackingStats,
+            defendingStats,
+            std::vector<BattlerInstanceStatTotals>(),
+            0
+        });
+
+        for (const EquipmentSlots::const_iterator::value_type& equipment : _currentEquipment) {
+            if (equipment.second) {
+                snapshot->AddEquipment(*equipment.second);
+            }
         }
 
-        int newval = found->second + delta;
-        found->second = newval < 0 ? 0 : newval;
-        return found->second;
+        snapshot->RefreshResistTotal();
+        snapshot->RefreshStatTotals();
+        return snapshot;
     }
 
-    ElementalAffinityValue Battler::AdjustAffinity(ElementalAffinityKey key, int delta) {
-        return _affinities.AddValue(key, delta);
-    }
+    void BattlerSnapshot::RefreshStatTotals() {
+        statTotals.clear();
+        if (!attackingStatLists || !defendingStatLists) {
+            return;
+        }
 
-    BattlerInstance::BattlerInstance(Battler& parent, BattlerStatValue hp) : _parent(&parent), _affinities(ElementalAffinities(parent._affinities)) {
-        _resistances = DamageResistances(parent._resistances);
-        _stats = BattlerStatValues(parent._stats);
-        _damageSources = DamageSourceMap(parent._innateDamageSources);
+        // Inclinations which only one of the maps knows about still get an entry, with 0 for the other total.
+        for (const DamageInclinationStatListMap::value_type& attackingStats : *attackingStatLists) {
+            statTotals.push_back({ attackingStats.first, 0, 0 });
+        }
+        for (const DamageInclinationStatListMap::value_type& defendingStats : *defendingStatLists) {
+            if (!attackingStatLists->contains(defendingStats.first)) {
+                statTotals.push_back({ defendingStats.first, 0, 0 });
+            }
+        }
 
-        _hp = std::move(hp);
+        for (BattlerInstanceStatTotals& totals : statTotals) {
+            auto attackingStats = attackingStatLists->find(totals.inclination);
+            if (attackingStats != attackingStatLists->end()) {
+                for (const BattlerStat_shptr& stat : attackingStats->second) {
+                    totals.attacking += stats.GetValue(stat->abrvlong());
+                }
+            }
 
-        if (hp == 0) {
-            auto parenthp = _stats.find(BattlerStat::MXHP.AsLong());
-            _hp = parenthp == _stats.end() ? 0 : parenthp->second;
+            auto defendingStats = defendingStatLists->find(totals.inclination);
+            if (defendingStats != defendingStatLists->end()) {
+                for (const BattlerStat_shptr& stat : defendingStats->second) {
+                    totals.defending += stats.GetValue(stat->abrvlong());
+                }
+            }
         }
+    }
 
-        _skills = SkillMap();
+    void BattlerSnapshot::RefreshResistTotal() {
+        resistTotal = resistances.total();
+    }
 
-        for (const EquipmentSlots::const_iterator::value_type& equipment : parent._currentEquipment) {
-            const BattlerStatValues& bonusStats = equipment.second->bonusStats();
+    void BattlerSnapshot::AddEquipment(const Equipment& equipment) {
+        stats.AddValues(equipment.bonusStats());
+        resistances.AddValues(equipment.bonusResistances());
+        damageSources.AddValues(equipment.damageSources());
 
-            for (const BattlerStatValues::value_type& bonusStat : bonusStats) {
-                auto found = _stats.find(bonusStat.first);
-                if (found == _stats.end()) {
-                    _stats.insert(std::make_pair(bonusStat.first, bonusStat.second));
-                } else {
-                    found->second += bonusStat.second;
-                }
+        for (const SkillMap::value_type& skill : equipment.skills()) {
+            if (skillGrants[skill.first]++ == 0) {
+                skills.insert(skill);
             }
+        }
+    }
 
-            const DamageResistances& bonusResists = equipment.second->bonusResistances();
+    void BattlerSnapshot::RemoveEquipment(const Equipment& equipment) {
+        stats.SubtractValues(equipment.bonusStats());
+        resistances.SubtractValues(equipment.bonusResistances());
+        damageSources.SubtractValues(equipment.damageSources());
 
-            for (const DamageResistances::const_iterator::value_type& bonusResist : bonusResists) {
-                _resistances.AddValue(bonusResist.first, bonusResist.second);
+        for (const SkillMap::value_type& skill : equipment.skills()) {
+            auto grant = skillGrants.find(skill.first);
+            if (grant != skillGrants.end() && --grant->second == 0) {
+                skillGrants.erase(grant);
+                skills.erase(skill.first);
             }
+        }
+    }
 
-            const std::vector<Skill_shptr>& equipmentSkills = equipment.second->skills();
+    void BattlerSnapshot::ApplyEquipmentDelta(const EquipmentDelta& delta) {
+        if (delta.unequipped) {
+            RemoveEquipment(*delta.unequipped);
+        }
+        if (delta.equipped) {
+            AddEquipment(*delta.equipped);
+        }
 
-            for (const Skill_shptr& equipmentSkill : equipmentSkills) {
-                _skills.insert(std::make_pair(equipmentSkill->name(), equipmentSkill));
-            }
+        RefreshResistTotal();
+        RefreshStatTotals();
+    }
 
-            const DamageSourceMap& damageSources = equipment.second->damageSources();
+    std::atomic<BattlerInstanceVersion> BattlerInstance::_nextVersion = 1;
 
-            for (const DamageSourceMap::value_type& damageSource : damageSources) {
-                auto found = _damageSources.find(damageSource.first);
-                if (found == _damageSources.end()) {
-                    found = _damageSources.insert(_damageSources.begin(), std::make_pair(damageSource.first, 0));
-                }
-                found->second += damageSource.second;
-            }
+    BattlerInstance::BattlerInstance(const Battler& parent, std::shared_ptr<BattlerSnapshot> snapshot, BattlerStatValue hp) : _parent(&parent), _snapshot(std::move(snapshot)), _hp(hp) {
+        if (hp == 0) {
+            _hp = _snapshot->stats.GetValue(BattlerStat::MXHP.AsLong());
         }
     }
 
+    BattlerInstanceVersion BattlerInstance::NewVersion() { return _nextVersion++; }
+
     const std::string& BattlerInstance::name() const { return _parent->_name; }
     bool BattlerInstance::isCharacter() const { return _parent->_isCharacter; }
     unsigned short BattlerInstance::priority() const { return _parent->_priority; }
     unsigned int BattlerInstance::textureIndex() const { return _parent->_textureIndex; }
     unsigned int BattlerInstance::textureType() const { return _parent->_textureType; }
-    const DamageResistances& BattlerInstance::resistances() const { return _resistances; }
-    const ElementalAffinities& BattlerInstance::affinities() const { return _affinities; }
-    const SkillMap& BattlerInstance::skills() const { return _skills; }
+    const DamageResistances& BattlerInstance::resistances() const { return _snapshot->resistances; }
+    const ElementalAffinities& BattlerInstance::affinities() const { return _snapshot->affinities; }
+    const BattlerStatBlock& BattlerInstance::stats() const { return _snapshot->stats; }
+    const SkillMap& BattlerInstance::skills() const { return _snapshot->skills; }
+    BattlerInstanceVersion BattlerInstance::version() const { return _snapshot->version; }
+    const DamageInclinationStatListMap* BattlerInstance::attackingStatLists() const { return _snapshot->attackingStatLists; }
+    const DamageInclinationStatListMap* BattlerInstance::defendingStatLists() const { return _snapshot->defendingStatLists; }
+    const std::vector<BattlerInstanceStatTotals>& BattlerInstance::statTotals() const { return _snapshot->statTotals; }
+    long BattlerInstance::resistTotal() const { return _snapshot->resistTotal; }
 
     BattlerStatValue BattlerInstance::hp() const { return _hp; }
     BattlerStatValue BattlerInstance::hp(BattlerStatValue newval) { BattlerStatValue oldval = std::move(_hp); _hp = std::move(newval); return oldval; }
 
-    BattlerStatValue BattlerInstance::GetStat(BattlerStatKey key) const { return _stats.contains(key) ? _stats.at(key) : 0; }
+    BattlerStatValue BattlerInstance::GetStat(BattlerStatKey key) const { return _snapshot->stats.GetValue(key); }
+    BattlerStatValue BattlerInstance::GetStat(LOVIndex index) const { return _snapshot->stats.GetValue(index); }
+
+    unsigned long BattlerInstance::GetAttackingStatTotal(DamageInclinationKey key) const {
+        for (const BattlerInstanceStatTotals& totals : _snapshot->statTotals) {
+            if (totals.inclination == key) {
+                return totals.attacking;
+            }
+        }
+
+        return 0;
+    }
+    unsigned long BattlerInstance::GetDefendingStatTotal(DamageInclinationKey key) const {
+        for (const BattlerInstanceStatTotals& totals : _snapshot->statTotals) {
+            if (totals.inclination == key) {
+                return totals.defending;
+            }
+        }
+
+        return 0;
+    }
+
     DamageSourceValue BattlerInstance::GetDamageSource(DamageTypeKey dmgtype, DamageInclinationKey dmgincl) const { return GetDamageSource(DamageTypeInclination(dmgtype, dmgincl)); }
-    DamageSourceValue BattlerInstance::GetDamageSource(DamageTypeInclination key) const { return _damageSources.contains(key) ? _damageSources.at(key) : 0; }
+    DamageSourceValue BattlerInstance::GetDamageSource(DamageTypeInclination key) const { return _snapshot->damageSources.GetValue(key); }
+
+    BattlerSnapshot& BattlerInstance::MutableSnapshot() {
+        // The snapshot's owner and every copy of this instance hold their own reference, so a count of 1 means no one else can see the change.
+        if (_snapshot.use_count() > 1) {
+            _snapshot = std::make_shared<BattlerSnapshot>(*_snapshot);
+        }
+
+        _snapshot->version = _nextVersion++;
+        return *_snapshot;
+    }
+
+    BattlerStatValue BattlerInstance::AdjustStat(BattlerStatKey key, int delta) {
+        BattlerSnapshot& snapshot = MutableSnapshot();
+        BattlerStatValue newval = snapshot.stats.AddValue(key, delta);
+        snapshot.RefreshStatTotals();
+        return newval;
+    }
+
+    ElementalAffinityValue BattlerInstance::AdjustAffinity(ElementalAffinityKey key, int delta) {
+        return MutableSnapshot().affinities.AddValue(key, delta);
+    }
+
+    DamageResistanceValue BattlerInstance::AdjustResistance(DamageTypeInclination key, int delta) {
+        BattlerSnapshot& snapshot = MutableSnapshot();
+        DamageResistanceValue newval = snapshot.resistances.AddValue(key, delta);
+        snapshot.RefreshResistTotal();
+        return newval;
+    }
+
+    void BattlerInstance::ApplyEquipmentDelta(const EquipmentDelta& delta) {
+        if (delta.equipped || delta.unequipped) {
+            MutableSnapshot().ApplyEquipmentDelta(delta);
+        }
+    }
+
+    DamageSourceValue BattlerInstance::AdjustDamageSource(DamageTypeInclination key, int delta) {
+        BattlerSnapshot& snapshot = MutableSnapshot();
+        int newval = snapshot.damageSources.GetValue(key) + delta;
+        return snapshot.damageSources.SetValue(key, static_cast<DamageSourceValue>(newval < 0 ? 0 : newval));
+    }
 }
@@ -1,17 +1,79 @@
 #pragma once
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include "battlerstat.h"
+#include "damageinclination.h"
 #include "damageresistances.h"
 #include "damagesource.h"
 #include "elementalaffinities.h"
 #include "equipmentslots.h"
+#include "../store/handlepool.h"
 //#include "../store/gamexlostorage.h"
 
 namespace AWE {
+    /// <summary>
+    /// Identifies the damage-relevant state of a battler instance. Versions are drawn from a single global counter, so no two different states ever share one.
+    /// </summary>
+    typedef unsigned long long BattlerInstanceVersion;
+
+    /// <summary>
+    /// A battler instance's attacking and defending stat totals for one inclination.
+    /// </summary>
+    struct BattlerInstanceStatTotals {
+        DamageInclinationKey inclination;
+        unsigned long attacking;
+        unsigned long defending;
+    };
+
+    /// <summary>
+    /// Everything a battler instance derives from its battler and the battler's equipment. The content snapshot and the battler progression each hold one per battler,
+    /// and every instance spawned from it shares it until the instance changes its own state - at that point the instance copies the snapshot and changes its copy.
+    /// </summary>
+    struct BattlerSnapshot {
+        BattlerInstanceVersion version;
+        BattlerStatBlock stats;
+        DamageResistances resistances;
+        DamageSourceMatrix damageSources;
+        ElementalAffinities affinities;
+        SkillMap skills;
+        /// <summary>
+        /// How many equipped items grant each skill in `skills`, so unequipping one item only revokes the skills nothing else grants.
+        /// </summary>
+        std::map<SkillKey, unsigned int> skillGrants;
+
+        // Aggregates the damage formula reads for every inclination. Kept up to date by the instance mutators.
+        const DamageInclinationStatListMap* attackingStatLists;
+        const DamageInclinationStatListMap* defendingStatLists;
+        std::vector<BattlerInstanceStatTotals> statTotals;
+        long resistTotal;
+
+        /// <summary>
+        /// Rebuilds the per-inclination stat totals. Clears them if the snapshot has no stat lists.
+        /// </summary>
+        void RefreshStatTotals();
+        /// <summary>
+        /// Rebuilds the sum of all resistances.
+        /// </summary>
+        void RefreshResistTotal();
+        /// <summary>
+        /// Adds the given equipment's bonuses and skills to the snapshot. Does not refresh the totals.
+        /// </summary>
+        void AddEquipment(const Equipment&);
+        /// <summary>
+        /// Removes the given equipment's bonuses and skills from the snapshot, exactly reversing AddEquipment with the same equipment. Does not refresh the totals.
+        /// </summary>
+        void RemoveEquipment(const Equipment&);
+        /// <summary>
+        /// Removes the unequipped equipment and adds the equipped equipment of the given delta, then refreshes the totals. Does not change the version.
+        /// </summary>
+        void ApplyEquipmentDelta(const EquipmentDelta&);
+    };
     /// <summary>
     /// Represents "global" information about a battler. For the objects used in actual battles, see AWE::BattlerInstance.
+    /// Battlers are content, so they never change once loaded. Everything the player changes goes in the battler progression instead.
     /// </summary>
     class Battler {
     private:
@@ -20,9 +82,9 @@ namespace AWE {
         unsigned short _priority;
         unsigned int _textureIndex;
         unsigned int _textureType;
-        BattlerStatValues _stats;
+        BattlerStatBlock _stats;
         DamageResistances _resistances;
-        DamageSourceMap _innateDamageSources;
+        DamageSourceMatrix _innateDamageSources;
         ElementalAffinities _affinities;
         EquipmentSlots _currentEquipment;
 
@@ -36,14 +98,14 @@ namespace AWE {
             unsigned short priority,
             unsigned int textureIndex,
             unsigned int textureType,
-            BattlerStatValues&,
+            BattlerStatBlock&,
             DamageResistances&,
-            DamageSourceMap&,
+            DamageSourceMatrix&,
             ElementalAffinities&,
             EquipmentSlots&
         );
         /// <summary>
-        /// Constructor. EquipmentSlots are built internally using the EquipmentList object.
+        /// Constructor. EquipmentSlots are laid out from the given schema, then filled using the EquipmentList object.
         /// </summary>
         Battler(
             std::string,
@@ -51,10 +113,11 @@ namespace AWE {
             unsigned short priority,
             unsigned int textureIndex,
             unsigned int textureType,
-            BattlerStatValues&,
+            BattlerStatBlock&,
             DamageResistances&,
-            DamageSourceMap&,
+            DamageSourceMatrix&,
             ElementalAffinities&,
+            const EquipmentTypeCountMap& schema,
             const EquipmentList&
         );
 
@@ -74,47 +137,59 @@ namespace AWE {
         const ElementalAffinities& affinities() const;
         /// <returns>const refernece to this battler's current equipment slots.</returns>
         const EquipmentSlots& currentEquipment() const;
+        /// <returns>const reference to this battler's stats.</returns>
+        const BattlerStatBlock& stats() const;
+        /// <summary>
+        /// Builds a new snapshot of this battler and its equipment. Building it does not change the battler, so it is safe while other threads read it.
+        /// </summary>
+        /// <param name="attackingStats">Attacking stats of each inclination the snapshot keeps totals for, or nullptr to keep no stat totals. Must outlive the snapshot.</param>
+        /// <param name="defendingStats">Defending stats of each inclination the snapshot keeps totals for, or nullptr to keep no stat totals. Must outlive the snapshot.</param>
+        /// <returns>The new snapshot, with a new version. Never empty.</returns>
+        std::shared_ptr<BattlerSnapshot> BuildSnapshot(const DamageInclinationStatListMap* attackingStats, const DamageInclinationStatListMap* defendingStats) const;
 
         /// <returns>Value of the stat with the given key, or 0 if this battler has no such stat.</returns>
         BattlerStatValue GetStat(BattlerStatKey) const;
+        /// <returns>Value of the stat at the given index of the stat block, or 0 if the index is out of range.</returns>
+        BattlerStatValue GetStat(LOVIndex) const;
         /// <returns>Innate damage source value of this battler for the given damage type and inclination.</returns>
         DamageSourceValue GetInnateDamageSource(DamageTypeKey, DamageInclinationKey) const;
         /// <returns>Innate damage source value of this battler for the given damage type and inclination.</returns>
         DamageSourceValue GetInnateDamageSource(DamageTypeInclination) const;
 
-        /// <summary>
-        /// Adjusts the battler's stat by the value given.
-        /// </summary>
-        /// <returns>Returns the new value of that stat.</returns>
-        BattlerStatValue AdjustStat(BattlerStatKey, int);
-        /// <summary>
-        /// Adjusts the battler's elemental affinity by the value given.
-        /// </summary>
-        /// <returns>Returns the new value of that affinity.</returns>
-        ElementalAffinityValue AdjustAffinity(ElementalAffinityKey, int);
-
         friend class BattlerInstance;
     };
 
     /// <summary>
     /// Represents "instanced" information about a battler. A battler instance is created from an AWE::Battler at the start of combat, and is used to manage that battler's status during the battle.
+    /// Everything but the HP comes from a BattlerSnapshot shared with the content snapshot or battler progression it was spawned through, so creating an instance does not copy or rebuild anything.
     /// </summary>
     class BattlerInstance {
     private:
-        Battler* _parent;
+        static std::atomic<BattlerInstanceVersion> _nextVersion;
+
+        const Battler* _parent;
+        std::shared_ptr<BattlerSnapshot> _snapshot;
         BattlerStatValue _hp;
-        BattlerStatValues _stats;
-        DamageResistances _resistances;
-        DamageSourceMap _damageSources;
-        ElementalAffinities _affinities;
-        SkillMap _skills;
+
+        /// <summary>
+        /// Makes sure nothing else shares this instance's snapshot, copying it if needed, and gives it a new version.
+        /// Like the rest of the battle state, this is not safe to call while another thread copies or reads the same snapshot.
+        /// </summary>
+        /// <returns>Reference to this instance's own snapshot, which the caller is about to change.</returns>
+        BattlerSnapshot& MutableSnapshot();
 
     public:
         /// <summary>
-        /// Constructor. Creates a new battler instance from the given battler.
+        /// Constructor. Creates a new battler instance which shares the given snapshot, usually one held by a ContentSnapshot or BattlerProgression.
+        /// The snapshot is never changed through the instance, as long as whoever handed it over keeps its own reference.
         /// </summary>
-        /// <param name="hp">If 0 or less, the battler instance will be created using the `MXHP` stat of the given battler. Otherwise, the battler instance will have the given HP value.</param>
-        BattlerInstance(Battler&, BattlerStatValue hp = 0);
+        /// <param name="">Battler the snapshot was built from. Must outlive the battler instance.</param>
+        /// <param name="">Snapshot to share. Must not be empty.</param>
+        /// <param name="hp">If 0 or less, the battler instance will be created using the `MXHP` stat of the snapshot. Otherwise, the battler instance will have the given HP value.</param>
+        BattlerInstance(const Battler&, std::shared_ptr<BattlerSnapshot>, BattlerStatValue hp = 0);
+
+        /// <returns>A version no battler instance has had before. Give it to any snapshot built or changed outside of a battler instance.</returns>
+        static BattlerInstanceVersion NewVersion();
 
         /// <returns>const reference to the name of this battler.</returns>
         const std::string& name() const;
@@ -132,15 +207,59 @@ namespace AWE {
         const DamageResistances& resistances() const;
         /// <returns>const reference to this battler's elemental affinities.</returns>
         const ElementalAffinities& affinities() const;
+        /// <returns>const reference to this battler instance's stats, including the bonuses of the parent battler's equipment.</returns>
+        const BattlerStatBlock& stats() const;
         /// <returns>const reference to the battler instance's skills. Skills are determined using the battler's equipment.</returns>
         const SkillMap& skills() const;
+        /// <returns>Version of this battler instance's stats, resistances, affinities, and damage sources. Changes whenever any of them do. HP is not included. Instances spawned from the same unchanged battler share a version.</returns>
+        BattlerInstanceVersion version() const;
+        /// <returns>const pointer to the attacking stat lists the stat totals were built from, or nullptr if this instance keeps no stat totals.</returns>
+        const DamageInclinationStatListMap* attackingStatLists() const;
+        /// <returns>const pointer to the defending stat lists the stat totals were built from, or nullptr if this instance keeps no stat totals.</returns>
+        const DamageInclinationStatListMap* defendingStatLists() const;
+        /// <returns>const reference to the attacking and defending stat totals of every inclination. Empty if this instance keeps no stat totals.</returns>
+        const std::vector<BattlerInstanceStatTotals>& statTotals() const;
+        /// <returns>Sum of all of this battler instance's resistances, with negative resistances counted as 0.</returns>
+        long resistTotal() const;
 
         /// <param name="">New HP value.</param>
         /// <returns>Old HP value.</returns>
         BattlerStatValue hp(BattlerStatValue);
 
+        /// <summary>
+        /// Adjusts the battler instance's stat by the value given. The parent battler is not affected.
+        /// </summary>
+        /// <returns>Returns the new value of that stat.</returns>
+        BattlerStatValue AdjustStat(BattlerStatKey, int);
+        /// <summary>
+        /// Adjusts the battler instance's elemental affinity by the value given. The parent battler is not affected.
+        /// </summary>
+        /// <returns>Returns the new value of that affinity.</returns>
+        ElementalAffinityValue AdjustAffinity(ElementalAffinityKey, int);
+        /// <summary>
+        /// Adjusts the battler instance's damage resistance by the value given. The parent battler is not affected.
+        /// </summary>
+        /// <returns>Returns the new value of that resistance.</returns>
+        DamageResistanceValue AdjustResistance(DamageTypeInclination, int);
+        /// <summary>
+        /// Adjusts the battler instance's damage source by the value given. The parent battler is not affected.
+        /// </summary>
+        /// <returns>Returns the new value of that damage source.</returns>
+        DamageSourceValue AdjustDamageSource(DamageTypeInclination, int);
+        /// <summary>
+        /// Applies the given change of equipment to this battler instance only, without rebuilding it. The parent battler and its equipment slots are not affected.
+        /// Useful for trying out equipment, e.g. comparing loadouts, since the change can be reversed by applying the opposite delta.
+        /// </summary>
+        void ApplyEquipmentDelta(const EquipmentDelta&);
+
         /// <returns>Value of the stat with the given key, or 0 if this battler has no such stat.</returns>
         BattlerStatValue GetStat(BattlerStatKey) const;
+        /// <returns>Value of the stat at the given index of the stat block, or 0 if the index is out of range.</returns>
+        BattlerStatValue GetStat(LOVIndex) const;
+        /// <returns>Sum of this battler instance's attacking stats for the given inclination, or 0 if the inclination has none or this instance keeps no stat totals.</returns>
+        unsigned long GetAttackingStatTotal(DamageInclinationKey) const;
+        /// <returns>Sum of this battler instance's defending stats for the given inclination, or 0 if the inclination has none or this instance keeps no stat totals.</returns>
+        unsigned long GetDefendingStatTotal(DamageInclinationKey) const;
         /// <returns>Innate damage source value of this battler for the given damage type and inclination.</returns>
         DamageSourceValue GetDamageSource(DamageTypeKey, DamageInclinationKey) const;
         /// <returns>Innate damage source value of this battler for the given damage type and inclination.</returns>
@@ -150,14 +269,22 @@ namespace AWE {
     /// <summary>
     /// Represents "global" information about a battler. For the objects used in actual battles, see AWE::BattlerInstance.
     /// </summary>
-    typedef std::shared_ptr<Battler> Battler_shptr;
+    typedef std::shared_ptr<const Battler> Battler_shptr;
     /// <summary>
     /// Represents "instanced" information about a battler. A battler instance is created from an AWE::Battler at the start of combat, and is used to manage that battler's status during the battle.
     /// </summary>
     typedef std::shared_ptr<BattlerInstance> BattlerInstance_shptr;
     /// <summary>
-    /// Used to index battlers into a map. Currently designed to be a string which should be equivalent to the battler's name.
+    /// Refers to a battler instance owned by a BattlerInstancePool. Battle state passes these around instead of shared pointers.
+    /// </summary>
+    typedef Handle<BattlerInstance> BattlerInstanceHandle;
+    typedef HandlePool<BattlerInstance> BattlerInstancePool;
+    /// <summary>
+    /// Used to index battlers into a map. The battler's name, interned by the XLO storage's symbol table.
+    /// </summary>
+    typedef SymbolID BattlerKey;
+    /// <summary>
+    /// Loaded battlers by key. Battlers are held const, since content never changes once loaded.
     /// </summary>
-    typedef std::string BattlerKey;
-    typedef std::map<BattlerKey, Battler_shptr> BattlerMap;
+    typedef SymbolMap<const Battler> BattlerMap;
 }
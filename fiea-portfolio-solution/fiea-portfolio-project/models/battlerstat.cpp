@@ -1,11 +1,13 @@
 #include "battlerstat.h"
 
 namespace AWE {
+
+    /* BattlerStat */
+
     BattlerStat::BattlerStat() : AbbreviatedKey() {}
     BattlerStat::BattlerStat(std::string name, ABRV abrv) : AbbreviatedKey(name, abrv) {}
 
     const BattlerStat BattlerStat::INVALID = BattlerStat();
-    const ABRV BattlerStat::MXHP = ABRV('M', 'X', 'H', 'P');
 
     bool BattlerStat::Equals(const AbbreviatedKey& other) const {
         bool isEqual = false;
@@ -21,4 +23,68 @@ namespace AWE {
     bool BattlerStat::Equals(const BattlerStat& other) const {
         return _abrv.Equals(other._abrv);
     }
+
+    /* BattlerStatBlock */
+
+    BattlerStatBlock::BattlerStatBlock() : _indices(nullptr), _values() {}
+    BattlerStatBlock::BattlerStatBlock(const LOVIndexTable<BattlerStat>& indices) : _indices(&indices), _values() {}
+    BattlerStatBlock::BattlerStatBlock(const LOVIndexTable<BattlerStat>& indices, const BattlerStatValues& values) : BattlerStatBlock(indices) {
+        for (const BattlerStatValues::value_type& value : values) {
+            LOVIndex index = GetIndex(value.first);
+            if (index < size()) {
+                _values[index] = value.second;
+            }
+        }
+    }
+
+    const LOVIndexTable<BattlerStat>* BattlerStatBlock::indices() const { return _indices; }
+    std::size_t BattlerStatBlock::size() const {
+        // The storage refuses to load more stats than a block can hold, so this only clamps tables which did not come from it.
+        if (!_indices) {
+            return 0;
+        }
+        return (_indices->size() < CAPACITY) ? _indices->size() : CAPACITY;
+    }
+
+    LOVIndex BattlerStatBlock::GetIndex(BattlerStatKey key) const {
+        if (!_indices) {
+            return 0;
+        }
+
+        LOVIndex index = _indices->GetIndex(key);
+        return (index < size()) ? index : static_cast<LOVIndex>(size());
+    }
+
+    BattlerStatValue BattlerStatBlock::GetValue(LOVIndex index) const { return (index < size()) ? _values[index] : 0; }
+    BattlerStatValue BattlerStatBlock::GetValue(BattlerStatKey key) const { return GetValue(GetIndex(key)); }
+
+    BattlerStatValue BattlerStatBlock::AddValue(LOVIndex index, int delta) {
+        if (index >= size()) {
+            return 0;
+        }
+
+        long long newval = static_cast<long long>(_values[index]) + delta;
+        _values[index] = newval < 0 ? 0 : static_cast<BattlerStatValue>(newval);
+        return _values[index];
+    }
+    BattlerStatValue BattlerStatBlock::AddValue(BattlerStatKey key, int delta) { return AddValue(GetIndex(key), delta); }
+
+    void BattlerStatBlock::AddValues(const BattlerStatValues& values) {
+        for (const BattlerStatValues::value_type& value : values) {
+            LOVIndex index = GetIndex(value.first);
+            if (index < size()) {
+                _values[index] += value.second;
+            }
+        }
+    }
+
+    void BattlerStatBlock::SubtractValues(const BattlerStatValues& values) {
+        for (const BattlerStatValues::value_type& value : values) {
+            LOVIndex index = GetIndex(value.first);
+            if (index < size()) {
+                long long newval = static_cast<long long>(_values[index]) - value.second;
+                _values[index] = newval < 0 ? 0 : static_cast<BattlerStatValue>(newval);
+            }
+        }
+    }
 }
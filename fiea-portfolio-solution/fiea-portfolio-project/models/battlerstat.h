@@ -1,10 +1,12 @@
 #pragma once
+#include <array>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include "../abrv/abbreviatedkey.h"
 #include "../abrv/abrv.h"
+#include "../store/lovindextable.h"
 
 namespace AWE {
     /// <summary>
@@ -25,7 +27,7 @@ namespace AWE {
         /// <summary>
         /// ABRV of the BattlerStat which represents "Max HP". This particular stat is uniquely relevant for several things, hence this constant.
         /// </summary>
-        static const ABRV MXHP;
+        static constexpr ABRV MXHP = ABRV('M', 'X', 'H', 'P');
 
         /// <param name="other">The other AbbreviatedKey object.</param>
         /// <returns>Equivalence to the other AbbreviatedKey.</returns>
@@ -50,4 +52,67 @@ namespace AWE {
     typedef unsigned int BattlerStatValue;
     typedef std::unordered_map<BattlerStatKey, BattlerStatValue> BattlerStatValues;
     typedef std::vector<BattlerStat_shptr> BattlerStatList;
+
+    /// <summary>
+    /// Values of every battler stat, stored in one flat array indexed by the stats' LOVIndex. Copying a block copies the array and a pointer, nothing else.
+    /// Stats which are not in the block's index table cannot be stored, and always read as 0.
+    /// </summary>
+    class BattlerStatBlock {
+    public:
+        /// <summary>
+        /// Largest number of stats a block can hold. Sized so a whole block fits in a cache line.
+        /// </summary>
+        static const std::size_t CAPACITY = 16;
+
+    private:
+        const LOVIndexTable<BattlerStat>* _indices;
+        std::array<BattlerStatValue, CAPACITY> _values;
+
+    public:
+        /// <summary>
+        /// Default constructor. Initializes a block with no index table, which holds no stats.
+        /// </summary>
+        BattlerStatBlock();
+        /// <summary>
+        /// Constructor. Initializes every stat of the given table to 0.
+        /// </summary>
+        /// <param name="">Index table of the stats, usually GameLOVStorage::battlerStatIndices(). Must outlive the block and hold no more than CAPACITY stats.</param>
+        BattlerStatBlock(const LOVIndexTable<BattlerStat>&);
+        /// <summary>
+        /// Constructor. Initializes every stat of the given table, copying the values which are in the given map and setting the rest to 0. The map is not modified.
+        /// </summary>
+        BattlerStatBlock(const LOVIndexTable<BattlerStat>&, const BattlerStatValues&);
+
+        /// <returns>const pointer to the index table of the stats, or nullptr if the block has none.</returns>
+        const LOVIndexTable<BattlerStat>* indices() const;
+        /// <returns>Number of stats in the block.</returns>
+        std::size_t size() const;
+
+        /// <returns>Index of the stat with the given key, or size() if the block has no such stat.</returns>
+        LOVIndex GetIndex(BattlerStatKey) const;
+        /// <returns>Value of the stat at the given index, or 0 if the index is out of range.</returns>
+        BattlerStatValue GetValue(LOVIndex) const;
+        /// <returns>Value of the stat with the given key, or 0 if the block has no such stat.</returns>
+        BattlerStatValue GetValue(BattlerStatKey) const;
+
+        /// <summary>
+        /// Adds the given value to the stat at the given index. Value can be negative, but the stat will not go below 0. Does nothing if the index is out of range.
+        /// </summary>
+        /// <returns>New value of the stat after the addition.</returns>
+        BattlerStatValue AddValue(LOVIndex, int);
+        /// <summary>
+        /// Adds the given value to the stat with the given key. Value can be negative, but the stat will not go below 0. Does nothing if the block has no such stat.
+        /// </summary>
+        /// <returns>New value of the stat after the addition.</returns>
+        BattlerStatValue AddValue(BattlerStatKey, int);
+        /// <summary>
+        /// Adds every value of the given map to the stat with the same key. Keys the block has no stat for are ignored.
+        /// </summary>
+        void AddValues(const BattlerStatValues&);
+        /// <summary>
+        /// Subtracts every value of the given map from the stat with the same key, reversing AddValues with the same map. Keys the block has no stat for are ignored.
+        /// Stats are clamped at 0 rather than wrapping, so the reversal is only exact if no stat was lowered below the added amount in between.
+        /// </summary>
+        void SubtractValues(const BattlerStatValues&);
+    };
 }
@@ -5,7 +5,6 @@ namespace AWE {
     DamageInclination::DamageInclination(std::string name, ABRV abrv) : AbbreviatedKey(name, abrv) {}
 
     const DamageInclination DamageInclination::INVALID = DamageInclination();
-    const ABRV DamageInclination::AUTO_KEY = ABRV('A', 'U', 'T', 'O');
 
     bool DamageInclination::Equals(const AbbreviatedKey& other) const {
         bool isEqual = false;
@@ -27,7 +27,7 @@ namespace AWE {
         /// ABRV which represents the "AUTO" damage inclination. This is not an actual valid damage inclination, but when this value is found in certain places where an inclination is
         /// expected, the algorithm would be designed to know to determine the correct inclination from the surrounding context.
         /// </summary>
-        static const ABRV AUTO_KEY;
+        static constexpr ABRV AUTO_KEY = ABRV('A', 'U', 'T', 'O');
 
         /// <param name="other">The other AbbreviatedKey object.</param>
         /// <returns>Equivalence to the other AbbreviatedKey.</returns>
@@ -0,0 +1,139 @@
+#include "damageplan.h"
+#include <algorithm>
+#include "skill.h"
+
+namespace AWE {
+    const DamagePlanIndex DamagePlan::INVALID_INDEX = static_cast<DamagePlanIndex>(-1);
+
+    DamagePlan::DamagePlan() : _isCompiled(false) {}
+    DamagePlan::DamagePlan(const std::vector<SkillDamage>& damages, const DamageInclinationMap& inclinations, const DamageInclinationStatListMap& attackingStats, const DamageInclinationStatListMap& defendingStats)
+            : _isCompiled(true) {
+        // Sorted so that the same content always compiles to the same plan, regardless of hash map ordering.
+        std::vector<DamageInclinationKey> inclinationKeys;
+        for (const DamageInclinationMap::value_type& inclination : inclinations) {
+            inclinationKeys.push_back(inclination.first);
+        }
+        std::sort(inclinationKeys.begin(), inclinationKeys.end());
+
+        for (const SkillDamage& damage : damages) {
+            DamagePlanComponent component = {};
+            component.baseDamage = damage.baseDamage().value();
+            component.baseInclination = INVALID_INDEX;
+            component.inclinations.begin = static_cast<DamagePlanIndex>(_inclinations.size());
+
+            DamageInclinationKey baseInclinationKey = damage.baseDamage().inclination()->abrvlong();
+
+            for (DamageInclinationKey inclinationKey : inclinationKeys) {
+                bool isBaseInclination = (inclinationKey == baseInclinationKey);
+                bool isUsed = isBaseInclination;
+                for (const SkillElementBinding& binding : damage.elementBindings()) {
+                    if (binding.inclination()->abrvlong() == inclinationKey) {
+                        isUsed = true;
+                        break;
+                    }
+                }
+
+                // An inclination without bindings contributes nothing except, possibly, the damage reduction of the base damage.
+                if (!isUsed) {
+                    continue;
+                }
+
+                if (isBaseInclination) {
+                    component.baseInclination = static_cast<DamagePlanIndex>(_inclinations.size() - component.inclinations.begin);
+                }
+
+                DamageInclinationKey attackingInclinationKey = (damage.inclinationKey() == DamageInclination::AUTO_KEY.AsLong()) ? inclinationKey : damage.inclinationKey();
+
+                DamagePlanInclination inclination = {};
+                inclination.key = inclinationKey;
+                inclination.attackingKey = attackingInclinationKey;
+                inclination.attackingStats = AppendStats( attackingStats, attackingInclinationKey);
+                inclination.defendingStats = AppendStats( defendingStats, inclinationKey);
+
+                inclination.statScalings.begin = static_cast<DamagePlanIndex>(_statScalings.size());
+                for (const SkillStatScaling& scaling : damage.statScalings()) {
+                    if (scaling.inclination()->abrvlong() == inclinationKey) {
+                        _statScalings.push_back({ scaling.battlerStat()->abrvlong(), scaling.value(), DamageFixedFromFloat(scaling.value()) });
+                    }
+                }
+                inclination.statScalings.count = static_cast<DamagePlanIndex>(_statScalings.size() - inclination.statScalings.begin);
+
+                inclination.bindings.begin = static_cast<DamagePlanIndex>(_bindings.size());
+                for (const SkillElementBinding& binding : damage.elementBindings()) {
+                    if (binding.inclination()->abrvlong() != inclinationKey) {
+                        continue;
+                    }
+
+                    DamagePlanBinding compiled = {};
+                    compiled.damageType = binding.damageType()->abrvlong();
+                    compiled.scaling = binding.scaling();
+                    compiled.fixedScaling = DamageFixedFromFloat(binding.scaling());
+                    compiled.isPenetrating = binding.isPenetrating();
+                    compiled.elements.begin = static_cast<DamagePlanIndex>(_elements.size());
+                    if (binding.IsGroupBinding()) {
+                        if (binding.group()->IsValid()) {
+                            for (const SkillElement_shptr& element : binding.group()->elements()) {
+                                _elements.push_back(element->abrvlong());
+                            }
+                        }
+                    } else {
+                        _elements.push_back(binding.element()->abrvlong());
+                    }
+                    compiled.elements.count = static_cast<DamagePlanIndex>(_elements.size() - compiled.elements.begin);
+
+                    _bindings.push_back(compiled);
+                }
+                inclination.bindings.count = static_cast<DamagePlanIndex>(_bindings.size() - inclination.bindings.begin);
+
+                _inclinations.push_back(inclination);
+            }
+
+            component.inclinations.count = static_cast<DamagePlanIndex>(_inclinations.size() - component.inclinations.begin);
+            if (component.baseInclination == INVALID_INDEX) {
+                component.baseInclination = component.inclinations.count;
+            }
+            _components.push_back(component);
+        }
+    }
+
+    DamagePlanRange DamagePlan::AppendStats(const DamageInclinationStatListMap& stats, DamageInclinationKey incl) {
+        DamagePlanRange range = { static_cast<DamagePlanIndex>(_stats.size()), 0 };
+
+        auto found = stats.find(incl);
+        if (found != stats.end()) {
+            for (const BattlerStat_shptr& stat : found->second) {
+                _stats.push_back(stat->abrvlong());
+            }
+        }
+
+        range.count = static_cast<DamagePlanIndex>(_stats.size() - range.begin);
+        return range;
+    }
+
+    bool DamagePlan::isCompiled() const { return _isCompiled; }
+    std::span<const DamagePlanComponent> DamagePlan::components() const { return std::span<const DamagePlanComponent>(_components); }
+    std::span<const DamagePlanInclination> DamagePlan::inclinations() const { return std::span<const DamagePlanInclination>(_inclinations); }
+    std::span<const DamagePlanStatScaling> DamagePlan::statScalings() const { return std::span<const DamagePlanStatScaling>(_statScalings); }
+    std::span<const DamagePlanBinding> DamagePlan::bindings() const { return std::span<const DamagePlanBinding>(_bindings); }
+    std::span<const BattlerStatKey> DamagePlan::stats() const { return std::span<const BattlerStatKey>(_stats); }
+    std::span<const SkillElementKey> DamagePlan::elements() const { return std::span<const SkillElementKey>(_elements); }
+
+    std::span<const DamagePlanInclination> DamagePlan::GetInclinations(const DamagePlanComponent& component) const {
+        return std::span<const DamagePlanInclination>(_inclinations).subspan(component.inclinations.begin, component.inclinations.count);
+    }
+    std::span<const DamagePlanStatScaling> DamagePlan::GetStatScalings(const DamagePlanInclination& inclination) const {
+        return std::span<const DamagePlanStatScaling>(_statScalings).subspan(inclination.statScalings.begin, inclination.statScalings.count);
+    }
+    std::span<const DamagePlanBinding> DamagePlan::GetBindings(const DamagePlanInclination& inclination) const {
+        return std::span<const DamagePlanBinding>(_bindings).subspan(inclination.bindings.begin, inclination.bindings.count);
+    }
+    std::span<const BattlerStatKey> DamagePlan::GetAttackingStats(const DamagePlanInclination& inclination) const {
+        return std::span<const BattlerStatKey>(_stats).subspan(inclination.attackingStats.begin, inclination.attackingStats.count);
+    }
+    std::span<const BattlerStatKey> DamagePlan::GetDefendingStats(const DamagePlanInclination& inclination) const {
+        return std::span<const BattlerStatKey>(_stats).subspan(inclination.defendingStats.begin, inclination.defendingStats.count);
+    }
+    std::span<const SkillElementKey> DamagePlan::GetElements(const DamagePlanBinding& binding) const {
+        return std::span<const SkillElementKey>(_elements).subspan(binding.elements.begin, binding.elements.count);
+    }
+}
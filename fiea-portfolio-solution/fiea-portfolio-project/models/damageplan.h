@@ -0,0 +1,142 @@
+#pragma once
+#include <span>
+#include <vector>
+#include "battlerstat.h"
+#include "damageinclination.h"
+#include "damagetype.h"
+#include "skillelement.h"
+#include "../misc/damagefixed.h"
+
+namespace AWE {
+    // Forward declaration, defined in skill.h
+    class SkillDamage;
+
+    /// <summary>
+    /// Index into one of a DamagePlan's flat arrays.
+    /// </summary>
+    typedef unsigned short DamagePlanIndex;
+
+    /// <summary>
+    /// A contiguous run of entries inside one of a DamagePlan's flat arrays.
+    /// </summary>
+    struct DamagePlanRange {
+        DamagePlanIndex begin;
+        DamagePlanIndex count;
+    };
+
+    /// <summary>
+    /// Compiled form of a SkillStatScaling.
+    /// </summary>
+    struct DamagePlanStatScaling {
+        BattlerStatKey stat;
+        float value;
+        /// <summary>value, converted when the plan was compiled for the fixed-point damage mode.</summary>
+        DamageFixed fixedValue;
+    };
+
+    /// <summary>
+    /// Compiled form of a SkillElementBinding. Group bindings are flattened into the group's element list, so every binding is simply a range of element keys.
+    /// </summary>
+    struct DamagePlanBinding {
+        DamageTypeKey damageType;
+        DamagePlanRange elements;
+        float scaling;
+        /// <summary>scaling, converted when the plan was compiled for the fixed-point damage mode.</summary>
+        DamageFixed fixedScaling;
+        bool isPenetrating;
+    };
+
+    /// <summary>
+    /// Everything one damage component needs to know about one of the inclinations it touches.
+    /// </summary>
+    struct DamagePlanInclination {
+        DamageInclinationKey key;
+        /// <summary>Inclination whose attacking stats are used. Differs from key only when the skill damage has an explicit inclination.</summary>
+        DamageInclinationKey attackingKey;
+        DamagePlanRange attackingStats;
+        DamagePlanRange defendingStats;
+        DamagePlanRange statScalings;
+        DamagePlanRange bindings;
+    };
+
+    /// <summary>
+    /// Compiled form of a SkillDamage. Components are stored in the same order as the skill's damages.
+    /// </summary>
+    struct DamagePlanComponent {
+        int baseDamage;
+        /// <summary>
+        /// Index of the base damage's inclination, relative to the beginning of this component's inclination range. Equal to the range's count if the base damage's inclination is not loaded.
+        /// </summary>
+        DamagePlanIndex baseInclination;
+        DamagePlanRange inclinations;
+    };
+
+    /// <summary>
+    /// A skill's damage components compiled down into flat arrays of plain structs. Inclinations which a component never deals damage with (and which its base damage does not use)
+    /// are pruned out entirely, and the attacking and defending stats of every remaining inclination are resolved ahead of time. Walking a plan requires no map lookups
+    /// on the skill side and no shared_ptr copies.
+    /// </summary>
+    class DamagePlan {
+    private:
+        bool _isCompiled;
+        std::vector<DamagePlanComponent> _components;
+        std::vector<DamagePlanInclination> _inclinations;
+        std::vector<DamagePlanStatScaling> _statScalings;
+        std::vector<DamagePlanBinding> _bindings;
+        std::vector<BattlerStatKey> _stats;
+        std::vector<SkillElementKey> _elements;
+
+        /// <summary>
+        /// Appends the stats of the given inclination to the flat stat array.
+        /// </summary>
+        /// <returns>Range of the appended stats.</returns>
+        DamagePlanRange AppendStats(const DamageInclinationStatListMap&, DamageInclinationKey);
+
+    public:
+        /// <summary>
+        /// Placeholder value for indices which have not been resolved.
+        /// </summary>
+        static const DamagePlanIndex INVALID_INDEX;
+
+        /// <summary>
+        /// Default constructor. Initializes an empty plan which is not compiled.
+        /// </summary>
+        DamagePlan();
+        /// <summary>
+        /// Constructor. Compiles the given skill damages.
+        /// </summary>
+        /// <param name="damages">Damage components to compile.</param>
+        /// <param name="inclinations">All loaded damage inclinations.</param>
+        /// <param name="attackingStats">Attacking stats of each damage inclination.</param>
+        /// <param name="defendingStats">Defending stats of each damage inclination.</param>
+        DamagePlan(const std::vector<SkillDamage>& damages, const DamageInclinationMap& inclinations, const DamageInclinationStatListMap& attackingStats, const DamageInclinationStatListMap& defendingStats);
+
+        /// <returns>Was this plan compiled? Default-constructed plans are not.</returns>
+        bool isCompiled() const;
+        /// <returns>All compiled damage components.</returns>
+        std::span<const DamagePlanComponent> components() const;
+        /// <returns>Every compiled inclination of every component. DamagePlanComponent::inclinations indexes into this.</returns>
+        std::span<const DamagePlanInclination> inclinations() const;
+        /// <returns>Every compiled stat scaling. DamagePlanInclination::statScalings indexes into this.</returns>
+        std::span<const DamagePlanStatScaling> statScalings() const;
+        /// <returns>Every compiled element binding. DamagePlanInclination::bindings indexes into this.</returns>
+        std::span<const DamagePlanBinding> bindings() const;
+        /// <returns>Every resolved attacking and defending stat. DamagePlanInclination::attackingStats and defendingStats index into this.</returns>
+        std::span<const BattlerStatKey> stats() const;
+        /// <returns>Every element key used by a binding. DamagePlanBinding::elements indexes into this.</returns>
+        std::span<const SkillElementKey> elements() const;
+
+        /// <returns>The inclinations touched by the given component.</returns>
+        std::span<const DamagePlanInclination> GetInclinations(const DamagePlanComponent&) const;
+        /// <returns>Stat scalings of the given inclination.</returns>
+        std::span<const DamagePlanStatScaling> GetStatScalings(const DamagePlanInclination&) const;
+        /// <returns>Element bindings of the given inclination, in the same order as they appear in the skill.</returns>
+        std::span<const DamagePlanBinding> GetBindings(const DamagePlanInclination&) const;
+        /// <returns>Attacking stats of the given inclination.</returns>
+        std::span<const BattlerStatKey> GetAttackingStats(const DamagePlanInclination&) const;
+        /// <returns>Defending stats of the given inclination.</returns>
+        std::span<const BattlerStatKey> GetDefendingStats(const DamagePlanInclination&) const;
+        /// <returns>Element keys of the given binding. Group bindings return every element in the group.</returns>
+        std::span<const SkillElementKey> GetElements(const DamagePlanBinding&) const;
+    };
+}
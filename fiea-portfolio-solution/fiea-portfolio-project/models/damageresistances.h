@@ -1,13 +1,18 @@
 #pragma once
+#include <cstddef>
+#include <iterator>
 #include <map>
+#include <utility>
 #include "damageinclination.h"
 #include "damagetype.h"
+#include "damagetypeinclinationmatrix.h"
 #include "lovpairs.h"
 
 namespace AWE {
     // Forward declarations, defined in battler.h
     class Battler;
     class BattlerInstance;
+    struct BattlerSnapshot;
 
     typedef int DamageResistanceValue;
     typedef std::map<DamageTypeInclination, DamageResistanceValue, DamageTypeInclination_comp> DamageResistanceMap;
@@ -15,75 +20,91 @@ namespace AWE {
     /// <summary>
     /// Represents a battler's resistances to specific types of damage. Note that "types of damage" here actually means inclination-type pairs, e.g. physical slashing, magical arcane, etc.
     /// Also note that DamageResistanceValue is not unsigned - there can be negative resistances.
+    /// Every pair of the loaded types and inclinations is stored densely, so looking up a resistance is index math rather than a search.
     /// </summary>
     class DamageResistances {
     private:
-        DamageResistanceMap _map;
+        DamageTypeInclinationMatrix<DamageResistanceValue> _matrix;
 
         /// <summary>
-        /// Sets the value of the given resistance. The given resistance will be created if it did not exist.
+        /// Sets the value of the given resistance. Does nothing if the resistance's type or inclination is not in the index tables.
         /// </summary>
         /// <returns>New value of the given resistance. Note this does not return the old value.</returns>
         DamageResistanceValue SetValue(DamageTypeInclination, DamageResistanceValue);
         /// <summary>
-        /// Adds the given value to the current value of the given resistance. Value can be negative. The given resistance will be created if it did not exist.
+        /// Adds the given value to the current value of the given resistance. Value can be negative. Does nothing if the resistance's type or inclination is not in the index tables.
         /// </summary>
         /// <returns>New value of the given resistance after the addition.</returns>
         DamageResistanceValue AddValue(DamageTypeInclination, DamageResistanceValue);
+        /// <summary>
+        /// Adds every resistance of the given object to the same resistance of this one.
+        /// </summary>
+        void AddValues(const DamageResistances&);
+        /// <summary>
+        /// Subtracts every resistance of the given object from the same resistance of this one, exactly reversing AddValues with the same object.
+        /// Resistances can be negative, so unlike stats and damage sources, nothing is clamped.
+        /// </summary>
+        void SubtractValues(const DamageResistances&);
 
         friend class Battler;
         friend class BattlerInstance;
+        friend struct BattlerSnapshot;
 
     public:
-        DamageResistances();
         /// <summary>
-        /// Constructor.
+        /// Default constructor. Initializes an object with no index tables, which holds no resistances.
         /// </summary>
-        /// <param name="">Map to use for resistances. Note this parameter is moved into the initialized object.</param>
-        DamageResistances(DamageResistanceMap&);
+        DamageResistances();
         /// <summary>
         /// Constructor. Initializes resistances for all types and inclinations given, and sets them to 0.
         /// </summary>
-        DamageResistances(const DamageTypeMap&, const DamageInclinationMap&);
+        /// <param name="">Index tables of the damage types and inclinations, usually from GameLOVStorage. Both must outlive the object.</param>
+        DamageResistances(const LOVIndexTable<DamageType>&, const LOVIndexTable<DamageInclination>&);
         /// <summary>
-        /// Constructor. Initializes resistances for all types and inclinations given, and copies their values from the given map. None of the given maps are modified.
+        /// Constructor. Initializes resistances for all types and inclinations given, and copies their values from the given map. None of the given objects are modified.
         /// </summary>
-        DamageResistances(const DamageTypeMap&, const DamageInclinationMap&, const DamageResistanceMap&);
+        DamageResistances(const LOVIndexTable<DamageType>&, const LOVIndexTable<DamageInclination>&, const DamageResistanceMap&);
 
-        /// <returns>const reference to the internal map.</returns>
-        const DamageResistanceMap& map() const;
+        /// <returns>const reference to the internal matrix.</returns>
+        const DamageTypeInclinationMatrix<DamageResistanceValue>& matrix() const;
+        /// <returns>Sum of all resistances, with negative resistances counted as 0.</returns>
+        long total() const;
 
         /// <returns>Value of the resistance for the given type and inclination.</returns>
         DamageResistanceValue GetValue(DamageTypeKey, DamageInclinationKey) const;
         /// <returns>Value of the resistance for the given type and inclination.</returns>
         DamageResistanceValue GetValue(DamageTypeInclination) const;
+        /// <returns>Value of the resistance for the given type and inclination indices, or 0 if either is out of range.</returns>
+        DamageResistanceValue GetValue(LOVIndex dmgtype, LOVIndex inclination) const;
 
+        /// <summary>
+        /// Iterates every resistance in type, then inclination order. Resistances are stored densely, so the iterator yields each pair by value.
+        /// </summary>
         class const_iterator {
         public:
             using iterator_category = std::input_iterator_tag;
-            using value_type = DamageResistanceMap::value_type;
-            using difference_type = DamageResistanceMap::difference_type;
-            using pointer = DamageResistanceMap::const_pointer;
-            using reference = DamageResistanceMap::const_reference;
+            using value_type = std::pair<const DamageTypeInclination, DamageResistanceValue>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
 
-            const_iterator(const DamageResistanceMap&);
-            const_iterator(const DamageResistanceMap::const_iterator&);
+            const_iterator(const DamageTypeInclinationMatrix<DamageResistanceValue>&, std::size_t index);
 
             reference operator*() const;
-            pointer operator->();
             const_iterator& operator++();
             const_iterator operator++(int);
 
-            friend bool operator==(const const_iterator& it1, const const_iterator& it2) { return it1._itr == it2._itr; }
-            friend bool operator!=(const const_iterator& it1, const const_iterator& it2) { return it1._itr != it2._itr; }
+            friend bool operator==(const const_iterator& it1, const const_iterator& it2) { return it1._index == it2._index; }
+            friend bool operator!=(const const_iterator& it1, const const_iterator& it2) { return it1._index != it2._index; }
 
         private:
-            DamageResistanceMap::const_iterator _itr;
+            const DamageTypeInclinationMatrix<DamageResistanceValue>* _matrix;
+            std::size_t _index;
         };
 
         /// <returns>const iterator to the first resistance value pair in this object.</returns>
         const_iterator begin() const;
-        /// <returns>const iterator to the spot in memory behind the last resistance value pair in this object. Attempting access from this address will result in undefined behavior.</returns>
+        /// <returns>const iterator to the spot behind the last resistance value pair in this object. Attempting to dereference it will result in undefined behavior.</returns>
         const_iterator end() const;
     };
 }
@@ -1,16 +1,8 @@
 #include "damagesource.h"
 
 namespace AWE {
-    DamageSourceMap CreateFullDamageSources(const DamageInclinationMap& inclinations, const DamageTypeMap& dmgtypes) {
-        DamageSourceMap sources;
-
-        for (DamageInclinationMap::value_type inclination : inclinations) {
-            for (DamageTypeMap::value_type dmgtype : dmgtypes) {
-                sources.insert(std::make_pair(std::make_pair(dmgtype.first, inclination.first), DAMAGESOURCE_MAXVALUE));
-            }
-        }
-
-        return sources;
+    DamageSourceMatrix CreateFullDamageSources(const LOVIndexTable<DamageInclination>& inclinations, const LOVIndexTable<DamageType>& dmgtypes) {
+        return DamageSourceMatrix(dmgtypes, inclinations, DAMAGESOURCE_MAXVALUE);
     }
 
     float DetermineDamageSourcePercentage(DamageSourceValue val) {
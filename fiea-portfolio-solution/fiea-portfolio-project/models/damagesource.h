@@ -2,6 +2,7 @@
 #include <map>
 #include "damageinclination.h"
 #include "damagetype.h"
+#include "damagetypeinclinationmatrix.h"
 #include "lovpairs.h"
 
 namespace AWE {
@@ -21,6 +22,10 @@ namespace AWE {
     /// For this version of the project, this system is not really used for simplicity's sake - however, it is implemented, and can be used in later projects.
     /// </summary>
     typedef std::map<DamageTypeInclination, DamageSourceValue, DamageTypeInclination_comp> DamageSourceMap;
+    /// <summary>
+    /// Damage sources of every loaded type and inclination pair, stored densely. Battlers and equipment keep their damage sources in this form; DamageSourceMap remains for sparse values.
+    /// </summary>
+    typedef DamageTypeInclinationMatrix<DamageSourceValue> DamageSourceMatrix;
 
     /// <summary>
     /// If a battler's amount of a damage source meets or exceeds this value, they will deal the normal amount of damage for that type they have sources of.
@@ -33,8 +38,8 @@ namespace AWE {
     /// </summary>
     static const float DAMAGESOURCE_MAXVALUE_F = 4.0f;
 
-    /// <returns>A DamageSourceMap which has full damage sources for all inclinations and types given.</returns>
-    DamageSourceMap CreateFullDamageSources(const DamageInclinationMap& inclinations, const DamageTypeMap& dmgtypes);
+    /// <returns>A DamageSourceMatrix which has full damage sources for all inclinations and types given.</returns>
+    DamageSourceMatrix CreateFullDamageSources(const LOVIndexTable<DamageInclination>& inclinations, const LOVIndexTable<DamageType>& dmgtypes);
     /// <summary>
     /// Converts a DamageSourceValue into a percentage of damage.
     /// </summary>
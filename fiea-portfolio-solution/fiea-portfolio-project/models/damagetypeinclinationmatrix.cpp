@@ -0,0 +1,141 @@
+#include <type_traits>
+#include "damagetypeinclinationmatrix.h"
+#include "damageresistances.h"
+#include "damagesource.h"
+
+namespace AWE {
+
+    /* DamageTypeInclinationMatrix */
+
+    template <typename T> DamageTypeInclinationMatrix<T>::DamageTypeInclinationMatrix() : _types(nullptr), _inclinations(nullptr), _total(0) {}
+
+    template <typename T>
+    DamageTypeInclinationMatrix<T>::DamageTypeInclinationMatrix(const LOVIndexTable<DamageType>& types, const LOVIndexTable<DamageInclination>& inclinations, T value)
+        : _types(&types)
+        , _inclinations(&inclinations)
+        , _values(types.size() * inclinations.size(), value)
+        , _rowSums(types.size(), Summand(value) * static_cast<long>(inclinations.size()))
+        , _total(Summand(value) * static_cast<long>(types.size() * inclinations.size())) {}
+
+    template <typename T>
+    DamageTypeInclinationMatrix<T>::DamageTypeInclinationMatrix(const LOVIndexTable<DamageType>& types, const LOVIndexTable<DamageInclination>& inclinations, const std::map<DamageTypeInclination, T, DamageTypeInclination_comp>& values)
+        : DamageTypeInclinationMatrix(types, inclinations) {
+        for (const auto& value : values) {
+            SetValue(value.first, value.second);
+        }
+    }
+
+    template <typename T> long DamageTypeInclinationMatrix<T>::Summand(T value) { return value < 0 ? 0L : static_cast<long>(value); }
+
+    template <typename T>
+    T DamageTypeInclinationMatrix<T>::Combine(T value, T other, bool isSubtracting) {
+        long long result = isSubtracting ? (static_cast<long long>(value) - other) : (static_cast<long long>(value) + other);
+        // Unsigned values such as damage sources are clamped at 0 when adjusted, so an item's bonus may no longer all be there to take back off.
+        if constexpr (std::is_unsigned_v<T>) {
+            if (result < 0) {
+                return 0;
+            }
+        }
+        return static_cast<T>(result);
+    }
+
+    template <typename T> const LOVIndexTable<DamageType>* DamageTypeInclinationMatrix<T>::types() const { return _types; }
+    template <typename T> const LOVIndexTable<DamageInclination>* DamageTypeInclinationMatrix<T>::inclinations() const { return _inclinations; }
+    template <typename T> std::size_t DamageTypeInclinationMatrix<T>::rowCount() const { return _rowSums.size(); }
+    template <typename T> std::size_t DamageTypeInclinationMatrix<T>::columnCount() const { return _inclinations ? _inclinations->size() : 0; }
+    template <typename T> std::span<const T> DamageTypeInclinationMatrix<T>::values() const { return std::span<const T>(_values); }
+    template <typename T> long DamageTypeInclinationMatrix<T>::total() const { return _total; }
+
+    template <typename T>
+    std::size_t DamageTypeInclinationMatrix<T>::GetIndex(DamageTypeInclination key) const {
+        if (!_types || !_inclinations) {
+            return _values.size();
+        }
+
+        LOVIndex dmgtype = _types->GetIndex(key.first);
+        LOVIndex inclination = _inclinations->GetIndex(key.second);
+        if (dmgtype >= rowCount() || inclination >= columnCount()) {
+            return _values.size();
+        }
+
+        return (static_cast<std::size_t>(dmgtype) * columnCount()) + inclination;
+    }
+
+    template <typename T>
+    DamageTypeInclination DamageTypeInclinationMatrix<T>::GetKey(std::size_t index) const {
+        return DamageTypeInclination(_types->GetKey(static_cast<LOVIndex>(index / columnCount())), _inclinations->GetKey(static_cast<LOVIndex>(index % columnCount())));
+    }
+
+    template <typename T>
+    T DamageTypeInclinationMatrix<T>::GetValue(LOVIndex dmgtype, LOVIndex inclination) const {
+        return (dmgtype < rowCount() && inclination < columnCount()) ? _values[(static_cast<std::size_t>(dmgtype) * columnCount()) + inclination] : 0;
+    }
+
+    template <typename T>
+    T DamageTypeInclinationMatrix<T>::GetValue(DamageTypeInclination key) const {
+        std::size_t index = GetIndex(key);
+        return (index < _values.size()) ? _values[index] : 0;
+    }
+
+    template <typename T> long DamageTypeInclinationMatrix<T>::GetRowSum(LOVIndex dmgtype) const { return (dmgtype < rowCount()) ? _rowSums[dmgtype] : 0; }
+
+    template <typename T>
+    T DamageTypeInclinationMatrix<T>::SetValue(DamageTypeInclination key, T value) {
+        std::size_t index = GetIndex(key);
+        if (index >= _values.size()) {
+            return value;
+        }
+
+        long delta = Summand(value) - Summand(_values[index]);
+        _rowSums[index / columnCount()] += delta;
+        _total += delta;
+        _values[index] = value;
+        return value;
+    }
+
+    template <typename T>
+    T DamageTypeInclinationMatrix<T>::AddValue(DamageTypeInclination key, T value) {
+        std::size_t index = GetIndex(key);
+        if (index >= _values.size()) {
+            return value;
+        }
+
+        return SetValue(key, static_cast<T>(_values[index] + value));
+    }
+
+    template <typename T> void DamageTypeInclinationMatrix<T>::AddValues(const DamageTypeInclinationMatrix& other) { Accumulate(other, false); }
+    template <typename T> void DamageTypeInclinationMatrix<T>::SubtractValues(const DamageTypeInclinationMatrix& other) { Accumulate(other, true); }
+
+    template <typename T>
+    void DamageTypeInclinationMatrix<T>::Accumulate(const DamageTypeInclinationMatrix& other, bool isSubtracting) {
+        if (other._types == _types && other._inclinations == _inclinations) {
+            for (std::size_t i = 0; i < _values.size(); i++) {
+                _values[i] = Combine(_values[i], other._values[i], isSubtracting);
+            }
+
+            // Recounting is still a single pass, and cheaper than tracking each value's change.
+            _total = 0;
+            for (std::size_t row = 0; row < rowCount(); row++) {
+                long sum = 0;
+                for (std::size_t column = 0; column < columnCount(); column++) {
+                    sum += Summand(_values[(row * columnCount()) + column]);
+                }
+                _rowSums[row] = sum;
+                _total += sum;
+            }
+            return;
+        }
+
+        // Different tables means the same pair can sit at a different index, so each value has to be found by its key.
+        for (std::size_t i = 0; i < other._values.size(); i++) {
+            std::size_t index = GetIndex(other.GetKey(i));
+            if (index < _values.size()) {
+                SetValue(other.GetKey(i), Combine(_values[index], other._values[i], isSubtracting));
+            }
+        }
+    }
+
+    // Every value type stored in a matrix must be instantiated here.
+    template class DamageTypeInclinationMatrix<DamageResistanceValue>;
+    template class DamageTypeInclinationMatrix<DamageSourceValue>;
+}
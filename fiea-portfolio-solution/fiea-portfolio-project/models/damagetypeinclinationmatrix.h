@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <map>
+#include <span>
+#include <vector>
+#include "../store/lovindextable.h"
+#include "damageinclination.h"
+#include "damagetype.h"
+#include "lovpairs.h"
+
+namespace AWE {
+    /// <summary>
+    /// Values for every damage type and inclination pair, stored as one flat array with a row per damage type and a column per inclination. Rows and columns are the LOVIndex of the type and inclination.
+    /// Each row's sum is kept up to date as values change, with negative values counted as 0.
+    /// Pairs which are not in the matrix's index tables cannot be stored, and always read as 0.
+    /// </summary>
+    template <typename T>
+    class DamageTypeInclinationMatrix {
+    private:
+        const LOVIndexTable<DamageType>* _types;
+        const LOVIndexTable<DamageInclination>* _inclinations;
+        std::vector<T> _values;
+        std::vector<long> _rowSums;
+        long _total;
+
+        /// <returns>Value as it counts towards the row sums.</returns>
+        static long Summand(T);
+        /// <returns>Sum or difference of the given values. If T is unsigned, a difference below 0 is clamped to 0 instead of wrapping.</returns>
+        static T Combine(T value, T other, bool isSubtracting);
+        /// <summary>
+        /// Adds or subtracts every value of the given matrix to or from the value of the same pair in this one.
+        /// </summary>
+        void Accumulate(const DamageTypeInclinationMatrix&, bool isSubtracting);
+
+    public:
+        /// <summary>
+        /// Default constructor. Initializes a matrix with no index tables, which holds no values.
+        /// </summary>
+        DamageTypeInclinationMatrix();
+        /// <summary>
+        /// Constructor. Initializes every pair of the given tables to the given value.
+        /// </summary>
+        /// <param name="types">Index table of the damage types, usually GameLOVStorage::damageTypeIndices(). Must outlive the matrix.</param>
+        /// <param name="inclinations">Index table of the damage inclinations, usually GameLOVStorage::damageInclinationIndices(). Must outlive the matrix.</param>
+        DamageTypeInclinationMatrix(const LOVIndexTable<DamageType>& types, const LOVIndexTable<DamageInclination>& inclinations, T value = T());
+        /// <summary>
+        /// Constructor. Initializes every pair of the given tables, copying the values which are in the given map and setting the rest to 0. The map is not modified.
+        /// </summary>
+        DamageTypeInclinationMatrix(const LOVIndexTable<DamageType>& types, const LOVIndexTable<DamageInclination>& inclinations, const std::map<DamageTypeInclination, T, DamageTypeInclination_comp>&);
+
+        /// <returns>const pointer to the index table of the rows, or nullptr if the matrix has none.</returns>
+        const LOVIndexTable<DamageType>* types() const;
+        /// <returns>const pointer to the index table of the columns, or nullptr if the matrix has none.</returns>
+        const LOVIndexTable<DamageInclination>* inclinations() const;
+        /// <returns>Number of rows, which is the number of damage types.</returns>
+        std::size_t rowCount() const;
+        /// <returns>Number of columns, which is the number of damage inclinations.</returns>
+        std::size_t columnCount() const;
+        /// <returns>Every value, row by row.</returns>
+        std::span<const T> values() const;
+        /// <returns>Sum of every row, with negative values counted as 0.</returns>
+        long total() const;
+
+        /// <returns>Index of the given pair's value in values(), or values().size() if the matrix has no such pair.</returns>
+        std::size_t GetIndex(DamageTypeInclination) const;
+        /// <returns>Type and inclination of the value at the given index of values(). The index must be in range.</returns>
+        DamageTypeInclination GetKey(std::size_t) const;
+        /// <returns>Value of the given row and column, or 0 if either is out of range.</returns>
+        T GetValue(LOVIndex dmgtype, LOVIndex inclination) const;
+        /// <returns>Value of the given pair, or 0 if the matrix has no such pair.</returns>
+        T GetValue(DamageTypeInclination) const;
+        /// <returns>Sum of the given row, with negative values counted as 0. Returns 0 if the row is out of range.</returns>
+        long GetRowSum(LOVIndex dmgtype) const;
+
+        /// <summary>
+        /// Sets the value of the given pair. Does nothing if the matrix has no such pair.
+        /// </summary>
+        /// <returns>New value of the given pair. Note this does not return the old value.</returns>
+        T SetValue(DamageTypeInclination, T);
+        /// <summary>
+        /// Adds the given value to the current value of the given pair. Does nothing if the matrix has no such pair.
+        /// </summary>
+        /// <returns>New value of the given pair after the addition.</returns>
+        T AddValue(DamageTypeInclination, T);
+        /// <summary>
+        /// Adds every value of the given matrix to the value of the same pair in this one. If both matrices use the same index tables, this is one pass over two flat arrays.
+        /// Pairs this matrix does not have are ignored.
+        /// </summary>
+        void AddValues(const DamageTypeInclinationMatrix&);
+        /// <summary>
+        /// Subtracts every value of the given matrix from the value of the same pair in this one, reversing AddValues with the same matrix.
+        /// If T is unsigned, values are clamped at 0 rather than wrapping, so the reversal is only exact if no value was lowered below the added amount in between.
+        /// Pairs this matrix does not have are ignored.
+        /// </summary>
+        void SubtractValues(const DamageTypeInclinationMatrix&);
+    };
+}
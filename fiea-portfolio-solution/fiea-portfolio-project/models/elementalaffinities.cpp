@@ -1,61 +1,121 @@
 #include "elementalaffinities.h"
+#include <algorithm>
 
 namespace AWE {
-    ElementalAffinities::ElementalAffinities() : _map(ElementalAffinityMap()) {}
-    ElementalAffinities::ElementalAffinities(ElementalAffinityMap& map) : _map(ElementalAffinityMap(map)) {}
-    ElementalAffinities::ElementalAffinities(const SkillElementMap& elements, const DamageTypeMap& dmgtypes) : _map(ElementalAffinityMap()) {
-        for (const SkillElementMap::value_type& element : elements) {
-            for (const DamageTypeMap::value_type& dmgtype : dmgtypes) {
-                _map.insert(std::make_pair(ElementalAffinityKey(element.first, dmgtype.first), 0));
+    ElementalAffinities::ElementalAffinities() : _elements(nullptr), _types(nullptr), _groups(nullptr) {}
+
+    ElementalAffinities::ElementalAffinities(const LOVIndexTable<SkillElement>& elements, const LOVIndexTable<DamageType>& dmgtypes, const LOVIndexTable<SkillElementGroup>& groups)
+        : _elements(&elements)
+        , _types(&dmgtypes)
+        , _groups(&groups)
+        , _values(elements.size() * dmgtypes.size(), 0)
+        , _elementTotals(elements.size(), 0)
+        , _groupTypeSums(groups.size() * dmgtypes.size(), 0)
+        , _groupTotals(groups.size(), 0) {
+        auto memberships = std::make_shared<GroupMemberships>();
+        std::vector<std::vector<GroupMemberships::Entry>> rows(elements.size());
+
+        for (std::size_t g = 0; g < groups.size(); g++) {
+            for (const SkillElement_shptr& element : *groups.GetValue(static_cast<LOVIndex>(g))) {
+                LOVIndex e = elements.GetIndex(element->abrvlong());
+                if (e >= elements.size()) {
+                    continue;
+                }
+
+                std::vector<GroupMemberships::Entry>& row = rows[e];
+                if (!row.empty() && row.back().group == g) {
+                    row.back().count++;
+                } else {
+                    row.push_back({ static_cast<LOVIndex>(g), 1 });
+                }
             }
         }
+
+        memberships->offsets.reserve(rows.size() + 1);
+        memberships->offsets.push_back(0);
+        for (const std::vector<GroupMemberships::Entry>& row : rows) {
+            memberships->entries.insert(memberships->entries.end(), row.begin(), row.end());
+            memberships->offsets.push_back(memberships->entries.size());
+        }
+
+        _memberships = std::move(memberships);
     }
-    ElementalAffinities::ElementalAffinities(const SkillElementMap& elements, const DamageTypeMap& dmgtypes, const ElementalAffinityMap& values) : _map(ElementalAffinityMap()) {
-        for (const SkillElementMap::value_type& element : elements) {
-            for (const DamageTypeMap::value_type& dmgtype : dmgtypes) {
-                auto key = ElementalAffinityKey(element.first, dmgtype.first);
-                _map.insert(std::make_pair(key, values.contains(key) ? values.at(key) : 0));
-            }
+
+    ElementalAffinities::ElementalAffinities(const LOVIndexTable<SkillElement>& elements, const LOVIndexTable<DamageType>& dmgtypes, const LOVIndexTable<SkillElementGroup>& groups, const ElementalAffinityMap& values)
+        : ElementalAffinities(elements, dmgtypes, groups) {
+        for (const ElementalAffinityMap::value_type& value : values) {
+            SetValue(value.first, value.second);
         }
     }
 
+    std::size_t ElementalAffinities::GetIndex(SkillElementKey element, DamageTypeKey dmgtype) const {
+        if (!_elements || !_types) {
+            return _values.size();
+        }
+
+        LOVIndex e = _elements->GetIndex(element);
+        LOVIndex t = _types->GetIndex(dmgtype);
+        if (e >= _elements->size() || t >= _types->size()) {
+            return _values.size();
+        }
+
+        return (static_cast<std::size_t>(e) * _types->size()) + t;
+    }
+
+    LOVIndex ElementalAffinities::GetGroupIndex(const SkillElementGroup_shptr& elegroup) const {
+        // A group which only shares its key with a stored group still has to be summed by hand, since its elements may differ.
+        LOVIndex g = _groups->GetIndex(elegroup->abrvlong());
+        return (g < _groups->size() && _groups->GetValue(g) == elegroup) ? g : static_cast<LOVIndex>(_groups->size());
+    }
+
     ElementalAffinityValue ElementalAffinities::SetValue(ElementalAffinityKey key, ElementalAffinityValue value) {
-        auto found = _map.find(key);
-        if (found == _map.end()) {
-            _map.insert(std::make_pair(key, value));
-        } else {
-            found->second = value;
+        std::size_t index = GetIndex(key.first, key.second);
+        if (index >= _values.size()) {
+            return value;
+        }
+
+        ElementalAffinityValue delta = value - _values[index];
+        _values[index] = value;
+
+        std::size_t typeCount = _types->size();
+        std::size_t element = index / typeCount;
+        std::size_t dmgtype = index % typeCount;
+        _elementTotals[element] += delta;
+
+        for (std::size_t m = _memberships->offsets[element]; m < _memberships->offsets[element + 1]; m++) {
+            const GroupMemberships::Entry& membership = _memberships->entries[m];
+            _groupTypeSums[(static_cast<std::size_t>(membership.group) * typeCount) + dmgtype] += delta * membership.count;
+            _groupTotals[membership.group] += delta;
         }
 
         return value;
     }
 
     ElementalAffinityValue ElementalAffinities::AddValue(ElementalAffinityKey key, ElementalAffinityValue value) {
-        ElementalAffinityValue newval = value;
-
-        auto found = _map.find(key);
-        if (found == _map.end()) {
-            _map.insert(std::make_pair(key, value));
-        } else {
-            newval += found->second;
-            found->second = newval;
+        std::size_t index = GetIndex(key.first, key.second);
+        if (index >= _values.size()) {
+            return value;
         }
 
-        return newval;
+        return SetValue(key, _values[index] + value);
     }
 
-    const ElementalAffinityMap& ElementalAffinities::map() const { return _map; }
-
     ElementalAffinityValue ElementalAffinities::GetValue(SkillElementKey element, DamageTypeKey dmgtype) const {
-        auto key = ElementalAffinityKey(element, dmgtype);
-        return _map.contains(key) ? _map.at(key) : 0;
+        std::size_t index = GetIndex(element, dmgtype);
+        return (index < _values.size()) ? _values[index] : 0;
     }
 
     ElementalAffinityValue ElementalAffinities::GetValue(const SkillElementGroup_shptr& elegroup, DamageTypeKey dmgtype) const {
-        if (!elegroup->IsValid()) {
+        if (!elegroup->IsValid() || !_groups) {
             return 0;
         }
 
+        LOVIndex g = GetGroupIndex(elegroup);
+        if (g < _groups->size()) {
+            LOVIndex t = _types->GetIndex(dmgtype);
+            return (t < _types->size()) ? _groupTypeSums[(static_cast<std::size_t>(g) * _types->size()) + t] : 0;
+        }
+
         ElementalAffinityValue sum = 0;
 
         for (const SkillElement_shptr& ele : *elegroup) {
@@ -66,31 +126,32 @@ namespace AWE {
     }
 
     ElementalAffinityValue ElementalAffinities::GetValue(SkillElementKey element) const {
-        ElementalAffinityValue sum = 0;
-
-        for (const ElementalAffinityMap::value_type& itr : _map) {
-            if (itr.first.first == element) {
-                sum += itr.second;
-            }
+        if (!_elements) {
+            return 0;
         }
 
-        return sum;
+        LOVIndex e = _elements->GetIndex(element);
+        return (e < _elements->size()) ? _elementTotals[e] : 0;
     }
 
     ElementalAffinityValue ElementalAffinities::GetValue(const SkillElementGroup_shptr& elegroup) const {
-        if (!elegroup->IsValid()) {
+        if (!elegroup->IsValid() || !_groups) {
             return 0;
         }
 
-        SkillElementList elements = std::move(elegroup->elements());
+        LOVIndex g = GetGroupIndex(elegroup);
+        if (g < _groups->size()) {
+            return _groupTotals[g];
+        }
+
+        // Each element counts once, even if the group lists it more than once.
+        const SkillElementList& elements = elegroup->elements();
         ElementalAffinityValue sum = 0;
 
-        for (ElementalAffinityMap::value_type itr : _map) {
-            for (const SkillElement_shptr& element : elements) {
-                if (itr.first.first == element->abrvlong()) {
-                    sum += itr.second;
-                    break;
-                }
+        for (auto itr = elements.begin(); itr != elements.end(); itr++) {
+            ABRV_long key = (*itr)->abrvlong();
+            if (std::none_of(elements.begin(), itr, [key](const SkillElement_shptr& prev) { return prev->abrvlong() == key; })) {
+                sum += GetValue(key);
             }
         }
 
@@ -99,14 +160,17 @@ namespace AWE {
 
     // iterator
 
-    ElementalAffinities::const_iterator::const_iterator(const ElementalAffinityMap& map) : _itr(std::begin(map)) {}
-    ElementalAffinities::const_iterator::const_iterator(const ElementalAffinityMap::const_iterator& itr) : _itr(itr) {}
+    ElementalAffinities::const_iterator::const_iterator(const ElementalAffinities& affinities, std::size_t index) : _affinities(&affinities), _index(index) {}
+
+    ElementalAffinities::const_iterator::reference ElementalAffinities::const_iterator::operator*() const {
+        std::size_t typeCount = _affinities->_types->size();
+        ElementalAffinityKey key(_affinities->_elements->GetKey(static_cast<LOVIndex>(_index / typeCount)), _affinities->_types->GetKey(static_cast<LOVIndex>(_index % typeCount)));
+        return value_type(key, _affinities->_values[_index]);
+    }
 
-    ElementalAffinities::const_iterator::reference ElementalAffinities::const_iterator::operator*() const { return _itr.operator*(); }
-    ElementalAffinities::const_iterator::pointer ElementalAffinities::const_iterator::operator->() { return _itr.operator->(); }
-    ElementalAffinities::const_iterator& ElementalAffinities::const_iterator::operator++() { _itr++; return *this; }
+    ElementalAffinities::const_iterator& ElementalAffinities::const_iterator::operator++() { _index++; return *this; }
     ElementalAffinities::const_iterator ElementalAffinities::const_iterator::operator++(int) { const_iterator prev = *this; this->operator++(); return prev; }
 
-    ElementalAffinities::const_iterator ElementalAffinities::begin() const { return const_iterator(_map); }
-    ElementalAffinities::const_iterator ElementalAffinities::end() const { return const_iterator(std::end(_map)); }
+    ElementalAffinities::const_iterator ElementalAffinities::begin() const { return const_iterator(*this, 0); }
+    ElementalAffinities::const_iterator ElementalAffinities::end() const { return const_iterator(*this, _values.size()); }
 }
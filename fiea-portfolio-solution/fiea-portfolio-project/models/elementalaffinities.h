@@ -1,5 +1,11 @@
 #pragma once
+#include <cstddef>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "../store/lovindextable.h"
 #include "damagetype.h"
 #include "skillelement.h"
 #include "skillelementgroup.h"
@@ -27,43 +33,71 @@ namespace AWE {
     /// Represents a battler's affinities to specific types of elemental damage. Note that "types of elemental damage" here actually means
     /// element-type pairs, e.g. sword slashing, wand arcane, etc.
     /// Also note that ElementalAffinityValue is not unsigned - there can be negative affinities.
+    /// Every pair of the loaded elements and damage types is stored densely, and the sums per element and per element group are kept up to date as affinities change,
+    /// so every GetValue overload is a lookup rather than a scan.
     /// </summary>
     class ElementalAffinities {
     private:
-        ElementalAffinityMap _map;
+        /// <summary>
+        /// Which groups each element belongs to, in compressed rows: the memberships of element e are entries[offsets[e]] up to entries[offsets[e + 1]].
+        /// Only depends on the index tables, so every copy of an object shares one.
+        /// </summary>
+        struct GroupMemberships {
+            struct Entry {
+                LOVIndex group;
+                /// <summary>
+                /// Number of times the element appears in the group's element list. A group of groups can list the same element more than once.
+                /// </summary>
+                ElementalAffinityValue count;
+            };
+
+            std::vector<std::size_t> offsets;
+            std::vector<Entry> entries;
+        };
+
+        const LOVIndexTable<SkillElement>* _elements;
+        const LOVIndexTable<DamageType>* _types;
+        const LOVIndexTable<SkillElementGroup>* _groups;
+        std::shared_ptr<const GroupMemberships> _memberships;
+        std::vector<ElementalAffinityValue> _values;
+        std::vector<ElementalAffinityValue> _elementTotals;
+        std::vector<ElementalAffinityValue> _groupTypeSums;
+        std::vector<ElementalAffinityValue> _groupTotals;
+
+        /// <returns>Index of the given pair's value in _values, or _values.size() if this object has no such pair.</returns>
+        std::size_t GetIndex(SkillElementKey, DamageTypeKey) const;
+        /// <returns>Index of the given group in the group table, or the size of the table if it is not there. The object must have index tables.</returns>
+        LOVIndex GetGroupIndex(const SkillElementGroup_shptr&) const;
 
         /// <summary>
-        /// Sets the value of the given affinity. The given affinity will be created if it did not exist.
+        /// Sets the value of the given affinity. Does nothing if the affinity's element or damage type is not in the index tables.
         /// </summary>
         /// <returns>New value of the given affinity. Note this does not return the old value.</returns>
         ElementalAffinityValue SetValue(ElementalAffinityKey, ElementalAffinityValue);
         /// <summary>
-        /// Adds the given value to the current value of the given affinity. Value can be negative. The given affinity will be created if it did not exist.
+        /// Adds the given value to the current value of the given affinity. Value can be negative. Does nothing if the affinity's element or damage type is not in the index tables.
         /// </summary>
         /// <returns>New value of the given affinity after the addition.</returns>
         ElementalAffinityValue AddValue(ElementalAffinityKey, ElementalAffinityValue);
 
         friend class Battler;
         friend class BattlerInstance;
+        friend class BattlerProgressionTransaction;
 
     public:
-        ElementalAffinities();
         /// <summary>
-        /// Constructor.
+        /// Default constructor. Initializes an object with no index tables, which holds no affinities.
         /// </summary>
-        /// <param name="">Map to use for affinities. Note this parameter is moved into the initialized object.</param>
-        ElementalAffinities(ElementalAffinityMap&);
+        ElementalAffinities();
         /// <summary>
         /// Constructor. Initializes affinities for all elements and damage types given, and sets them to 0.
         /// </summary>
-        ElementalAffinities(const SkillElementMap&, const DamageTypeMap&);
+        /// <param name="">Index tables of the skill elements, damage types and element groups, usually from GameLOVStorage. All of them must outlive the object.</param>
+        ElementalAffinities(const LOVIndexTable<SkillElement>&, const LOVIndexTable<DamageType>&, const LOVIndexTable<SkillElementGroup>&);
         /// <summary>
-        /// Constructor. Initializes affinities for all elements and damage types given, and copies their values from the given map. None of the given maps are modified.
+        /// Constructor. Initializes affinities for all elements and damage types given, and copies their values from the given map. None of the given objects are modified.
         /// </summary>
-        ElementalAffinities(const SkillElementMap&, const DamageTypeMap&, const ElementalAffinityMap&);
-
-        /// <returns>const reference to the internal map.</returns>
-        const ElementalAffinityMap& map() const;
+        ElementalAffinities(const LOVIndexTable<SkillElement>&, const LOVIndexTable<DamageType>&, const LOVIndexTable<SkillElementGroup>&, const ElementalAffinityMap&);
 
         /// <returns>Value of the affinity for the given skill element and damage type.</returns>
         ElementalAffinityValue GetValue(SkillElementKey, DamageTypeKey) const;
@@ -74,32 +108,34 @@ namespace AWE {
         /// <returns>Total sum value of all affinities for each skill element in the given group.</returns>
         ElementalAffinityValue GetValue(const SkillElementGroup_shptr&) const;
 
+        /// <summary>
+        /// Iterates every affinity in element, then damage type order. Affinities are stored densely, so the iterator yields each pair by value.
+        /// </summary>
         class const_iterator {
         public:
             using iterator_category = std::input_iterator_tag;
-            using value_type = ElementalAffinityMap::value_type;
-            using difference_type = ElementalAffinityMap::difference_type;
-            using pointer = ElementalAffinityMap::const_pointer;
-            using reference = ElementalAffinityMap::const_reference;
+            using value_type = std::pair<const ElementalAffinityKey, ElementalAffinityValue>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
 
-            const_iterator(const ElementalAffinityMap&);
-            const_iterator(const ElementalAffinityMap::const_iterator&);
+            const_iterator(const ElementalAffinities&, std::size_t index);
 
             reference operator*() const;
-            pointer operator->();
             const_iterator& operator++();
             const_iterator operator++(int);
 
-            friend bool operator==(const const_iterator& it1, const const_iterator& it2) { return it1._itr == it2._itr; }
-            friend bool operator!=(const const_iterator& it1, const const_iterator& it2) { return it1._itr != it2._itr; }
+            friend bool operator==(const const_iterator& it1, const const_iterator& it2) { return it1._index == it2._index; }
+            friend bool operator!=(const const_iterator& it1, const const_iterator& it2) { return it1._index != it2._index; }
 
         private:
-            ElementalAffinityMap::const_iterator _itr;
+            const ElementalAffinities* _affinities;
+            std::size_t _index;
         };
 
         /// <returns>const iterator to the first affinity value pair in this object.</returns>
         const_iterator begin() const;
-        /// <returns>const iterator to the spot in memory behind the last affinity value pair in this object. Attempting access from this address will result in undefined behavior.</returns>
+        /// <returns>const iterator to the spot behind the last affinity value pair in this object. Attempting to dereference it will result in undefined behavior.</returns>
         const_iterator end() const;
     };
 }
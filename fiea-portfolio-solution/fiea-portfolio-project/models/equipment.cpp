@@ -6,7 +6,7 @@ namespace AWE {
     Equipment::Equipment(
         std::string name,
         DamageResistances& bonusResistances,
-        DamageSourceMap& damageSources,
+        DamageSourceMatrix& damageSources,
         EquipmentType_shptr equipmentType,
         const SkillMap& skillPossibilities,
         BattlerStatValues& bonusStats,
@@ -18,7 +18,7 @@ namespace AWE {
             , _damageSources(std::move(damageSources))
             , _equipmentType(std::move(equipmentType))
             , _conversions(std::move(conversions))
-            , _skills(std::vector<Skill_shptr>()) {
+            , _skills(SkillMap()) {
         for (const SkillMap::value_type& skillPossibility : skillPossibilities) {
             bool add = true;
             const std::set<SkillElementGroupKey>& skillElementGroups = skillPossibility.second->elementGroups();
@@ -30,7 +30,7 @@ namespace AWE {
             }
 
             if (add) {
-                _skills.push_back(skillPossibility.second);
+                _skills.insert(skillPossibility);
             }
         }
     }
@@ -40,9 +40,10 @@ namespace AWE {
     const std::string& Equipment::name() const { return _name; }
     const BattlerStatValues& Equipment::bonusStats() const { return _bonusStats; }
     const DamageResistances& Equipment::bonusResistances() const { return _bonusResistances; }
-    const DamageSourceMap& Equipment::damageSources() const { return _damageSources; }
+    const DamageSourceMatrix& Equipment::damageSources() const { return _damageSources; }
     const EquipmentType_shptr& Equipment::equipmentType() const { return _equipmentType; }
-    const std::vector<Skill_shptr>& Equipment::skills() const { return _skills; }
+    const SkillMap& Equipment::skills() const { return _skills; }
+    const SkillElementGroupConversionMap& Equipment::conversions() const { return _conversions; }
 
     BattlerStatValue Equipment::GetBonusStat(BattlerStatKey key) const {
         BattlerStatValue val = 0;
@@ -55,16 +56,7 @@ namespace AWE {
         return val;
     }
 
-    DamageSourceValue Equipment::GetDamageSourceValue(DamageTypeInclination key) const {
-        DamageSourceValue val = 0;
-        auto found = _damageSources.find(key);
-
-        if (found != _damageSources.end()) {
-            val = found->second;
-        }
-
-        return val;
-    }
+    DamageSourceValue Equipment::GetDamageSourceValue(DamageTypeInclination key) const { return _damageSources.GetValue(key); }
 
     DamageSourceValue Equipment::GetDamageSourceValue(const DamageType& dmgtype, const DamageInclination& inclination) const { return GetDamageSourceValue(DamageTypeInclination(dmgtype.abrvlong(), inclination.abrvlong())); }
 
@@ -20,10 +20,10 @@ namespace AWE {
         std::string _name;
         BattlerStatValues _bonusStats;
         DamageResistances _bonusResistances;
-        DamageSourceMap _damageSources;
+        DamageSourceMatrix _damageSources;
         EquipmentType_shptr _equipmentType;
         SkillElementGroupConversionMap _conversions;
-        std::vector<Skill_shptr> _skills;
+        SkillMap _skills;
 
     public:
         /// <summary>
@@ -44,7 +44,7 @@ namespace AWE {
         Equipment(
             std::string name,
             DamageResistances& bonusResistances,
-            DamageSourceMap& damageSources,
+            DamageSourceMatrix& damageSources,
             EquipmentType_shptr equipmentType,
             const SkillMap& skillPossibilities,
             BattlerStatValues& bonusStats,
@@ -63,11 +63,13 @@ namespace AWE {
         /// <returns>Bonus damage resistances the equipped battler gains from this equipment.</returns>
         const DamageResistances& bonusResistances() const;
         /// <returns>Damage sources this equipment provides.</returns>
-        const DamageSourceMap& damageSources() const;
+        const DamageSourceMatrix& damageSources() const;
         /// <returns>Bonus stats the equipped battler gains from this equipment.</returns>
         const EquipmentType_shptr& equipmentType() const;
         /// <returns>Bonus stats the equipped battler gains from this equipment.</returns>
-        const std::vector<Skill_shptr>& skills() const;
+        const SkillMap& skills() const;
+        /// <returns>Conversions this equipment provides, from skill element group to the skill element it becomes.</returns>
+        const SkillElementGroupConversionMap& conversions() const;
 
         /// <returns>This equipment's value of the given bonus stat, or 0 if this equipment has no such bonus stat.</returns>
         BattlerStatValue GetBonusStat(BattlerStatKey) const;
@@ -82,13 +84,13 @@ namespace AWE {
     };
 
     /// <summary>
-    /// Used to index Equipment into a map. Currently designed to be a string which should be equivalent to the equipment's name.
+    /// Used to index Equipment into a map. The equipment's name, interned by the XLO storage's symbol table.
     /// </summary>
-    typedef std::string EquipmentKey;
+    typedef SymbolID EquipmentKey;
     /// <summary>
     /// Represents information about equipment.
     /// </summary>
     typedef std::shared_ptr<Equipment> Equipment_shptr;
-    typedef std::map<EquipmentKey, Equipment_shptr> EquipmentMap;
+    typedef SymbolMap<Equipment> EquipmentMap;
     typedef std::vector<Equipment_shptr> EquipmentList;
 }
@@ -1,72 +1,105 @@
 #include "equipmentslots.h"
+#include <algorithm>
+#include <bit>
 
 namespace AWE {
-    EquipmentSlots::EquipmentSlots() : _map(EquipmentSlotMap()) {}
-    EquipmentSlots::EquipmentSlots(EquipmentSlotMap& map) : _map(std::move(map)) {}
-    EquipmentSlots::EquipmentSlots(EquipmentTypeCountMap& schema) : _map(EquipmentSlotMap()), _counts(std::move(schema)) {
-        for (EquipmentTypeCountMap::value_type count : _counts) {
+    EquipmentSlots::EquipmentSlots() : _offsets(1, 0), _occupied(0) {}
+    EquipmentSlots::EquipmentSlots(const EquipmentSlotMap& map) : EquipmentSlots() {
+        // The map is ordered by type, then index, which is the same order the slots are laid out in.
+        for (const EquipmentSlotMap::value_type& slot : map) {
+            AddSlot(slot.first.first, slot.second);
+        }
+    }
+    EquipmentSlots::EquipmentSlots(const EquipmentTypeCountMap& schema) : EquipmentSlots() {
+        for (const EquipmentTypeCountMap::value_type& count : schema) {
             for (unsigned int i = 1; i <= count.second; i++) {
-                _map.insert(std::make_pair(EquipmentSlotKey(count.first, i), Equipment_shptr()));
+                AddSlot(count.first);
             }
         }
     }
 
     const EquipmentSlotKey EquipmentSlots::INVALID_KEY = EquipmentSlotKey(0, 0);
 
-    const EquipmentSlotMap& EquipmentSlots::map() const { return _map; }
+    std::span<const Equipment_shptr> EquipmentSlots::slots() const { return std::span<const Equipment_shptr>(_slots); }
+    EquipmentSlotMask EquipmentSlots::occupied() const { return _occupied; }
+
+    std::size_t EquipmentSlots::FindType(EquipmentTypeKey eqtype) const {
+        auto found = std::lower_bound(_types.begin(), _types.end(), eqtype);
+        return (found != _types.end() && *found == eqtype) ? static_cast<std::size_t>(found - _types.begin()) : _types.size();
+    }
+
+    std::size_t EquipmentSlots::FindSlot(EquipmentSlotKey key) const {
+        std::size_t type = FindType(key.first);
+        if (type >= _types.size() || key.second < 1 || key.second > _offsets[type + 1] - _offsets[type]) {
+            return _slots.size();
+        }
+
+        return _offsets[type] + key.second - 1;
+    }
+
+    EquipmentSlotMask EquipmentSlots::GetTypeMask(std::size_t type) const {
+        std::size_t count = _offsets[type + 1] - _offsets[type];
+        EquipmentSlotMask bits = (count >= CAPACITY) ? ~EquipmentSlotMask(0) : ((EquipmentSlotMask(1) << count) - 1);
+        return bits << _offsets[type];
+    }
+
+    EquipmentSlotKey EquipmentSlots::GetKey(std::size_t type, std::size_t slot) const { return EquipmentSlotKey(_types[type], static_cast<EquipmentSlotIndex>(slot - _offsets[type] + 1)); }
+
+    void EquipmentSlots::RefreshOccupied() {
+        _occupied = 0;
+        for (std::size_t i = 0; i < _slots.size(); i++) {
+            if (_slots[i]) {
+                _occupied |= EquipmentSlotMask(1) << i;
+            }
+        }
+    }
 
     EquipmentSlotKey EquipmentSlots::AddSlot(EquipmentTypeKey eqtype) { return AddSlot(eqtype, Equipment_shptr()); }
     EquipmentSlotKey EquipmentSlots::AddSlot(Equipment_shptr equipment) { return (equipment && equipment->equipmentType()) ? AddSlot(equipment->equipmentType()->abrvlong(), equipment) : INVALID_KEY; }
     EquipmentSlotKey EquipmentSlots::AddSlot(EquipmentTypeKey eqtype, Equipment_shptr equipment) {
-        int newcount = 1;
-        auto found = _counts.find(eqtype);
-        if (found == _counts.end()) {
-            _counts.insert(std::make_pair(eqtype, newcount));
-        } else {
-            newcount = found->second + 1;
-            found->second = newcount;
+        if (_slots.size() >= CAPACITY) {
+            return INVALID_KEY;
+        }
+
+        std::size_t type = FindType(eqtype);
+        if (type >= _types.size()) {
+            type = static_cast<std::size_t>(std::lower_bound(_types.begin(), _types.end(), eqtype) - _types.begin());
+            _types.insert(_types.begin() + type, eqtype);
+            _offsets.insert(_offsets.begin() + type + 1, _offsets[type]);
         }
 
-        EquipmentSlotKey newSlotKey = EquipmentSlotKey(eqtype, newcount);
-        _map.insert(std::make_pair(newSlotKey, (equipment && equipment->equipmentType() && eqtype == equipment->equipmentType()->abrvlong()) ? std::move(equipment) : Equipment_shptr()));
-        return newSlotKey;
+        // The new slot goes at the end of its type's range, so every later type moves up by one.
+        std::size_t slot = _offsets[type + 1];
+        _slots.insert(_slots.begin() + slot, (equipment && equipment->equipmentType() && eqtype == equipment->equipmentType()->abrvlong()) ? std::move(equipment) : Equipment_shptr());
+        for (std::size_t t = type + 1; t < _offsets.size(); t++) {
+            _offsets[t]++;
+        }
+
+        RefreshOccupied();
+        return GetKey(type, slot);
     }
 
     Equipment_shptr EquipmentSlots::RemoveSlot(EquipmentTypeKey eqtype, EquipmentSlotIndex index) { return RemoveSlot(EquipmentSlotKey(eqtype, index)); }
     Equipment_shptr EquipmentSlots::RemoveSlot(EquipmentSlotKey key) {
-        Equipment_shptr removed;
-
-        auto itr = _map.find(key);
-        if (itr != _map.end()) {
-            removed = std::move(itr->second);
-
-            int count = _counts.at(key.first);
-            if (count != key.second) {
-                for (int i = key.second; i < count; i++) {
-                    itr = _map.find(EquipmentSlotKey(key.first, i + 1));
-                    _map.find(EquipmentSlotKey(key.first, i))->second = std::move(itr->second);
-                }
-            }
+        std::size_t slot = FindSlot(key);
+        if (slot >= _slots.size()) {
+            return Equipment_shptr();
+        }
 
-            _map.erase(itr);
-            _counts.find(key.first)->second -= 1;
+        // Later slots of the same type move down by one, the same as every slot of every later type.
+        Equipment_shptr removed = std::move(_slots[slot]);
+        _slots.erase(_slots.begin() + slot);
+        for (std::size_t t = FindType(key.first) + 1; t < _offsets.size(); t++) {
+            _offsets[t]--;
         }
 
+        RefreshOccupied();
         return removed;
     }
 
     Equipment_shptr EquipmentSlots::RemoveSlot(EquipmentTypeKey eqtype) {
-        Equipment_shptr removed;
-
-        auto found = _counts.find(eqtype);
-        if (found != _counts.end()) {
-            auto key = EquipmentSlotKey(eqtype, found->second);
-            removed = std::move(_map.at(key));
-            _map.erase(_map.find(key));
-            found->second -= 1;
-        }
-
-        return removed;
+        int count = GetCount(eqtype);
+        return (count > 0) ? RemoveSlot(EquipmentSlotKey(eqtype, count)) : Equipment_shptr();
     }
 
     Equipment_shptr EquipmentSlots::Equip(EquipmentSlotIndex index, Equipment_shptr equipment) {
@@ -74,14 +107,14 @@ namespace AWE {
             return Equipment_shptr();
         }
 
-        EquipmentSlotKey key = EquipmentSlotKey(equipment->equipmentType()->abrvlong(), index);
-        auto found = _map.find(key);
-        if (found == _map.end()) {
+        std::size_t slot = FindSlot(EquipmentSlotKey(equipment->equipmentType()->abrvlong(), index));
+        if (slot >= _slots.size()) {
             return Equipment_shptr();
         }
 
-        Equipment_shptr unequipped = std::move(found->second);
-        found->second = std::move(equipment);
+        Equipment_shptr unequipped = std::move(_slots[slot]);
+        _slots[slot] = std::move(equipment);
+        _occupied |= EquipmentSlotMask(1) << slot;
         return unequipped;
     }
 
@@ -103,8 +136,8 @@ namespace AWE {
         Equipment_shptr unequipped;
 
         EquipmentTypeKey eqtype = equipment->equipmentType()->abrvlong();
-        auto count = _counts.find(eqtype);
-        if (count == _counts.end() || (!FindFirstEmptySlot(eqtype, newkey) && (maxCountToAdd < 0 || static_cast<int>(count->second) < maxCountToAdd))) {
+        bool hasType = FindType(eqtype) < _types.size();
+        if (!hasType || (!FindFirstEmptySlot(eqtype, newkey) && (maxCountToAdd < 0 || GetCount(eqtype) < maxCountToAdd))) {
             newkey = AddSlot(equipment);
         } else {
             unequipped = newkey.first == INVALID_KEY.first ? Equip(equipment, newkey) : Equip(newkey.second, equipment);
@@ -114,94 +147,119 @@ namespace AWE {
     }
 
     Equipment_shptr EquipmentSlots::Unequip(EquipmentTypeKey eqtype) {
-        auto countfound = _counts.find(eqtype);
-        if (countfound == _counts.end()) {
+        std::size_t type = FindType(eqtype);
+        if (type >= _types.size()) {
             return Equipment_shptr();
         }
 
-        Equipment_shptr unequipped;
-
-        for (EquipmentSlotIndex i = countfound->second; i >= 0; i--) {
-            auto key = EquipmentSlotKey(eqtype, i);
-            auto slotfound = _map.find(key);
-            if (slotfound != _map.end() && slotfound->second) {
-                return Unequip(key);
-            }
+        EquipmentSlotMask filled = GetTypeMask(type) & _occupied;
+        if (filled == 0) {
+            return Equipment_shptr();
         }
 
-        return unequipped;
+        std::size_t slot = (CAPACITY - 1) - static_cast<std::size_t>(std::countl_zero(filled));
+        return Unequip(GetKey(type, slot));
     }
 
     Equipment_shptr EquipmentSlots::Unequip(EquipmentTypeKey eqtype, EquipmentSlotIndex index) { return Unequip(EquipmentSlotKey(eqtype, index)); }
     Equipment_shptr EquipmentSlots::Unequip(EquipmentSlotKey key) {
-        auto found = _map.find(key);
-        if (found == _map.end()) {
+        std::size_t slot = FindSlot(key);
+        if (slot >= _slots.size()) {
             return Equipment_shptr();
         }
 
-        Equipment_shptr unequipped = std::move(found->second);
-        found->second.reset();
+        Equipment_shptr unequipped = std::move(_slots[slot]);
+        _slots[slot].reset();
+        _occupied &= ~(EquipmentSlotMask(1) << slot);
         return unequipped;
     }
 
+    Equipment_shptr EquipmentSlots::Equip(Equipment_shptr equipment, EquipmentDelta& delta) {
+        EquipmentSlotKey newkey;
+        delta.unequipped = Equip(equipment, newkey);
+        delta.equipped = (newkey != INVALID_KEY) ? std::move(equipment) : Equipment_shptr();
+        return delta.unequipped;
+    }
+
+    Equipment_shptr EquipmentSlots::ForceEquip(Equipment_shptr equipment, EquipmentDelta& delta, int maxCountToAdd) {
+        EquipmentSlotKey newkey = INVALID_KEY;
+        delta.unequipped = ForceEquip(equipment, newkey, maxCountToAdd);
+        delta.equipped = (newkey != INVALID_KEY) ? std::move(equipment) : Equipment_shptr();
+        return delta.unequipped;
+    }
+
+    Equipment_shptr EquipmentSlots::Unequip(EquipmentSlotKey key, EquipmentDelta& delta) {
+        delta.equipped.reset();
+        delta.unequipped = Unequip(key);
+        return delta.unequipped;
+    }
+
     bool EquipmentSlots::HasSlot(EquipmentTypeKey eqtype, EquipmentSlotIndex index) const { return HasSlot(EquipmentSlotKey(eqtype, index)); }
-    bool EquipmentSlots::HasSlot(EquipmentSlotKey key) const { return _map.contains(key); }
+    bool EquipmentSlots::HasSlot(EquipmentSlotKey key) const { return FindSlot(key) < _slots.size(); }
 
     bool EquipmentSlots::IsSlotFilled(EquipmentTypeKey eqtype, EquipmentSlotIndex index) const { return IsSlotFilled(EquipmentSlotKey(eqtype, index)); }
-    bool EquipmentSlots::IsSlotFilled(EquipmentSlotKey key) const { return HasSlot(key) && _map.at(key); }
+    bool EquipmentSlots::IsSlotFilled(EquipmentSlotKey key) const {
+        std::size_t slot = FindSlot(key);
+        return slot < _slots.size() && (_occupied & (EquipmentSlotMask(1) << slot)) != 0;
+    }
 
-    int EquipmentSlots::GetCount(EquipmentTypeKey eqtype) const { return _counts.contains(eqtype) ? _counts.at(eqtype) : 0; }
+    int EquipmentSlots::GetCount(EquipmentTypeKey eqtype) const {
+        std::size_t type = FindType(eqtype);
+        return (type < _types.size()) ? static_cast<int>(_offsets[type + 1] - _offsets[type]) : 0;
+    }
 
     bool EquipmentSlots::FindFirstEmptySlot(EquipmentTypeKey eqtype, EquipmentSlotKey& output) const {
-        auto count = _counts.find(eqtype);
-        if (count == _counts.end()) {
+        std::size_t type = FindType(eqtype);
+        if (type >= _types.size()) {
             output = INVALID_KEY;
             return false;
         }
 
-        EquipmentSlotIndex index;
-        for (index = 1; index <= count->second; index++) {
-            if (!IsSlotFilled(eqtype, index)) {
-                output = EquipmentSlotKey(eqtype, index);
-                return true;
-            }
+        EquipmentSlotMask empty = GetTypeMask(type) & ~_occupied;
+        if (empty == 0) {
+            output = INVALID_KEY;
+            return false;
         }
 
-        output = INVALID_KEY;
-        return false;
+        output = GetKey(type, static_cast<std::size_t>(std::countr_zero(empty)));
+        return true;
     }
 
     bool EquipmentSlots::FindFirstEmptyOrLastSlot(EquipmentTypeKey eqtype, EquipmentSlotKey& output) const {
-        auto count = _counts.find(eqtype);
-        if (count == _counts.end()) {
-            output = INVALID_KEY;
-            return false;
+        if (FindFirstEmptySlot(eqtype, output)) {
+            return true;
         }
 
-        EquipmentSlotIndex index;
-        for (index = 1; index < count->second; index++) {
-            if (!IsSlotFilled(eqtype, index)) {
-                break;
-            }
+        int count = GetCount(eqtype);
+        if (count <= 0) {
+            output = INVALID_KEY;
+            return false;
         }
 
-        output = EquipmentSlotKey(eqtype, index);
+        output = EquipmentSlotKey(eqtype, count);
         return true;
     }
 
     Equipment_shptr EquipmentSlots::GetEquipment(EquipmentTypeKey eqtype, EquipmentSlotIndex index) const { return GetEquipment(EquipmentSlotKey(eqtype, index)); }
-    Equipment_shptr EquipmentSlots::GetEquipment(EquipmentSlotKey key) const { return HasSlot(key) ? _map.at(key) : Equipment_shptr(); }
+    Equipment_shptr EquipmentSlots::GetEquipment(EquipmentSlotKey key) const {
+        std::size_t slot = FindSlot(key);
+        return (slot < _slots.size()) ? _slots[slot] : Equipment_shptr();
+    }
 
     // iterator
 
-    EquipmentSlots::const_iterator::const_iterator(const EquipmentSlotMap& map) : _itr(std::begin(map)) {}
-    EquipmentSlots::const_iterator::const_iterator(const EquipmentSlotMap::const_iterator& itr) : _itr(itr) {}
+    EquipmentSlots::const_iterator::const_iterator(const EquipmentSlots& slots, std::size_t slot) : _slots(&slots), _type(0), _slot(slot) { SeekType(); }
+
+    void EquipmentSlots::const_iterator::SeekType() {
+        while (_type < _slots->_types.size() && _slots->_offsets[_type + 1] <= _slot) {
+            _type++;
+        }
+    }
 
-    EquipmentSlots::const_iterator::reference EquipmentSlots::const_iterator::operator*() const { return _itr.operator*(); }
-    EquipmentSlots::const_iterator::pointer EquipmentSlots::const_iterator::operator->() { return _itr.operator->(); }
-    EquipmentSlots::const_iterator& EquipmentSlots::const_iterator::operator++() { _itr++; return *this; }
+    EquipmentSlots::const_iterator::reference EquipmentSlots::const_iterator::operator*() const { return value_type(_slots->GetKey(_type, _slot), _slots->_slots[_slot]); }
+    EquipmentSlots::const_iterator& EquipmentSlots::const_iterator::operator++() { _slot++; SeekType(); return *this; }
     EquipmentSlots::const_iterator EquipmentSlots::const_iterator::operator++(int) { const_iterator prev = *this; this->operator++(); return prev; }
 
-    EquipmentSlots::const_iterator EquipmentSlots::begin() const { return const_iterator(_map); }
-    EquipmentSlots::const_iterator EquipmentSlots::end() const { return const_iterator(std::end(_map)); }
+    EquipmentSlots::const_iterator EquipmentSlots::begin() const { return const_iterator(*this, 0); }
+    EquipmentSlots::const_iterator EquipmentSlots::end() const { return const_iterator(*this, _slots.size()); }
 }
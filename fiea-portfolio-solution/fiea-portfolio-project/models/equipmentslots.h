@@ -1,5 +1,11 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <map>
+#include <span>
+#include <utility>
+#include <vector>
 #include "lovpairs.h"
 #include "equipment.h"
 #include "equipmenttype.h"
@@ -8,6 +14,8 @@ namespace AWE {
     // Forward declarations, defined in battler.h
     class Battler;
     class BattlerInstance;
+    // Forward declaration, defined in battlerprogression.h
+    class BattlerProgressionTransaction;
 
     /// <summary>
     /// There can be multiple equipment of the same type equipped. This distinguishes which equipment of a particular type is being referenced. Indicies start at 1.
@@ -31,29 +39,66 @@ namespace AWE {
     /// Represents equipment slots. Note that an equipment slot can be empty, but the map record for that slot may still be there. Use the EquipmentSlots class to use this map properly.
     /// </summary>
     typedef std::map<EquipmentSlotKey, Equipment_shptr, EquipmentSlotKey_comp> EquipmentSlotMap;
+    /// <summary>
+    /// One bit per slot of an EquipmentSlots object, at the slot's position in EquipmentSlots::slots().
+    /// </summary>
+    typedef std::uint64_t EquipmentSlotMask;
+
+    /// <summary>
+    /// The equipment which entered and left a set of equipment slots in one change. Either can be empty.
+    /// Applying a delta to totals derived from the slots means adding what was equipped and subtracting what was unequipped, so it costs the size of two items rather than all of them.
+    /// Only stats, resistances, damage sources, and skills are covered. Conversions are not included: the skills they grant are already resolved into each item's skills when it is loaded.
+    /// </summary>
+    struct EquipmentDelta {
+        Equipment_shptr equipped;
+        Equipment_shptr unequipped;
+    };
 
     /// <summary>
-    /// Wraps a map of equiment and provides several utility functions to properly populate it.
+    /// Holds a battler's equipment and provides several utility functions to properly populate it.
+    /// Every slot lives in one contiguous array, grouped by equipment type in key order, with a table of where each type's slots begin.
+    /// Which slots are filled is kept as a bitmask, so finding an empty slot of a type is a bit scan rather than a search.
     /// </summary>
     class EquipmentSlots {
+    public:
+        /// <summary>
+        /// Largest number of slots an object can have, one for each bit of an EquipmentSlotMask.
+        /// </summary>
+        static const std::size_t CAPACITY = 64;
+
     private:
-        EquipmentSlotMap _map;
-        EquipmentTypeCountMap _counts;
+        std::vector<EquipmentTypeKey> _types;
+        std::vector<std::size_t> _offsets;
+        std::vector<Equipment_shptr> _slots;
+        EquipmentSlotMask _occupied;
+
+        /// <returns>Position of the given type in _types, or _types.size() if this object has no slots of that type.</returns>
+        std::size_t FindType(EquipmentTypeKey) const;
+        /// <returns>Position of the given slot in _slots, or _slots.size() if this object has no such slot.</returns>
+        std::size_t FindSlot(EquipmentSlotKey) const;
+        /// <returns>Mask of every slot of the type at the given position of _types.</returns>
+        EquipmentSlotMask GetTypeMask(std::size_t type) const;
+        /// <returns>Key of the slot at the given position of _slots, which belongs to the type at the given position of _types.</returns>
+        EquipmentSlotKey GetKey(std::size_t type, std::size_t slot) const;
+        /// <summary>
+        /// Rebuilds the occupancy mask after slots moved.
+        /// </summary>
+        void RefreshOccupied();
 
         /// <summary>
         /// Creates an empty equipment slot of the given type.
         /// </summary>
-        /// <returns>The key for the new slot.</returns>
+        /// <returns>The key for the new slot, or INVALID_KEY if the object already has CAPACITY slots.</returns>
         EquipmentSlotKey AddSlot(EquipmentTypeKey);
         /// <summary>
         /// Creates an appropriate equipment slot for the given equipment, then equips the equipment to that new slot.
         /// </summary>
-        /// <returns>The key for the new slot.</returns>
+        /// <returns>The key for the new slot, or INVALID_KEY if the object already has CAPACITY slots.</returns>
         EquipmentSlotKey AddSlot(Equipment_shptr);
         /// <summary>
         /// Creates an equipment slot of the given type, then equips the given equipment if it's of the correct equipment type.
         /// </summary>
-        /// <returns>The key for the new slot.</returns>
+        /// <returns>The key for the new slot, or INVALID_KEY if the object already has CAPACITY slots.</returns>
         EquipmentSlotKey AddSlot(EquipmentTypeKey, Equipment_shptr);
         /// <summary>
         /// Removes the slot with the given equipment type at the given index. If such a slot does not exist, this method does nothing.
@@ -123,29 +168,50 @@ namespace AWE {
         /// </summary>
         /// <returns>The unequipped equipment, or an empty pointer if no such equipment was equipped.</returns>
         Equipment_shptr Unequip(EquipmentSlotKey);
+        /// <summary>
+        /// Same as Equip(Equipment_shptr), and also reports what changed.
+        /// </summary>
+        /// <param name="delta">Output parameter. Will be set to the equipment that entered and left the slots, both empty if nothing changed.</param>
+        /// <returns>The previously equipped equipment at the equipped slot, or an empty pointer if the slot was empty or did not exist.</returns>
+        Equipment_shptr Equip(Equipment_shptr equipment, EquipmentDelta& delta);
+        /// <summary>
+        /// Same as ForceEquip(Equipment_shptr, int), and also reports what changed.
+        /// </summary>
+        /// <param name="delta">Output parameter. Will be set to the equipment that entered and left the slots, both empty if nothing changed.</param>
+        /// <returns>The previously equipped equipment at the equipped slot, or an empty pointer if the slot was empty or was added.</returns>
+        Equipment_shptr ForceEquip(Equipment_shptr equipment, EquipmentDelta& delta, int maxCountToAdd = -1);
+        /// <summary>
+        /// Same as Unequip(EquipmentSlotKey), and also reports what changed.
+        /// </summary>
+        /// <param name="delta">Output parameter. Will be set to the equipment that left the slots, or empty if nothing changed.</param>
+        /// <returns>The unequipped equipment, or an empty pointer if no such equipment was equipped.</returns>
+        Equipment_shptr Unequip(EquipmentSlotKey key, EquipmentDelta& delta);
 
         friend class Battler;
+        friend class BattlerProgressionTransaction;
 
     public:
         EquipmentSlots();
         /// <summary>
-        /// Constructor.
+        /// Constructor. Copies the slots of the given map, which must number each type's slots from 1 without gaps. The map is not modified.
         /// </summary>
-        /// <param name="">An existing map to use for this object. Note the map is moved into this object.</param>
-        EquipmentSlots(EquipmentSlotMap&);
+        /// <param name="">An existing map to use for this object.</param>
+        EquipmentSlots(const EquipmentSlotMap&);
         /// <summary>
-        /// Constructor.
+        /// Constructor. Slots past CAPACITY are not created.
         /// </summary>
-        /// <param name="">Creates equipment slots based on the type map, leaving each slot empty. Note the given map is moved into this object.</param>
-        EquipmentSlots(EquipmentTypeCountMap&);
+        /// <param name="">Creates equipment slots based on the type map, leaving each slot empty. The map is not modified.</param>
+        EquipmentSlots(const EquipmentTypeCountMap&);
 
         /// <summary>
         /// An equipment slot with this key is considered invalid.
         /// </summary>
         static const EquipmentSlotKey INVALID_KEY;
 
-        /// <returns>const reference to the internal map.</returns>
-        const EquipmentSlotMap& map() const;
+        /// <returns>Every slot, grouped by equipment type in key order and then by index. Empty slots hold an empty pointer.</returns>
+        std::span<const Equipment_shptr> slots() const;
+        /// <returns>Mask of the filled slots, with one bit per entry of slots().</returns>
+        EquipmentSlotMask occupied() const;
 
         /// <returns>true if the given slot exists on this object, false otherwise. Note if this returns true that does not necessarily mean the slot is filled.</returns>
         bool HasSlot(EquipmentTypeKey, EquipmentSlotIndex) const;
@@ -176,32 +242,40 @@ namespace AWE {
         /// <returns>true if a slot was found, false otherwise.</returns>
         bool FindFirstEmptyOrLastSlot(EquipmentTypeKey eqtype, EquipmentSlotKey& output) const;
 
+        /// <summary>
+        /// Iterates every slot, including empty ones, in the same order as slots(). The iterator yields each slot's key and equipment by value.
+        /// </summary>
         class const_iterator {
         public:
             using iterator_category = std::input_iterator_tag;
-            using value_type = EquipmentSlotMap::value_type;
-            using difference_type = EquipmentSlotMap::difference_type;
-            using pointer = EquipmentSlotMap::const_pointer;
-            using reference = EquipmentSlotMap::const_reference;
+            using value_type = std::pair<EquipmentSlotKey, const Equipment_shptr&>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
 
-            const_iterator(const EquipmentSlotMap&);
-            const_iterator(const EquipmentSlotMap::const_iterator&);
+            const_iterator(const EquipmentSlots&, std::size_t slot);
 
             reference operator*() const;
-            pointer operator->();
             const_iterator& operator++();
             const_iterator operator++(int);
 
-            friend bool operator==(const const_iterator& it1, const const_iterator& it2) { return it1._itr == it2._itr; }
-            friend bool operator!=(const const_iterator& it1, const const_iterator& it2) { return it1._itr != it2._itr; }
+            friend bool operator==(const const_iterator& it1, const const_iterator& it2) { return it1._slot == it2._slot; }
+            friend bool operator!=(const const_iterator& it1, const const_iterator& it2) { return it1._slot != it2._slot; }
 
         private:
-            EquipmentSlotMap::const_iterator _itr;
+            const EquipmentSlots* _slots;
+            std::size_t _type;
+            std::size_t _slot;
+
+            /// <summary>
+            /// Moves _type forward to the type which owns _slot.
+            /// </summary>
+            void SeekType();
         };
 
         /// <returns>const iterator to the first equipment in this object.</returns>
         const_iterator begin() const;
-        /// <returns>const iterator to the spot in memory behind the last equipment in this object. Attempting access from this address will result in undefined behavior.</returns>
+        /// <returns>const iterator to the spot behind the last equipment in this object. Attempting to dereference it will result in undefined behavior.</returns>
         const_iterator end() const;
     };
 }
@@ -10,7 +10,7 @@ namespace AWE {
     const SkillBaseDamage SkillBaseDamage::INVALID = SkillBaseDamage();
 
     int SkillBaseDamage::value() const { return _value; }
-    DamageInclination_shptr SkillBaseDamage::inclination() const { return _inclination; }
+    const DamageInclination_shptr& SkillBaseDamage::inclination() const { return _inclination; }
 
 
     /* SkillElementBinding */
@@ -22,10 +22,10 @@ namespace AWE {
 
     bool SkillElementBinding::isPenetrating() const { return _isPenetrating; }
     float SkillElementBinding::scaling() const { return _scaling; }
-    DamageInclination_shptr SkillElementBinding::inclination() const { return _inclination; }
-    DamageType_shptr SkillElementBinding::damageType() const { return _damageType; }
-    SkillElement_shptr SkillElementBinding::element() const { return _element; }
-    SkillElementGroup_shptr SkillElementBinding::group() const { return _group; }
+    const DamageInclination_shptr& SkillElementBinding::inclination() const { return _inclination; }
+    const DamageType_shptr& SkillElementBinding::damageType() const { return _damageType; }
+    const SkillElement_shptr& SkillElementBinding::element() const { return _element; }
+    const SkillElementGroup_shptr& SkillElementBinding::group() const { return _group; }
 
     bool SkillElementBinding::IsGroupBinding() const { return (bool)_group; }
 
@@ -35,8 +35,8 @@ namespace AWE {
     SkillStatScaling::SkillStatScaling(float value, DamageInclination_shptr inclination, BattlerStat_shptr battlerStat) : _value(std::move(value)), _inclination(std::move(inclination)), _battlerStat(std::move(battlerStat)) {}
 
     float SkillStatScaling::value() const { return _value; }
-    DamageInclination_shptr SkillStatScaling::inclination() const { return _inclination; }
-    BattlerStat_shptr SkillStatScaling::battlerStat() const { return _battlerStat; }
+    const DamageInclination_shptr& SkillStatScaling::inclination() const { return _inclination; }
+    const BattlerStat_shptr& SkillStatScaling::battlerStat() const { return _battlerStat; }
 
 
     /* SkillDamage */
@@ -91,7 +91,12 @@ namespace AWE {
     const std::set<SkillElementGroupKey>& Skill::elementGroups() const { return _elementGroups; }
     unsigned int Skill::textureIndex() const { return _textureIndex; }
     const std::string& Skill::soundFilename() const { return _soundFilename; }
+    const DamagePlan& Skill::damagePlan() const { return _damagePlan; }
 
     unsigned int Skill::textureIndex(unsigned int newval) { unsigned int oldval = _textureIndex; _textureIndex = newval; return oldval; }
     std::string Skill::soundFilename(std::string newval) { std::string oldval = _soundFilename; _soundFilename = newval; return oldval; }
+
+    void Skill::CompileDamagePlan(const DamageInclinationMap& inclinations, const DamageInclinationStatListMap& attackingStats, const DamageInclinationStatListMap& defendingStats) {
+        _damagePlan = DamagePlan(_damages, inclinations, attackingStats, defendingStats);
+    }
 }
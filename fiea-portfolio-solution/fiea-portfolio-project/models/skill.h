@@ -6,9 +6,11 @@
 #include <vector>
 #include "battlerstat.h"
 #include "damageinclination.h"
+#include "damageplan.h"
 #include "damagetype.h"
 #include "skillelement.h"
 #include "skillelementgroup.h"
+#include "../store/symboltable.h"
 
 namespace AWE {
     /// <summary>
@@ -33,8 +35,8 @@ namespace AWE {
 
         /// <returns>Value of the base damage.</returns>
         int value() const;
-        /// <returns>shared_ptr to this base damage's inclination.</returns>
-        DamageInclination_shptr inclination() const;
+        /// <returns>const reference to this base damage's inclination.</returns>
+        const DamageInclination_shptr& inclination() const;
     };
 
     /// <summary>
@@ -64,14 +66,14 @@ namespace AWE {
         bool isPenetrating() const;
         /// <returns>Percentage from 0.f to 1.f of the stat-scaled damage which should be given to this binding.</returns>
         float scaling() const;
-        /// <returns>shared_ptr to this object's inclination.</returns>
-        DamageInclination_shptr inclination() const;
-        /// <returns>shared_ptr to this object's damage type.</returns>
-        DamageType_shptr damageType() const;
-        /// <returns>shared_ptr to this object's skill element, if it exists. Otherwise, returns an empty shared_ptr.</returns>
-        SkillElement_shptr element() const;
-        /// <returns>shared_ptr to this object's skill element group, if it exists. Otherwise, returns an empty shared_ptr.</returns>
-        SkillElementGroup_shptr group() const;
+        /// <returns>const reference to this object's inclination.</returns>
+        const DamageInclination_shptr& inclination() const;
+        /// <returns>const reference to this object's damage type.</returns>
+        const DamageType_shptr& damageType() const;
+        /// <returns>const reference to this object's skill element, if it exists. Otherwise, returns an empty shared_ptr.</returns>
+        const SkillElement_shptr& element() const;
+        /// <returns>const reference to this object's skill element group, if it exists. Otherwise, returns an empty shared_ptr.</returns>
+        const SkillElementGroup_shptr& group() const;
 
         /// <returns>Does this object use a skill element group for its binding?</returns>
         bool IsGroupBinding() const;
@@ -91,10 +93,10 @@ namespace AWE {
 
         /// <returns>Value from 0.f to 1.f of this scaling. Example: if the stat is Strength and the value is 0.5f, the skill will use 50% of the Strength stat in its calculation.</returns>
         float value() const;
-        /// <returns>shared_ptr to the inclination of this object.</returns>
-        DamageInclination_shptr inclination() const;
-        /// <returns>shared_ptr to the battler stat of this object.</returns>
-        BattlerStat_shptr battlerStat() const;
+        /// <returns>const reference to the inclination of this object.</returns>
+        const DamageInclination_shptr& inclination() const;
+        /// <returns>const reference to the battler stat of this object.</returns>
+        const BattlerStat_shptr& battlerStat() const;
     };
 
     /// <summary>
@@ -137,6 +139,7 @@ namespace AWE {
         std::set<SkillElementGroupKey> _elementGroups;
         unsigned int _textureIndex;
         std::string _soundFilename;
+        DamagePlan _damagePlan;
 
     public:
         /// <summary>
@@ -155,6 +158,8 @@ namespace AWE {
         unsigned int textureIndex() const;
         /// <returns>const reference to this skill's sound's file name.</returns>
         const std::string& soundFilename() const;
+        /// <returns>const reference to this skill's compiled damage plan. The plan will not be compiled unless CompileDamagePlan has been invoked.</returns>
+        const DamagePlan& damagePlan() const;
 
         /// <param name="">New value for the texture index.</param>
         /// <returns>Old value for the texture index.</returns>
@@ -162,15 +167,23 @@ namespace AWE {
         /// <param name="">New value for this skill's sound's filename.</param>
         /// <returns>Old value for this skill's sound's filename.</returns>
         std::string soundFilename(std::string);
+
+        /// <summary>
+        /// Compiles this skill's damages into a damage plan, replacing any previously compiled plan.
+        /// </summary>
+        /// <param name="inclinations">All loaded damage inclinations.</param>
+        /// <param name="attackingStats">Attacking stats of each damage inclination.</param>
+        /// <param name="defendingStats">Defending stats of each damage inclination.</param>
+        void CompileDamagePlan(const DamageInclinationMap& inclinations, const DamageInclinationStatListMap& attackingStats, const DamageInclinationStatListMap& defendingStats);
     };
 
     /// <summary>
-    /// Used to index skills into a map. Currently designed to be a string which should be equivalent to the skill's name.
+    /// Used to index skills into a map. The skill's name, interned by the XLO storage's symbol table.
     /// </summary>
-    typedef std::string SkillKey;
+    typedef SymbolID SkillKey;
     /// <summary>
     /// Represents a skill which battlers may use in combat against each other.
     /// </summary>
     typedef std::shared_ptr<Skill> Skill_shptr;
-    typedef std::map<SkillKey, Skill_shptr> SkillMap;
+    typedef SymbolMap<Skill> SkillMap;
 }
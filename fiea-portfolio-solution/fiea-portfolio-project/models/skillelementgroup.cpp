@@ -1,15 +1,15 @@
 #include "skillelementgroup.h"
 
 namespace AWE {
-    SkillElementGroup::SkillElementGroup() : AbbreviatedKey(), _isGroups(false) {}
+    SkillElementGroup::SkillElementGroup() : AbbreviatedKey(), _isGroups(false), _isMaskAssigned(false) {}
 
-    SkillElementGroup::SkillElementGroup(std::string name, ABRV abrv) : AbbreviatedKey(name, abrv), _isGroups(false) {}
+    SkillElementGroup::SkillElementGroup(std::string name, ABRV abrv) : AbbreviatedKey(name, abrv), _isGroups(false), _isMaskAssigned(false) {}
 
     SkillElementGroup::SkillElementGroup(std::string name, ABRV abrv, SkillElementList elements)
-        : AbbreviatedKey(name, abrv), _isGroups(false), _elements(std::move(elements)) {}
+        : AbbreviatedKey(name, abrv), _isGroups(false), _elements(std::move(elements)), _isMaskAssigned(false) {}
 
     SkillElementGroup::SkillElementGroup(std::string name, ABRV abrv, SkillElementGroupList groups)
-            : AbbreviatedKey(name, abrv), _isGroups(true), _groups(std::move(std::make_unique<SkillElementGroupList>(groups))) {
+            : AbbreviatedKey(name, abrv), _isGroups(true), _groups(std::move(std::make_unique<SkillElementGroupList>(groups))), _isMaskAssigned(false) {
         SkillElementList elements;
         bool keepElements = true;
 
@@ -93,6 +93,34 @@ namespace AWE {
 
     const SkillElementList& SkillElementGroup::elements() const { return _elements; }
     const SkillElementGroupList* SkillElementGroup::groups() const { return _groups.get(); }
+    const SkillElementMask& SkillElementGroup::mask() const { return _mask; }
+    bool SkillElementGroup::isMaskAssigned() const { return _isMaskAssigned; }
+
+    bool SkillElementGroup::AssignMask(const LOVIndexTable<SkillElement>& indices) {
+        _mask.reset();
+        _isMaskAssigned = false;
+
+        if (!IsValid()) {
+            return false;
+        }
+
+        // A group of groups already lists the union of its children's elements, so it needs no recursion.
+        SkillElementMask mask;
+        for (const SkillElement_shptr& element : _elements) {
+            LOVIndex index = indices.GetIndex(element->abrvlong());
+            if (index >= indices.size() || index >= SKILLELEMENTMASK_CAPACITY) {
+                return false;
+            }
+            mask.set(index);
+        }
+
+        _mask = mask;
+        _isMaskAssigned = true;
+        return true;
+    }
+
+    bool SkillElementGroup::Contains(LOVIndex element) const { return _isMaskAssigned && element < SKILLELEMENTMASK_CAPACITY && _mask.test(element); }
+    bool SkillElementGroup::Overlaps(const SkillElementGroup& other) const { return _isMaskAssigned && other._isMaskAssigned && (_mask & other._mask).any(); }
 
     bool SkillElementGroup::Equals(const AbbreviatedKey& other) const {
         bool isEqual = false;
@@ -122,6 +150,10 @@ namespace AWE {
         }
 
         // By this point, we know both groups are valid and are of the same type.
+        if (_isMaskAssigned && other._isMaskAssigned) {
+            return _mask == other._mask && _abrv.Equals(other._abrv);
+        }
+
         if (_isGroups) {
             if (_groups->size() != other._groups->size()) {
                 return false;
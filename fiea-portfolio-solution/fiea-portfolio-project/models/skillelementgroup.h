@@ -1,10 +1,13 @@
 #pragma once
+#include <bitset>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include "../abrv/abbreviatedkey.h"
 #include "../abrv/abrv.h"
+#include "../store/lovindextable.h"
 #include "skillelement.h"
 
 namespace AWE {
@@ -18,6 +21,15 @@ namespace AWE {
     typedef std::vector<SkillElement_shptr> SkillElementList;
     typedef std::vector<SkillElementGroup_shptr> SkillElementGroupList;
 
+    /// <summary>
+    /// Largest number of skill elements a SkillElementMask can hold. Sized so a whole mask fits in one machine word.
+    /// </summary>
+    static const std::size_t SKILLELEMENTMASK_CAPACITY = 64;
+    /// <summary>
+    /// Set of skill elements, with one bit per element at the element's LOVIndex.
+    /// </summary>
+    typedef std::bitset<SKILLELEMENTMASK_CAPACITY> SkillElementMask;
+
     /// <summary>
     /// Represents a group of skill elements. Can also represent a group of groups - in this case, this group's elements will be a union of all of its child groups.
     /// Note this object actually has a list which contains all of its elements.
@@ -27,6 +39,8 @@ namespace AWE {
         bool _isGroups;
         SkillElementList _elements;
         std::unique_ptr<SkillElementGroupList> _groups;
+        SkillElementMask _mask;
+        bool _isMaskAssigned;
 
     public:
         /// <summary>
@@ -58,9 +72,25 @@ namespace AWE {
         /// <returns>If this is a group of groups, const pointer to internal group list. Otherwise, returns nullptr.</returns>
         const SkillElementGroupList* groups() const;
 
+        /// <returns>const reference to the set of this group's elements. Empty until AssignMask succeeds.</returns>
+        const SkillElementMask& mask() const;
+        /// <returns>Has AssignMask succeeded on this group?</returns>
+        bool isMaskAssigned() const;
+
         /// <returns>Was this group properly initialized?</returns>
         bool IsValid() const;
         /// <summary>
+        /// Sets the bit of every element of this group, using the given table's indices. Must be called again if the table's indices change.
+        /// </summary>
+        /// <param name="">Index table of the skill elements, usually GameLOVStorage::skillElementIndices().</param>
+        /// <returns>False if the group is invalid, or if any element is not in the table or has an index too large for a SkillElementMask. In that case the mask is left unassigned.</returns>
+        bool AssignMask(const LOVIndexTable<SkillElement>&);
+        /// <param name="element">Index of the element in the table the mask was assigned from.</param>
+        /// <returns>Is the given element in this group? Always false if the mask is unassigned.</returns>
+        bool Contains(LOVIndex element) const;
+        /// <returns>Do this group and the given group have any element in common? Always false unless both masks are assigned.</returns>
+        bool Overlaps(const SkillElementGroup&) const;
+        /// <summary>
         /// Initializes the group using the internal group list. This overload of this method is only useable on groups of groups.
         /// </summary>
         /// <returns>True if initialization was successful, false otherwise.</returns>
@@ -78,6 +108,9 @@ namespace AWE {
         /// <param name="other">The other AbbreviatedKey object.</param>
         /// <returns>Equivalence to the other AbbreviatedKey.</returns>
         bool Equals(const AbbreviatedKey& other) const override;
+        /// <summary>
+        /// If both masks are assigned, groups with the same ABRV and the same set of elements are equal, regardless of element order.
+        /// </summary>
         /// <param name="other">The other SkillElementGroup object.</param>
         /// <returns>Equivalence to the other SkillElementGroup.</returns>
         bool Equals(const SkillElementGroup& other) const;
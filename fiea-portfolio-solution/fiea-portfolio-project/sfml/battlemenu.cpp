@@ -43,7 +43,7 @@ namespace AWE {
         const TextBoxVisuals& charboxVisuals,
         const sf::Color& skillSelectorColor,
         const sf::Color& charSelectorColor
-    ) : AWEDrawable(), _margin(margin), _characters(nullptr), _skillTextBox(TextBox(skillboxVisuals)), _characterTextBox(TextBox(charboxVisuals)) {
+    ) : AWEDrawable(), _skillTextBox(TextBox(skillboxVisuals)), _characterTextBox(TextBox(charboxVisuals)), _characters(nullptr), _instances(nullptr), _margin(margin) {
         _isSelected = false;
         _isLocked = false;
         _cursorSound.setVolume(SELECT_SAVE_SOUND_VOLUME);
@@ -112,21 +112,32 @@ namespace AWE {
     }
 
     void BattleMenu::RefreshText() {
-        if (!_characters || _characters->size() < 1) {
+        if (!_characters || !_instances || _characters->size() < 1) {
             _skillSelector.isVisible(false);
             _characterSelector.isVisible(false);
             return;
         }
 
         std::stringstream ss;
-        for (const BattlerInstance_shptr& character : *_characters) {
+        for (BattlerInstanceHandle handle : *_characters) {
+            const BattlerInstance* character = _instances->Get(handle);
+            if (!character) {
+                continue;
+            }
+
             BattlerStatValue mxhp = character->GetStat(BattlerStat::MXHP.AsLong());
             ss << character->name() << PadSpaces(character->name(), 8) << ' ' << PadSpaces(character->hp(), 4) << character->hp() << '/' << mxhp << PadSpaces(mxhp, 4) << '\n';
         }
         _characterTextBox.SetString(ss.str());
         _characterSelector.isVisible(true);
 
-        const SkillMap& skills = _characters->at(_characterIndex)->skills();
+        const BattlerInstance* character = GetCurrentCharacter();
+        if (!character) {
+            _skillSelector.isVisible(false);
+            return;
+        }
+
+        const SkillMap& skills = character->skills();
 
         if (skills.empty()) {
             _skillSelector.isVisible(false);
@@ -197,13 +208,14 @@ namespace AWE {
     bool BattleMenu::IncrementSkillSingle(bool refreshSelectorPositions) {
         if (_isLocked) { return false; }
 
-        if (!_characters || _characters->empty() || _characterIndex >= _characters->size()) {
+        const BattlerInstance* character = GetCurrentCharacter();
+        if (!character) {
             _skillIndex = 0;
             if (refreshSelectorPositions) { RefreshSelectorPositions(); }
             return false;
         }
 
-        const SkillMap& skills = _characters->at(_characterIndex)->skills();
+        const SkillMap& skills = character->skills();
 
         if (skills.size() > (_skillIndex + 1)) {
             _skillIndex++;
@@ -219,13 +231,14 @@ namespace AWE {
     bool BattleMenu::DecrementSkillSingle(bool refreshSelectorPositions) {
         if (_isLocked) { return false; }
 
-        if (!_characters || _characters->empty() || _characterIndex >= _characters->size()) {
+        const BattlerInstance* character = GetCurrentCharacter();
+        if (!character) {
             _skillIndex = 0;
             if (refreshSelectorPositions) { RefreshSelectorPositions(); }
             return false;
         }
 
-        const SkillMap& skills = _characters->at(_characterIndex)->skills();
+        const SkillMap& skills = character->skills();
 
         if (_skillIndex > 0) {
             _skillIndex = (skills.size() > _skillIndex ? _skillIndex : skills.size()) - 1;
@@ -242,7 +255,8 @@ namespace AWE {
     const TextBox& BattleMenu::skillTextBox() const { return _skillTextBox; }
     const TextBox& BattleMenu::characterTextBox() const { return _characterTextBox; }
     unsigned int BattleMenu::margin() const { return _margin; }
-    const std::vector<BattlerInstance_shptr>* BattleMenu::characters() const { return _characters; }
+    const std::vector<BattlerInstanceHandle>* BattleMenu::characters() const { return _characters; }
+    const BattlerInstancePool* BattleMenu::instances() const { return _instances; }
     const BattleSelector& BattleMenu::skillSelector() const { return _skillSelector; }
     const BattleSelector& BattleMenu::characterSelector() const { return _characterSelector; }
     bool BattleMenu::isSelected() const { return _isSelected; }
@@ -251,9 +265,10 @@ namespace AWE {
 
     unsigned int BattleMenu::margin(unsigned int newval) { unsigned int oldval = _margin; _margin = newval; return oldval; }
 
-    const std::vector<BattlerInstance_shptr>* BattleMenu::characters(const std::vector<BattlerInstance_shptr>& newval) {
-        const std::vector<BattlerInstance_shptr>* oldval = _characters;
+    const std::vector<BattlerInstanceHandle>* BattleMenu::characters(const std::vector<BattlerInstanceHandle>& newval, const BattlerInstancePool& instances) {
+        const std::vector<BattlerInstanceHandle>* oldval = _characters;
         _characters = &newval;
+        _instances = &instances;
         _characterIndex = 0;
         _skillIndex = 0;
         RefreshText();
@@ -261,9 +276,9 @@ namespace AWE {
         return oldval;
     }
 
-    Skill_shptr BattleMenu::GetCurrentSkill() const {
-        Skill_shptr ptr;
-        BattlerInstance_shptr character = GetCurrentCharacter();
+    const Skill* BattleMenu::GetCurrentSkill() const {
+        const Skill* ptr = nullptr;
+        const BattlerInstance* character = GetCurrentCharacter();
 
         if (!character) {
             return ptr;
@@ -274,7 +289,7 @@ namespace AWE {
         if (!skills.empty() && _skillIndex < skills.size()) {
             SkillMap::const_iterator itr = skills.begin();
             std::advance(itr, _skillIndex);
-            ptr = itr->second;
+            ptr = itr->second.get();
         }
 
         return ptr;
@@ -283,7 +298,7 @@ namespace AWE {
     bool BattleMenu::GoToSkill(unsigned int index) {
         if (_isLocked) { return false; }
 
-        BattlerInstance_shptr character = GetCurrentCharacter();
+        const BattlerInstance* character = GetCurrentCharacter();
 
         if (!character || character->skills().empty()) {
             _skillIndex = 0;
@@ -348,16 +363,18 @@ namespace AWE {
         return loop;
     }
 
-    BattlerInstance_shptr BattleMenu::GetCurrentCharacter() const {
-        BattlerInstance_shptr ptr;
+    BattlerInstanceHandle BattleMenu::GetCurrentCharacterHandle() const {
+        BattlerInstanceHandle handle;
 
         if (_characters && _characterIndex < _characters->size()) {
-            ptr = _characters->at(_characterIndex);
+            handle = _characters->at(_characterIndex);
         }
 
-        return ptr;
+        return handle;
     }
 
+    const BattlerInstance* BattleMenu::GetCurrentCharacter() const { return _instances ? _instances->Get(GetCurrentCharacterHandle()) : nullptr; }
+
     bool BattleMenu::GoToCharacter(unsigned int index) {
         if (_isLocked) { return false; }
 
@@ -414,8 +431,8 @@ namespace AWE {
 
     void BattleMenu::Select() {
         if (_isVisible && _characterSelector.isVisible() && _skillSelector.isVisible()) {
-            BattlerInstance_shptr character = GetCurrentCharacter();
-            Skill_shptr skill = GetCurrentSkill();
+            const BattlerInstance* character = GetCurrentCharacter();
+            const Skill* skill = GetCurrentSkill();
             if (character && skill) {
                 _isSelected = true;
                 _isLocked = true;
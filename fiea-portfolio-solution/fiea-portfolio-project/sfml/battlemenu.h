@@ -47,7 +47,8 @@ namespace AWE {
         sf::RectangleShape _background;
         TextBox _skillTextBox;
         TextBox _characterTextBox;
-        const std::vector<BattlerInstance_shptr>* _characters;
+        const std::vector<BattlerInstanceHandle>* _characters;
+        const BattlerInstancePool* _instances;
         unsigned int _skillIndex;
         unsigned int _characterIndex;
         unsigned int _margin;
@@ -144,7 +145,9 @@ namespace AWE {
         /// <returns>Space in pixels between the two textboxes and between those textboxes and the edges of the menu.</returns>
         unsigned int margin() const;
         /// <returns>const pointer to the list of characters this menu tracks.</returns>
-        const std::vector<BattlerInstance_shptr>* characters() const;
+        const std::vector<BattlerInstanceHandle>* characters() const;
+        /// <returns>const pointer to the pool which owns the characters this menu tracks.</returns>
+        const BattlerInstancePool* instances() const;
         /// <returns>const reference to the selector for skills.</returns>
         const BattleSelector& skillSelector() const;
         /// <returns>const reference to the selector for characters.</returns>
@@ -160,15 +163,16 @@ namespace AWE {
         /// <returns>Old value for the margin.</returns>
         unsigned int margin(unsigned int);
         /// <param name="">New value for the character list.</param>
+        /// <param name="">Pool which owns the characters in the list. Also replaces the pool this menu resolves characters from.</param>
         /// <returns>Old value of the character list as a pointer.</returns>
-        const std::vector<BattlerInstance_shptr>* characters(const std::vector<BattlerInstance_shptr>&);
+        const std::vector<BattlerInstanceHandle>* characters(const std::vector<BattlerInstanceHandle>&, const BattlerInstancePool&);
 
         /// <param name="">New position of the menu. This will update the position of all of the menu's child elements as well.</param>
         /// <returns>Old position of the menu.</returns>
         sf::Vector2f SetPosition(const sf::Vector2f&);
 
-        /// <returns>shared_ptr to the skill the selector is currently over.</returns>
-        Skill_shptr GetCurrentSkill() const;
+        /// <returns>const pointer to the skill the selector is currently over, or nullptr if there is none.</returns>
+        const Skill* GetCurrentSkill() const;
         /// <summary>
         /// Attempts to go to the skill with the given index, or simply goes to the last skill if no skill with that index exists.
         /// </summary>
@@ -187,8 +191,10 @@ namespace AWE {
         /// <param name="delta">How many times the skill should be decremented.</param>
         /// <returns>true if the skill selector successfully decremented the full amount, false otherwise.</returns>
         bool DecrementSkill(unsigned int delta = 1);
-        /// <returns>shared_ptr to the character the selector is currently over.</returns>
-        BattlerInstance_shptr GetCurrentCharacter() const;
+        /// <returns>Handle to the character the selector is currently over, or an invalid handle if there is none.</returns>
+        BattlerInstanceHandle GetCurrentCharacterHandle() const;
+        /// <returns>const pointer to the character the selector is currently over, or nullptr if there is none.</returns>
+        const BattlerInstance* GetCurrentCharacter() const;
         /// <summary>
         /// Attempts to go to the character with the given index, or simply goes to the last character if no character with that index exists.
         /// If the character changes, the skill side of the menu will change and the skill index will be set to 0.
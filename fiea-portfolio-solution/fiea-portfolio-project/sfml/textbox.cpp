@@ -151,4 +151,13 @@ namespace AWE {
         RepositionText();
         return oldval;
     }
+
+    sf::String TextBox::SetString(const TextFormatter& formatter) {
+        sf::String oldval = _text.getString();
+        std::string_view str = formatter.view();
+        _lines = 1 + std::count(str.begin(), str.end(), '\n');
+        _text.setString(sf::String::fromUtf8(str.begin(), str.end()));
+        RepositionText();
+        return oldval;
+    }
 }
@@ -2,6 +2,7 @@
 #include <string>
 #include <SFML/Graphics.hpp>
 #include "awedrawable.h"
+#include "../misc/textformatter.h"
 
 namespace AWE {
     /// <summary>
@@ -172,5 +173,11 @@ namespace AWE {
         /// <param name="">New string value for the text.</param>
         /// <returns>Old string value for the text.</returns>
         sf::String SetString(std::string);
+        /// <summary>
+        /// Sets the text straight from the formatter's buffer, without building an intermediate std::string.
+        /// </summary>
+        /// <param name="">Formatter holding the new text.</param>
+        /// <returns>Old string value for the text.</returns>
+        sf::String SetString(const TextFormatter&);
     };
 }
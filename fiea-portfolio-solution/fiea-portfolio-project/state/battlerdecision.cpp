@@ -1,11 +1,11 @@
 #include "battlerdecision.h"
 
 namespace AWE {
-    BattlerDecision::BattlerDecision(Skill_shptr skill, BattlerInstance_shptr source, BattlerInstance_shptr target) : _skill(std::move(skill)), _source(std::move(source)), _target(std::move(target)) {}
+    BattlerDecision::BattlerDecision(const Skill& skill, BattlerInstanceHandle source, BattlerInstanceHandle target) : _skill(&skill), _source(source), _target(target) {}
 
-    const Skill_shptr& BattlerDecision::skill() const { return _skill; }
-    const BattlerInstance_shptr& BattlerDecision::source() const { return _source; }
-    const BattlerInstance_shptr& BattlerDecision::target() const { return _target; }
+    const Skill& BattlerDecision::skill() const { return *_skill; }
+    BattlerInstanceHandle BattlerDecision::source() const { return _source; }
+    BattlerInstanceHandle BattlerDecision::target() const { return _target; }
 
     bool CleanTopBattlerDecisionOrdering(BattlerDecisionOrdering* ordering) { BattlerDecisionOrdering::const_iterator _; return CleanTopBattlerDecisionOrdering(ordering, _); }
     bool CleanTopBattlerDecisionOrdering(BattlerDecisionOrdering* ordering, BattlerDecisionOrdering::const_iterator& output) {
@@ -32,14 +32,15 @@ namespace AWE {
         return false;
     }
 
-    void FindBattlerDecision(BattlerDecisionOrdering& ordering, const BattlerInstance_shptr& battler, bool& foundOrderingOutput, bool& foundListOutput) {
+    void FindBattlerDecision(BattlerDecisionOrdering& ordering, const BattlerInstancePool& pool, BattlerInstanceHandle battler, bool& foundOrderingOutput, bool& foundListOutput) {
         BattlerDecisionOrdering::iterator _;
         BattlerDecisionList::iterator __;
-        return FindBattlerDecision(ordering, battler, foundOrderingOutput, _, foundListOutput, __);
+        return FindBattlerDecision(ordering, pool, battler, foundOrderingOutput, _, foundListOutput, __);
     }
     void FindBattlerDecision(
         BattlerDecisionOrdering& ordering,
-        const BattlerInstance_shptr& battler,
+        const BattlerInstancePool& pool,
+        BattlerInstanceHandle battler,
         bool& foundOrderingOutput,
         BattlerDecisionOrdering::iterator& orderingOutput,
         bool& foundListOutput,
@@ -48,7 +49,13 @@ namespace AWE {
         foundOrderingOutput = false;
         foundListOutput = false;
 
-        orderingOutput = ordering.find(battler->priority());
+        const BattlerInstance* instance = pool.Get(battler);
+        if (!instance) {
+            orderingOutput = ordering.end();
+            return;
+        }
+
+        orderingOutput = ordering.find(instance->priority());
 
         if (orderingOutput != ordering.end()) {
             foundOrderingOutput = true;
@@ -56,7 +63,7 @@ namespace AWE {
 
         if (foundOrderingOutput) {
             for (BattlerDecisionList::iterator l_itr = orderingOutput->second.begin(); l_itr != orderingOutput->second.end(); l_itr++) {
-                if (l_itr->source().get() == battler.get()) {
+                if (l_itr->source() == battler) {
                     foundListOutput = true;
                     listOutput = l_itr;
                     break;
@@ -65,15 +72,15 @@ namespace AWE {
         }
     }
 
-    std::unique_ptr<BattlerDecision> RemoveBattlerDecision(BattlerDecisionOrdering& ordering, const BattlerInstance_shptr& battler) {
-        std::unique_ptr<BattlerDecision> output;
+    std::optional<BattlerDecision> RemoveBattlerDecision(BattlerDecisionOrdering& ordering, const BattlerInstancePool& pool, BattlerInstanceHandle battler) {
+        std::optional<BattlerDecision> output;
         BattlerDecisionOrdering::iterator orderitr;
         BattlerDecisionList::iterator decision;
         bool foundOrderitr = false, foundDecision = false;
 
-        FindBattlerDecision(ordering, battler, foundOrderitr, orderitr, foundDecision, decision);
+        FindBattlerDecision(ordering, pool, battler, foundOrderitr, orderitr, foundDecision, decision);
         if (foundOrderitr && foundDecision) {
-            output = std::make_unique<BattlerDecision>(BattlerDecision(*decision));
+            output = *decision;
             orderitr->second.erase(decision);
 
             if (orderitr->second.empty()) {
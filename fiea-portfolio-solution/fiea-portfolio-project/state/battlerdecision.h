@@ -1,6 +1,7 @@
 #pragma once
 #include <map>
-#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <vector>
 #include "../models/battler.h"
 #include "../models/skill.h"
@@ -8,33 +9,36 @@
 namespace AWE {
     /// <summary>
     /// Represents a battler's decision in combat. `source` is using `skill` on `target`.
+    /// Decisions are trivially copyable: the skill is owned by the XLO storage for the whole game, and the battlers are handles into the battle's BattlerInstancePool.
     /// </summary>
     class BattlerDecision {
     private:
-        Skill_shptr _skill;
-        BattlerInstance_shptr _source;
-        BattlerInstance_shptr _target;
+        const Skill* _skill;
+        BattlerInstanceHandle _source;
+        BattlerInstanceHandle _target;
 
     public:
         /// <summary>
         /// Constructor. Represents the following: `source` is using `skill` on `target`.
         /// </summary>
-        BattlerDecision(Skill_shptr, BattlerInstance_shptr source, BattlerInstance_shptr target);
+        /// <param name="">The skill to use. Must outlive the decision.</param>
+        BattlerDecision(const Skill&, BattlerInstanceHandle source, BattlerInstanceHandle target);
 
         /// <returns>const reference to the skill being used by `source`.</returns>
-        const Skill_shptr& skill() const;
-        /// <returns>const reference to the battler instance using the skill.</returns>
-        const BattlerInstance_shptr& source() const;
-        /// <returns>const reference to the battler instance which is the target of the skill.</returns>
-        const BattlerInstance_shptr& target() const;
+        const Skill& skill() const;
+        /// <returns>Handle to the battler instance using the skill.</returns>
+        BattlerInstanceHandle source() const;
+        /// <returns>Handle to the battler instance which is the target of the skill.</returns>
+        BattlerInstanceHandle target() const;
     };
 
-    typedef std::vector<BattlerDecision> BattlerDecisionList;
+    typedef std::pmr::vector<BattlerDecision> BattlerDecisionList;
     /// <summary>
     /// Map which orders battler decisions based on priority. Battlers with a lower priority value go earlier in the turn.
     /// Some battlers may share priority values, so a first-come-first-served list is used to resolve those conflicts.
+    /// The map and every list in it allocate from the memory resource the map was constructed with, usually the battle's BattleArena.
     /// </summary>
-    typedef std::map<unsigned short, BattlerDecisionList> BattlerDecisionOrdering;
+    typedef std::pmr::map<unsigned short, BattlerDecisionList> BattlerDecisionOrdering;
 
     /// <summary>
     /// Searches for a battler decision in the list with the lowest priority value. If a priority value is found with an empty list, that element is removed from the ordering and the search continues.
@@ -51,27 +55,29 @@ namespace AWE {
     bool CleanTopBattlerDecisionOrdering(BattlerDecisionOrdering*, BattlerDecisionOrdering::const_iterator& output);
 
     /// <summary>
-    /// Attempts to find a decision in the given ordering whose source is equivalent to the given battler instance.
+    /// Attempts to find a decision in the given ordering whose source is the given battler instance.
     /// </summary>
     /// <param name="BattlerDecisionOrdering">The ordering to search.</param>
-    /// <param name="BattlerInstance_shptr">const reference to the battler instance to search for.</param>
+    /// <param name="BattlerInstancePool">The pool which owns the battler instance, used to look up its priority.</param>
+    /// <param name="BattlerInstanceHandle">Handle to the battler instance to search for. Nothing is found if the handle is stale.</param>
     /// <param name="foundOrderingOutput">true if an element in the ordering map corresponding to the battler's priority was found, false otherwise.</param>
     /// <param name="foundListOutput">true if the battler was found in the respective list, false otherwise. If foundOrderingOutput is false, this will necessarily also be false.</param>
-    void FindBattlerDecision(BattlerDecisionOrdering&, const BattlerInstance_shptr&, bool& foundOrderingOutput, bool& foundListOutput);
+    void FindBattlerDecision(BattlerDecisionOrdering&, const BattlerInstancePool&, BattlerInstanceHandle, bool& foundOrderingOutput, bool& foundListOutput);
     /// <summary>
-    /// Attempts to find a decision in the given ordering whose source is equivalent to the given battler instance.
+    /// Attempts to find a decision in the given ordering whose source is the given battler instance.
     /// </summary>
     /// <param name="BattlerDecisionOrdering">reference to the ordering to search. The reference is non-const so that the returned iterators can also be non-const.</param>
-    /// <param name="BattlerInstance_shptr">const reference to the battler instance to search for.</param>
+    /// <param name="BattlerInstancePool">The pool which owns the battler instance, used to look up its priority.</param>
+    /// <param name="BattlerInstanceHandle">Handle to the battler instance to search for. Nothing is found if the handle is stale.</param>
     /// <param name="foundOrderingOutput">true if an element in the ordering map corresponding to the battler's priority was found, false otherwise.</param>
     /// <param name="orderingOutput">if foundOrderingOutput is true, this ref will contain the iterator to the map element.</param>
     /// <param name="foundListOutput">true if the battler was found in the respective list, false otherwise. If foundOrderingOutput is false, this will necessarily also be false.</param>
     /// <param name="listOutput">if foundListOutput is true, this ref will contain the iterator to the list element.</param>
-    void FindBattlerDecision(BattlerDecisionOrdering&, const BattlerInstance_shptr&, bool& foundOrderingOutput, BattlerDecisionOrdering::iterator& orderingOutput, bool& foundListOutput, BattlerDecisionList::iterator& listOutput);
+    void FindBattlerDecision(BattlerDecisionOrdering&, const BattlerInstancePool&, BattlerInstanceHandle, bool& foundOrderingOutput, BattlerDecisionOrdering::iterator& orderingOutput, bool& foundListOutput, BattlerDecisionList::iterator& listOutput);
 
     /// <summary>
     /// Attempts to remove from the given ordering the first decision found with the given battler instance as a source.
     /// </summary>
-    /// <returns>unique_ptr to removed decision.</returns>
-    std::unique_ptr<BattlerDecision> RemoveBattlerDecision(BattlerDecisionOrdering&, const BattlerInstance_shptr&);
+    /// <returns>The removed decision, or nothing if no decision was found.</returns>
+    std::optional<BattlerDecision> RemoveBattlerDecision(BattlerDecisionOrdering&, const BattlerInstancePool&, BattlerInstanceHandle);
 }
@@ -0,0 +1,221 @@
+#include "battlerprogression.h"
+
+namespace AWE {
+    BattlerProgression::BattlerProgression(std::shared_ptr<const ContentSnapshot> content)
+        : _content(std::move(content)), _current(std::make_shared<const Version>(Version { 0, BattlerProgressMap() })), _nextNumber(1) {}
+
+    const ContentSnapshot& BattlerProgression::content() const { return *_content; }
+    std::shared_ptr<const BattlerProgression::Version> BattlerProgression::current() const { return _current.load(); }
+
+    std::shared_ptr<BattlerSnapshot> BattlerProgression::GetSnapshot(const Version& version, BattlerKey key) const {
+        auto found = version.progress.find(key);
+        if (found != version.progress.end()) {
+            return found->second->snapshot;
+        }
+
+        const ContentSnapshot::BattlerEntry* entry = _content->FindBattler(key);
+        return entry ? entry->snapshot : std::shared_ptr<BattlerSnapshot>();
+    }
+
+    std::shared_ptr<BattlerSnapshot> BattlerProgression::GetSnapshot(BattlerKey key) const { return GetSnapshot(*current(), key); }
+
+    std::shared_ptr<const EquipmentSlots> BattlerProgression::GetEquipment(const Version& version, BattlerKey key) const {
+        // Both pointers share ownership with what holds the equipment, so it stays readable after the version is replaced.
+        auto found = version.progress.find(key);
+        if (found != version.progress.end()) {
+            return std::shared_ptr<const EquipmentSlots>(found->second, &found->second->equipment);
+        }
+
+        const ContentSnapshot::BattlerEntry* entry = _content->FindBattler(key);
+        return entry ? std::shared_ptr<const EquipmentSlots>(_content, &entry->battler->currentEquipment()) : std::shared_ptr<const EquipmentSlots>();
+    }
+
+    std::shared_ptr<const EquipmentSlots> BattlerProgression::GetEquipment(BattlerKey key) const { return GetEquipment(*current(), key); }
+
+    BattlerStatValue BattlerProgression::GetStat(BattlerKey bkey, BattlerStatKey skey) const {
+        std::shared_ptr<BattlerSnapshot> snapshot = GetSnapshot(bkey);
+        return snapshot ? snapshot->stats.GetValue(skey) : 0;
+    }
+
+    ElementalAffinityValue BattlerProgression::GetAffinity(BattlerKey bkey, const ElementalAffinityKey& ekey) const {
+        std::shared_ptr<BattlerSnapshot> snapshot = GetSnapshot(bkey);
+        return snapshot ? snapshot->affinities.GetValue(ekey.first, ekey.second) : 0;
+    }
+
+    BattlerProgressionTransaction BattlerProgression::Begin() { return BattlerProgressionTransaction(*this); }
+
+    bool BattlerProgression::Publish(const std::shared_ptr<const Version>& expected, BattlerProgressMap progress) {
+        auto next = std::make_shared<const Version>(Version { _nextNumber++, std::move(progress) });
+        std::shared_ptr<const Version> current = expected;
+        return _current.compare_exchange_strong(current, std::move(next));
+    }
+
+    void BattlerProgression::Restore(std::shared_ptr<const Version> version) { _current.store(std::move(version)); }
+
+    void BattlerProgression::Clear() { _current.store(std::make_shared<const Version>(Version { _nextNumber++, BattlerProgressMap() })); }
+
+    std::optional<BattlerInstance> BattlerProgression::Spawn(BattlerKey key, BattlerStatValue hp) const {
+        const ContentSnapshot::BattlerEntry* entry = _content->FindBattler(key);
+        if (!entry) {
+            return std::nullopt;
+        }
+
+        return BattlerInstance(*entry->battler, GetSnapshot(*current(), key), hp);
+    }
+
+    // Transaction
+
+    BattlerProgressionTransaction::BattlerProgressionTransaction() : _progression(nullptr) {}
+    BattlerProgressionTransaction::BattlerProgressionTransaction(BattlerProgression& progression) : _progression(&progression), _base(progression.current()) {}
+
+    bool BattlerProgressionTransaction::isOpen() const { return _progression && _base; }
+    const std::shared_ptr<const BattlerProgression::Version>& BattlerProgressionTransaction::base() const { return _base; }
+    bool BattlerProgressionTransaction::isChanged() const { return !_changes.empty(); }
+
+    BattlerProgression::BattlerProgress* BattlerProgressionTransaction::MutableProgress(BattlerKey key) {
+        if (!isOpen()) {
+            return nullptr;
+        }
+
+        auto changed = _changes.find(key);
+        if (changed == _changes.end()) {
+            std::shared_ptr<BattlerProgression::BattlerProgress> progress;
+            auto found = _base->progress.find(key);
+            if (found != _base->progress.end()) {
+                progress = std::make_shared<BattlerProgression::BattlerProgress>(*found->second);
+            } else {
+                const ContentSnapshot::BattlerEntry* entry = _progression->content().FindBattler(key);
+                if (!entry) {
+                    return nullptr;
+                }
+
+                progress = std::make_shared<BattlerProgression::BattlerProgress>();
+                progress->equipment = entry->battler->currentEquipment();
+                progress->snapshot = entry->snapshot;
+            }
+
+            changed = _changes.insert(std::make_pair(key, std::move(progress))).first;
+        }
+
+        // The snapshot is still shared with the base version until the first change, and may be shared with previews after that.
+        std::shared_ptr<BattlerSnapshot>& snapshot = changed->second->snapshot;
+        if (snapshot.use_count() > 1) {
+            snapshot = std::make_shared<BattlerSnapshot>(*snapshot);
+        }
+
+        snapshot->version = BattlerInstance::NewVersion();
+        return changed->second.get();
+    }
+
+    std::shared_ptr<BattlerSnapshot> BattlerProgressionTransaction::GetSnapshot(BattlerKey key) const {
+        if (!isOpen()) {
+            return std::shared_ptr<BattlerSnapshot>();
+        }
+
+        auto changed = _changes.find(key);
+        return (changed != _changes.end()) ? changed->second->snapshot : _progression->GetSnapshot(*_base, key);
+    }
+
+    std::shared_ptr<const EquipmentSlots> BattlerProgressionTransaction::GetEquipment(BattlerKey key) const {
+        if (!isOpen()) {
+            return std::shared_ptr<const EquipmentSlots>();
+        }
+
+        auto changed = _changes.find(key);
+        return (changed != _changes.end()) ? std::shared_ptr<const EquipmentSlots>(changed->second, &changed->second->equipment) : _progression->GetEquipment(*_base, key);
+    }
+
+    BattlerStatValue BattlerProgressionTransaction::GetStat(BattlerKey bkey, BattlerStatKey skey) const {
+        std::shared_ptr<BattlerSnapshot> snapshot = GetSnapshot(bkey);
+        return snapshot ? snapshot->stats.GetValue(skey) : 0;
+    }
+
+    ElementalAffinityValue BattlerProgressionTransaction::GetAffinity(BattlerKey bkey, const ElementalAffinityKey& ekey) const {
+        std::shared_ptr<BattlerSnapshot> snapshot = GetSnapshot(bkey);
+        return snapshot ? snapshot->affinities.GetValue(ekey.first, ekey.second) : 0;
+    }
+
+    BattlerStatValue BattlerProgressionTransaction::AdjustStat(BattlerKey bkey, BattlerStatKey skey, int delta) {
+        BattlerProgression::BattlerProgress* progress = MutableProgress(bkey);
+        if (!progress) {
+            return 0;
+        }
+
+        progress->stats[skey] += delta;
+        BattlerStatValue newval = progress->snapshot->stats.AddValue(skey, delta);
+        progress->snapshot->RefreshStatTotals();
+        return newval;
+    }
+
+    ElementalAffinityValue BattlerProgressionTransaction::AdjustAffinity(BattlerKey bkey, const ElementalAffinityKey& ekey, int delta) {
+        BattlerProgression::BattlerProgress* progress = MutableProgress(bkey);
+        if (!progress) {
+            return 0;
+        }
+
+        progress->affinities[ekey] += delta;
+        return progress->snapshot->affinities.AddValue(ekey, delta);
+    }
+
+    Equipment_shptr BattlerProgressionTransaction::Equip(BattlerKey bkey, Equipment_shptr equipment) {
+        BattlerProgression::BattlerProgress* progress = MutableProgress(bkey);
+        if (!progress) {
+            return Equipment_shptr();
+        }
+
+        EquipmentDelta delta;
+        progress->equipment.Equip(std::move(equipment), delta);
+        progress->snapshot->ApplyEquipmentDelta(delta);
+        return delta.unequipped;
+    }
+
+    Equipment_shptr BattlerProgressionTransaction::Unequip(BattlerKey bkey, EquipmentSlotKey slot) {
+        BattlerProgression::BattlerProgress* progress = MutableProgress(bkey);
+        if (!progress) {
+            return Equipment_shptr();
+        }
+
+        EquipmentDelta delta;
+        progress->equipment.Unequip(slot, delta);
+        progress->snapshot->ApplyEquipmentDelta(delta);
+        return delta.unequipped;
+    }
+
+    std::optional<BattlerInstance> BattlerProgressionTransaction::Spawn(BattlerKey key, BattlerStatValue hp) const {
+        if (!isOpen()) {
+            return std::nullopt;
+        }
+
+        const ContentSnapshot::BattlerEntry* entry = _progression->content().FindBattler(key);
+        if (!entry) {
+            return std::nullopt;
+        }
+
+        return BattlerInstance(*entry->battler, GetSnapshot(key), hp);
+    }
+
+    bool BattlerProgressionTransaction::Commit() {
+        if (!isOpen()) {
+            return false;
+        }
+
+        bool published = true;
+        if (!_changes.empty()) {
+            // Only the map of pointers is copied; every battler the transaction did not change keeps sharing its progress with the base version.
+            BattlerProgression::BattlerProgressMap progress = _base->progress;
+            for (auto& change : _changes) {
+                progress[change.first] = std::move(change.second);
+            }
+
+            published = _progression->Publish(_base, std::move(progress));
+        }
+
+        Abort();
+        return published;
+    }
+
+    void BattlerProgressionTransaction::Abort() {
+        _changes.clear();
+        _base.reset();
+    }
+}
@@ -0,0 +1,202 @@
+#pragma once
+#include <atomic>
+#include <map>
+#include <memory>
+#include <optional>
+#include "../store/contentsnapshot.h"
+
+namespace AWE {
+    // Forward declaration, defined later in the file.
+    class BattlerProgressionTransaction;
+
+    /// <summary>
+    /// Everything one save has changed about its battlers, e.g. by leveling up. Layered on top of a frozen ContentSnapshot, which it never changes.
+    /// The progression is a series of immutable versions. Changes are made in a BattlerProgressionTransaction, which publishes a new version when it commits;
+    /// the new version shares the progress of every battler the transaction did not touch with the version before it.
+    /// Holding on to a version costs nothing more than a pointer, and restoring it undoes everything committed since, so previews and undo never copy whole battlers.
+    /// Readers on any thread can take the current version and keep reading it, consistently, while new versions are committed.
+    /// </summary>
+    class BattlerProgression {
+    public:
+        /// <summary>
+        /// The changes made to one battler. Never changed once it is part of a version.
+        /// </summary>
+        struct BattlerProgress {
+            /// <summary>
+            /// Sum of the amounts each stat was adjusted by. The stat itself may differ by less, since stats do not go below 0.
+            /// </summary>
+            std::map<BattlerStatKey, int> stats;
+            /// <summary>
+            /// Sum of the amounts each elemental affinity was adjusted by.
+            /// </summary>
+            std::map<ElementalAffinityKey, int, ElementalAffinityKey_comp> affinities;
+            /// <summary>
+            /// The battler's equipment, starting out as the battler's loaded equipment.
+            /// </summary>
+            EquipmentSlots equipment;
+            /// <summary>
+            /// The battler's snapshot with every change applied. Battler instances sharing it copy it before changing anything.
+            /// </summary>
+            std::shared_ptr<BattlerSnapshot> snapshot;
+        };
+
+        typedef std::map<BattlerKey, std::shared_ptr<const BattlerProgress>> BattlerProgressMap;
+
+        /// <summary>
+        /// One committed state of the progression. Never changed once published.
+        /// </summary>
+        struct Version {
+            /// <summary>
+            /// Counts up with every version the progression publishes. A restored version keeps its number.
+            /// </summary>
+            unsigned long number;
+            BattlerProgressMap progress;
+        };
+
+    private:
+        std::shared_ptr<const ContentSnapshot> _content;
+        std::atomic<std::shared_ptr<const Version>> _current;
+        std::atomic<unsigned long> _nextNumber;
+
+        /// <summary>
+        /// Publishes the given version, as long as the current version is still the expected one.
+        /// </summary>
+        /// <returns>true if the version was published, false if another version was published since the expected one.</returns>
+        bool Publish(const std::shared_ptr<const Version>& expected, BattlerProgressMap);
+
+        friend class BattlerProgressionTransaction;
+
+    public:
+        /// <summary>
+        /// Constructor. Starts out with an empty version, i.e. the content as it was loaded.
+        /// </summary>
+        /// <param name="">The content to layer on top of. Must not be empty.</param>
+        BattlerProgression(std::shared_ptr<const ContentSnapshot>);
+        BattlerProgression(const BattlerProgression&) = delete;
+        BattlerProgression& operator=(const BattlerProgression&) = delete;
+
+        /// <returns>const reference to the content this progression is layered on top of.</returns>
+        const ContentSnapshot& content() const;
+        /// <returns>The current version. Safe to call from any thread; the version stays readable for as long as the pointer is held.</returns>
+        std::shared_ptr<const Version> current() const;
+
+        /// <returns>Snapshot of the given battler in the given version, or an empty pointer if the content has no such battler.</returns>
+        std::shared_ptr<BattlerSnapshot> GetSnapshot(const Version&, BattlerKey) const;
+        /// <returns>Snapshot of the given battler in the current version, or an empty pointer if the content has no such battler.</returns>
+        std::shared_ptr<BattlerSnapshot> GetSnapshot(BattlerKey) const;
+        /// <returns>Equipment of the given battler in the given version, or an empty pointer if the content has no such battler.</returns>
+        std::shared_ptr<const EquipmentSlots> GetEquipment(const Version&, BattlerKey) const;
+        /// <returns>Equipment of the given battler in the current version, or an empty pointer if the content has no such battler.</returns>
+        std::shared_ptr<const EquipmentSlots> GetEquipment(BattlerKey) const;
+        /// <returns>Current value of the given battler's stat, or 0 if no such battler or stat exist.</returns>
+        BattlerStatValue GetStat(BattlerKey, BattlerStatKey) const;
+        /// <returns>Current value of the given battler's elemental affinity, or 0 if no such battler or affinity exist.</returns>
+        ElementalAffinityValue GetAffinity(BattlerKey, const ElementalAffinityKey&) const;
+
+        /// <summary>
+        /// Begins a transaction on top of the current version.
+        /// </summary>
+        BattlerProgressionTransaction Begin();
+        /// <summary>
+        /// Makes the given version, usually one taken earlier from current(), the current version again. Everything committed since is undone.
+        /// </summary>
+        /// <param name="">Version to restore. Must have been published by this progression.</param>
+        void Restore(std::shared_ptr<const Version>);
+        /// <summary>
+        /// Publishes an empty version, going back to the content as it was loaded.
+        /// </summary>
+        void Clear();
+
+        /// <summary>
+        /// Creates a new battler instance of the given battler, with every change of the current version applied. Safe to call from any thread.
+        /// </summary>
+        /// <param name="hp">If 0, the battler instance will be created using the `MXHP` stat of the battler. Otherwise, the battler instance will have the given HP value.</param>
+        /// <returns>The new battler instance, or nothing if the content has no such battler.</returns>
+        std::optional<BattlerInstance> Spawn(BattlerKey, BattlerStatValue hp = 0) const;
+    };
+
+    /// <summary>
+    /// A set of changes to a BattlerProgression, made on top of the version which was current when the transaction began. Until it commits, nothing outside of the
+    /// transaction sees the changes, but the transaction itself reads and spawns with them applied, so it doubles as a preview.
+    /// Only the battlers it changes are copied. Aborting simply drops the copies.
+    /// </summary>
+    class BattlerProgressionTransaction {
+    private:
+        BattlerProgression* _progression;
+        std::shared_ptr<const BattlerProgression::Version> _base;
+        std::map<BattlerKey, std::shared_ptr<BattlerProgression::BattlerProgress>> _changes;
+
+        /// <summary>
+        /// Gets this transaction's own copy of the progress of the given battler, copying it from the base version if needed, and makes sure no battler instance shares its snapshot.
+        /// The snapshot gets a new version, since the caller is about to change it.
+        /// </summary>
+        /// <returns>Pointer to the progress, or nullptr if the transaction is not open or the content has no such battler.</returns>
+        BattlerProgression::BattlerProgress* MutableProgress(BattlerKey);
+
+    public:
+        /// <summary>
+        /// Default constructor. The transaction is not open, and every change to it does nothing.
+        /// </summary>
+        BattlerProgressionTransaction();
+        /// <summary>
+        /// Constructor. Begins a transaction on top of the progression's current version.
+        /// </summary>
+        BattlerProgressionTransaction(BattlerProgression&);
+
+        /// <returns>true if the transaction has begun and has not yet committed or aborted.</returns>
+        bool isOpen() const;
+        /// <returns>The version the transaction began on top of, or an empty pointer if it is not open.</returns>
+        const std::shared_ptr<const BattlerProgression::Version>& base() const;
+        /// <returns>true if the transaction has changed anything.</returns>
+        bool isChanged() const;
+
+        /// <returns>Snapshot of the given battler with the transaction's changes applied, or an empty pointer if the transaction is not open or the content has no such battler.</returns>
+        std::shared_ptr<BattlerSnapshot> GetSnapshot(BattlerKey) const;
+        /// <returns>Equipment of the given battler with the transaction's changes applied, or an empty pointer if the transaction is not open or the content has no such battler.</returns>
+        std::shared_ptr<const EquipmentSlots> GetEquipment(BattlerKey) const;
+        /// <returns>Value of the given battler's stat with the transaction's changes applied, or 0 if no such battler or stat exist.</returns>
+        BattlerStatValue GetStat(BattlerKey, BattlerStatKey) const;
+        /// <returns>Value of the given battler's elemental affinity with the transaction's changes applied, or 0 if no such battler or affinity exist.</returns>
+        ElementalAffinityValue GetAffinity(BattlerKey, const ElementalAffinityKey&) const;
+
+        /// <summary>
+        /// Adjusts the stat of the given battler by the given amount.
+        /// </summary>
+        /// <returns>New value of the battler's stat, or 0 if the transaction is not open or no such battler or stat exist.</returns>
+        BattlerStatValue AdjustStat(BattlerKey, BattlerStatKey, int);
+        /// <summary>
+        /// Adjusts the elemental affinity of the given battler by the given amount.
+        /// </summary>
+        /// <returns>New value of the battler's elemental affinity, or 0 if the transaction is not open or no such battler exists.</returns>
+        ElementalAffinityValue AdjustAffinity(BattlerKey, const ElementalAffinityKey&, int);
+        /// <summary>
+        /// Equips the given equipment to the given battler, at the first empty slot of its type or else the last slot of its type, the same as EquipmentSlots::Equip.
+        /// Only the equipment which entered and left the slots is applied to the battler's snapshot. Does nothing if the battler has no slot of the equipment's type.
+        /// </summary>
+        /// <returns>The equipment which was replaced, or an empty pointer if the slot was empty, nothing was equipped, or the transaction is not open.</returns>
+        Equipment_shptr Equip(BattlerKey, Equipment_shptr);
+        /// <summary>
+        /// Unequips the equipment at the given slot of the given battler. Only the unequipped equipment is applied to the battler's snapshot.
+        /// </summary>
+        /// <returns>The unequipped equipment, or an empty pointer if the slot was empty or did not exist, or the transaction is not open.</returns>
+        Equipment_shptr Unequip(BattlerKey, EquipmentSlotKey);
+
+        /// <summary>
+        /// Creates a new battler instance of the given battler, with the transaction's changes applied. Useful for previewing the changes before committing them.
+        /// </summary>
+        /// <param name="hp">If 0, the battler instance will be created using the `MXHP` stat of the battler. Otherwise, the battler instance will have the given HP value.</param>
+        /// <returns>The new battler instance, or nothing if the transaction is not open or the content has no such battler.</returns>
+        std::optional<BattlerInstance> Spawn(BattlerKey, BattlerStatValue hp = 0) const;
+
+        /// <summary>
+        /// Publishes the transaction's changes as the progression's new version and closes the transaction. Publishes nothing if there are no changes.
+        /// Fails if another version was published since the transaction began, in which case nothing is published; begin again on top of the new version.
+        /// </summary>
+        /// <returns>true if the changes were published, false if the transaction was not open or another version was published first.</returns>
+        bool Commit();
+        /// <summary>
+        /// Drops the transaction's changes and closes it.
+        /// </summary>
+        void Abort();
+    };
+}
@@ -1,78 +1,128 @@
 #include "gamebattleinfo.h"
 
 namespace AWE {
-    GameBattleInfo::GameBattleInfo(const GameLOVStorage& lov, const GameXLOStorage& xlo, BattlerInstance_shptr enemy) : _damagecalc(DamageCalculator(lov, xlo)), _enemy(std::move(enemy)) {
-        RefreshCharacters(xlo);
+    GameBattleInfo::GameBattleInfo(BattlerProgression& progression, BattlerInstance enemy, std::size_t arenaSize)
+            : _arena(arenaSize)
+            , _progression(&progression)
+            , _damagecalc(DamageCalculator(progression.content().lov(), progression.content().xlo()))
+            , _damagecache(_damagecalc)
+            , _instances(&_arena)
+            , _decisions(&_arena) {
+        _enemy = _instances.Insert(std::move(enemy));
+        RefreshCharacters();
     }
-    GameBattleInfo::GameBattleInfo(const GameLOVStorage& lov, const GameXLOStorage& xlo) : _damagecalc(DamageCalculator(lov, xlo)) {
-        const BattlerMap& battlers = xlo.battlers();
-        Battler_shptr enemy;
+    GameBattleInfo::GameBattleInfo(BattlerProgression& progression, std::size_t arenaSize)
+            : _arena(arenaSize)
+            , _progression(&progression)
+            , _damagecalc(DamageCalculator(progression.content().lov(), progression.content().xlo()))
+            , _damagecache(_damagecalc)
+            , _instances(&_arena)
+            , _decisions(&_arena) {
+        const BattlerMap& battlers = progression.content().xlo().battlers();
+        const BattlerMap::value_type* enemy = nullptr;
         for (const BattlerMap::value_type& battler : battlers) {
             if (battler.second->isCharacter()) {
-                _characters.push_back(std::make_shared<BattlerInstance>(BattlerInstance(*battler.second)));
+                std::optional<BattlerInstance> character = progression.Spawn(battler.first);
+                if (character) {
+                    _characters.push_back(_instances.Insert(std::move(*character)));
+                }
             } else {
                 if (enemy) {
-                    if (battler.second->textureIndex() < enemy->textureIndex()) {
-                        enemy = battler.second;
+                    if (battler.second->textureIndex() < enemy->second->textureIndex()) {
+                        enemy = &battler;
                     }
                 } else {
-                    enemy = battler.second;
+                    enemy = &battler;
                 }
             }
         }
 
         if (enemy) {
-            _enemy = std::make_shared<BattlerInstance>(BattlerInstance(*enemy));
+            std::optional<BattlerInstance> instance = progression.Spawn(enemy->first);
+            if (instance) {
+                _enemy = _instances.Insert(std::move(*instance));
+            }
         }
     }
 
-    const std::vector<BattlerInstance_shptr>& GameBattleInfo::characters() const { return _characters; }
+    const BattleArena& GameBattleInfo::arena() const { return _arena; }
+    const BattlerProgression& GameBattleInfo::progression() const { return *_progression; }
+    const BattlerInstancePool& GameBattleInfo::instances() const { return _instances; }
+    const std::vector<BattlerInstanceHandle>& GameBattleInfo::characters() const { return _characters; }
     const DamageCalculator& GameBattleInfo::damagecalc() const { return _damagecalc; }
+    const DamageCache& GameBattleInfo::damagecache() const { return _damagecache; }
     const BattlerDecisionOrdering& GameBattleInfo::decisions() const { return _decisions; }
-    const BattlerInstance_shptr& GameBattleInfo::enemy() const { return _enemy; }
+    BattlerInstanceHandle GameBattleInfo::enemy() const { return _enemy; }
 
+    DamageCache* GameBattleInfo::damagecache() { return &_damagecache; }
+    BattlerInstancePool* GameBattleInfo::instances() { return &_instances; }
     BattlerDecisionOrdering* GameBattleInfo::decisions() { return &_decisions; }
-    BattlerInstance_shptr GameBattleInfo::enemy() { return _enemy; }
 
-    BattlerInstance_shptr GameBattleInfo::enemy(BattlerInstance_shptr newval) { BattlerInstance_shptr oldval = std::move(_enemy); _enemy = std::move(newval); return oldval; }
+    BattlerInstanceHandle GameBattleInfo::enemy(BattlerInstance newval) {
+        _instances.Remove(_enemy);
+        _enemy = _instances.Insert(std::move(newval));
+        return _enemy;
+    }
 
-    bool GameBattleInfo::GoToNextEnemy(const BattlerMap& battlers) {
-        if (!_enemy) {
+    bool GameBattleInfo::GoToNextEnemy() {
+        const BattlerInstance* current = _instances.Get(_enemy);
+        if (!current) {
             return false;
         }
 
+        unsigned int currentTextureIndex = current->textureIndex();
+
         bool found = false;
-        Battler_shptr next;
+        const BattlerMap::value_type* next = nullptr;
 
-        for (const BattlerMap::value_type& battler : battlers) {
+        for (const BattlerMap::value_type& battler : _progression->content().xlo().battlers()) {
             if (battler.second->isCharacter()) {
                 continue;
             }
 
             if (next) {
-                if (battler.second->textureIndex() < next->textureIndex() && battler.second->textureIndex() > _enemy->textureIndex()) {
-                    next = battler.second;
+                if (battler.second->textureIndex() < next->second->textureIndex() && battler.second->textureIndex() > currentTextureIndex) {
+                    next = &battler;
                 }
-            } else if (battler.second->textureIndex() > _enemy->textureIndex()) {
+            } else if (battler.second->textureIndex() > currentTextureIndex) {
                 found = true;
-                next = battler.second;
+                next = &battler;
             }
         }
 
         if (found) {
-            _enemy = std::make_shared<BattlerInstance>(BattlerInstance(*next));
+            std::optional<BattlerInstance> instance = _progression->Spawn(next->first);
+            EndBattle();
+            if (instance) {
+                _enemy = _instances.Insert(std::move(*instance));
+            }
+            RefreshCharacters();
         }
 
         return found;
     }
 
-    void GameBattleInfo::RefreshCharacters(const GameXLOStorage& xlo) {
+    void GameBattleInfo::RefreshCharacters() {
+        for (BattlerInstanceHandle character : _characters) {
+            _instances.Remove(character);
+        }
         _characters.clear();
-        const BattlerMap& battlers = xlo.battlers();
-        for (const BattlerMap::value_type& battler : battlers) {
+        for (const BattlerMap::value_type& battler : _progression->content().xlo().battlers()) {
             if (battler.second->isCharacter()) {
-                _characters.push_back(std::make_shared<BattlerInstance>(BattlerInstance(*battler.second)));
+                std::optional<BattlerInstance> character = _progression->Spawn(battler.first);
+                if (character) {
+                    _characters.push_back(_instances.Insert(std::move(*character)));
+                }
             }
         }
     }
+
+    void GameBattleInfo::EndBattle() {
+        // Everything allocated from the arena has to be destroyed before it is released.
+        _decisions.clear();
+        _instances.Reset();
+        _characters.clear();
+        _enemy = BattlerInstanceHandle();
+        _arena.Release();
+    }
 }
@@ -1,60 +1,95 @@
 #pragma once
 #include "battlerdecision.h"
+#include "battlerprogression.h"
 #include "../misc/damage.h"
+#include "../misc/damagecache.h"
 #include "../models/battler.h"
-#include "../store/gamelovstorage.h"
-#include "../store/gamexlostorage.h"
+#include "../store/battlearena.h"
 
 namespace AWE {
     /// <summary>
     /// Represents battle information about the game. For this early version of the project, each battle only has one enemy for simplicity's sake.
+    /// Every battler instance in the battle is owned by the instance pool; everything else refers to them by handle.
+    /// The instance pool and the decision ordering allocate from the battle arena, which is released in one go whenever a battle ends.
+    /// Battler instances are spawned through the save's battler progression, so they reflect any level-ups without the content ever changing.
     /// </summary>
     class GameBattleInfo {
     private:
+        BattleArena _arena;
+        BattlerProgression* _progression;
         DamageCalculator _damagecalc;
-        std::vector<BattlerInstance_shptr> _characters;
+        DamageCache _damagecache;
+        BattlerInstancePool _instances;
+        std::vector<BattlerInstanceHandle> _characters;
         BattlerDecisionOrdering _decisions;
-        BattlerInstance_shptr _enemy;
+        BattlerInstanceHandle _enemy;
 
     public:
+        /// <summary>
+        /// Arena size which fits a whole battle of the shipped content in one block. Its measured high-water mark is 5616 bytes; the rest leaves room for content to grow.
+        /// </summary>
+        static const std::size_t BATTLE_ARENA_SIZE = 8192;
+
         /// <summary>
         /// Constructor. Automatically determines the initial enemy by reading texture indicies.
         /// </summary>
-        GameBattleInfo(const GameLOVStorage&, const GameXLOStorage&);
+        /// <param name="arenaSize">Initial size of the battle arena. Pass a previous run's arena().highWaterMark() to fit a whole battle in one block. If 0, the arena's default is used.</param>
+        GameBattleInfo(BattlerProgression&, std::size_t arenaSize = 0);
         /// <summary>
         /// Constructor.
         /// </summary>
-        /// <param name="enemy">The initial enemy.</param>
-        GameBattleInfo(const GameLOVStorage&, const GameXLOStorage&, BattlerInstance_shptr enemy);
+        /// <param name="enemy">The initial enemy, which is moved into the instance pool.</param>
+        /// <param name="arenaSize">Initial size of the battle arena. If 0, the arena's default is used.</param>
+        GameBattleInfo(BattlerProgression&, BattlerInstance enemy, std::size_t arenaSize = 0);
+        GameBattleInfo(const GameBattleInfo&) = delete;
+        GameBattleInfo& operator=(const GameBattleInfo&) = delete;
+
+        /// <returns>const reference to the arena every battle-scoped allocation comes from. Its high-water mark tells how big one battle got.</returns>
+        const BattleArena& arena() const;
 
+        /// <returns>const reference to the battler progression instances are spawned through.</returns>
+        const BattlerProgression& progression() const;
         /// <returns>const reference to the damage calculator.</returns>
         const DamageCalculator& damagecalc() const;
-        /// <returns>const reference to the character battler instance list.</returns>
-        const std::vector<BattlerInstance_shptr>& characters() const;
+        /// <returns>const reference to the damage cache which sits in front of the damage calculator.</returns>
+        const DamageCache& damagecache() const;
+        /// <returns>const reference to the pool which owns every battler instance in the battle.</returns>
+        const BattlerInstancePool& instances() const;
+        /// <returns>const reference to the handles of the character battler instances.</returns>
+        const std::vector<BattlerInstanceHandle>& characters() const;
         /// <returns>const reference to the current battler decision ordering.</returns>
         const BattlerDecisionOrdering& decisions() const;
-        /// <returns>const reference to the battler instance of the current enemy in the battle.</returns>
-        const BattlerInstance_shptr& enemy() const;
+        /// <returns>Handle to the battler instance of the current enemy in the battle.</returns>
+        BattlerInstanceHandle enemy() const;
 
+        /// <returns>Mutable pointer to the damage cache.</returns>
+        DamageCache* damagecache();
+        /// <returns>Mutable pointer to the pool which owns every battler instance in the battle.</returns>
+        BattlerInstancePool* instances();
         /// <returns>Mutable pointer to the current battler decision ordering.</returns>
         BattlerDecisionOrdering* decisions();
-        /// <returns>Mutable shared pointer to the battler instance of the current enemy in the battle.</returns>
-        BattlerInstance_shptr enemy();
 
-        /// <param name="">New value for enemy.</param>
-        /// <returns>Old value for enemy.</returns>
-        BattlerInstance_shptr enemy(BattlerInstance_shptr);
+        /// <summary>
+        /// Replaces the current enemy. The old enemy is removed from the pool, so any handle still referring to it goes stale.
+        /// </summary>
+        /// <param name="">New enemy, which is moved into the instance pool.</param>
+        /// <returns>Handle to the new enemy.</returns>
+        BattlerInstanceHandle enemy(BattlerInstance);
 
         /// <summary>
-        /// Uses texture indicies from the battler map to determine what the next enemy should be. If the current battler has the highest texture index of the enemies,
+        /// Uses texture indicies from the content's battlers to determine what the next enemy should be. If the current battler has the highest texture index of the enemies,
         /// then this function will fail to find a new enemy and will return false.
+        /// If a new enemy is found, the current battle is ended first, so the character instances are created anew along with the new enemy.
         /// </summary>
-        /// <param name="">Map of battlers to search through.</param>
         /// <returns>true if a new enemy was found, false otherwise.</returns>
-        bool GoToNextEnemy(const BattlerMap&);
+        bool GoToNextEnemy();
+        /// <summary>
+        /// Internally creates new battler instances of the content's character battlers, through the battler progression. The old character instances are removed from the pool.
+        /// </summary>
+        void RefreshCharacters();
         /// <summary>
-        /// Internally creates new battler instances from the character battlers contained in the XLO storage.
+        /// Ends the current battle: every battler instance and decision is destroyed and the battle arena is released. Every handle issued so far goes stale.
         /// </summary>
-        void RefreshCharacters(const GameXLOStorage&);
+        void EndBattle();
     };
 }
@@ -205,7 +205,7 @@ namespace AWE {
             return false;
         }
 
-        RemoveBattlerDecision(*_battle->decisions(), _battle->enemy());
+        RemoveBattlerDecision(*_battle->decisions(), *_battle->instances(), _battle->enemy());
         _step = GameStateStep::BEGINNING;
         return true;
     }
@@ -219,7 +219,7 @@ namespace AWE {
             return false;
         }
 
-        RemoveBattlerDecision(*_battle->decisions(), _battle->enemy());
+        RemoveBattlerDecision(*_battle->decisions(), *_battle->instances(), _battle->enemy());
         _step = GameStateStep::PROCESSING;
         return true;
     }
@@ -233,14 +233,19 @@ namespace AWE {
             return false;
         }
 
-        BattlerInstance_shptr enemy = _battle->enemy();
+        BattlerInstanceHandle enemyHandle = _battle->enemy();
+        const BattlerInstance* enemy = _battle->instances()->Get(enemyHandle);
+        if (!enemy) {
+            return false;
+        }
+
         BattlerDecisionOrdering* decisions = _battle->decisions();
 
         BattlerDecisionOrdering::iterator orderitr;
         BattlerDecisionList::iterator _;
         bool foundOrderitr = false, foundDecision = false;
 
-        FindBattlerDecision(*decisions, enemy, foundOrderitr, orderitr, foundDecision, _);
+        FindBattlerDecision(*decisions, *_battle->instances(), enemyHandle, foundOrderitr, orderitr, foundDecision, _);
 
         if (foundDecision || enemy->skills().empty()) {
             _step = GameStateStep::DONE;
@@ -248,7 +253,7 @@ namespace AWE {
         }
 
         if (!foundOrderitr) {
-            orderitr = decisions->insert(decisions->begin(), std::make_pair(enemy->priority(), std::vector<BattlerDecision>()));
+            orderitr = decisions->try_emplace(enemy->priority()).first;
         }
 
         srand(time(nullptr));
@@ -258,11 +263,11 @@ namespace AWE {
         auto target = rand() % size;
         short delta = 1 - (2 * (rand() % 2));
 
-        while (_battle->characters().at(target)->hp() <= 0) {
+        while (_battle->instances()->Get(_battle->characters().at(target))->hp() <= 0) {
             target = (target + delta) % size;
         }
 
-        orderitr->second.push_back(BattlerDecision(skill->second, enemy, _battle->characters().at(target)));
+        orderitr->second.push_back(BattlerDecision(*skill->second, enemyHandle, _battle->characters().at(target)));
 
         _step = GameStateStep::DONE;
         return true;
@@ -280,7 +285,7 @@ namespace AWE {
 
         bool foundOrderitr = false, foundDecision = false;
 
-        FindBattlerDecision(*_battle->decisions(), _battle->enemy(), foundOrderitr, foundDecision);
+        FindBattlerDecision(*_battle->decisions(), *_battle->instances(), _battle->enemy(), foundOrderitr, foundDecision);
         if (foundOrderitr && foundDecision) {
             _step = GameStateStep::DONE;
             return true;
@@ -293,17 +298,17 @@ namespace AWE {
 
     /* Skill Name */
 
-    GameState_Battle_SkillName::GameState_Battle_SkillName() : GameState(), _textbox(nullptr) {}
-    GameState_Battle_SkillName::GameState_Battle_SkillName(TextBox& textbox) : GameState(), _textbox(&textbox) {}
+    GameState_Battle_SkillName::GameState_Battle_SkillName() : GameState(), _textbox(nullptr), _skill(nullptr) {}
+    GameState_Battle_SkillName::GameState_Battle_SkillName(TextBox& textbox) : GameState(), _textbox(&textbox), _skill(nullptr) {}
 
     const unsigned int GameState_Battle_SkillName::DEFAULT_DISPLAY_MILLIS = 1000;
 
     const TextBox* GameState_Battle_SkillName::textbox() const { return _textbox; }
-    const Skill_shptr& GameState_Battle_SkillName::skill() const { return _skill; }
+    const Skill* GameState_Battle_SkillName::skill() const { return _skill; }
     const std::unique_ptr<sf::Clock>& GameState_Battle_SkillName::timer() const { return _timer; }
 
     TextBox* GameState_Battle_SkillName::textbox(TextBox& newval) { TextBox* oldval = _textbox; _textbox = &newval; return oldval; }
-    Skill_shptr GameState_Battle_SkillName::skill(Skill_shptr newval) { Skill_shptr oldval = std::move(_skill); _skill = std::move(newval); return oldval; }
+    const Skill* GameState_Battle_SkillName::skill(const Skill& newval) { const Skill* oldval = _skill; _skill = &newval; return oldval; }
 
     bool GameState_Battle_SkillName::Begin() {
         if (_step != GameStateStep::BEGINNING) {
@@ -354,17 +359,19 @@ namespace AWE {
     /* Damage Calculation */
 
     GameState_Battle_DamageCalculation::GameState_Battle_DamageCalculation()
-        : GameState(), _isAcknowledged(false), _calc(nullptr), _targetsprite(nullptr), _damagetext(nullptr), _prompttext(nullptr), _skilltext(nullptr), _decision(nullptr) {}
+        : GameState(), _isAcknowledged(false), _calc(nullptr), _cache(nullptr), _instances(nullptr), _targetsprite(nullptr), _damagetext(nullptr), _prompttext(nullptr), _skilltext(nullptr), _decision(nullptr) {}
     GameState_Battle_DamageCalculation::GameState_Battle_DamageCalculation(const DamageCalculator& calc, TextBox& damagetext)
-        : GameState(), _isAcknowledged(false), _calc(&calc), _targetsprite(nullptr), _damagetext(&damagetext), _prompttext(nullptr), _skilltext(nullptr), _decision(nullptr) {}
+        : GameState(), _isAcknowledged(false), _calc(&calc), _cache(nullptr), _instances(nullptr), _targetsprite(nullptr), _damagetext(&damagetext), _prompttext(nullptr), _skilltext(nullptr), _decision(nullptr) {}
     GameState_Battle_DamageCalculation::GameState_Battle_DamageCalculation(const DamageCalculator& calc, TextBox& damagetext, TextBox& prompttext)
-        : GameState(), _isAcknowledged(false), _calc(&calc), _targetsprite(nullptr), _damagetext(&damagetext), _prompttext(&prompttext), _skilltext(nullptr), _decision(nullptr) {}
+        : GameState(), _isAcknowledged(false), _calc(&calc), _cache(nullptr), _instances(nullptr), _targetsprite(nullptr), _damagetext(&damagetext), _prompttext(&prompttext), _skilltext(nullptr), _decision(nullptr) {}
 
     const unsigned int GameState_Battle_DamageCalculation::DEFAULT_PROMPT_WAIT_MILLIS = 1000;
     const std::string GameState_Battle_DamageCalculation::DEFAULT_PROMPT_MESSAGE = "PRESS ANY\nKEY TO\nPROCEED";
 
     const DamageCalculator* GameState_Battle_DamageCalculation::calc() const { return _calc; }
-    const std::unique_ptr<Damage>& GameState_Battle_DamageCalculation::result() const { return _result; }
+    const DamageCache* GameState_Battle_DamageCalculation::cache() const { return _cache; }
+    const BattlerInstancePool* GameState_Battle_DamageCalculation::instances() const { return _instances; }
+    const std::optional<Damage>& GameState_Battle_DamageCalculation::result() const { return _result; }
     const AWESprite* GameState_Battle_DamageCalculation::targetsprite() const { return _targetsprite; }
     const TextBox* GameState_Battle_DamageCalculation::damagetext() const { return _damagetext; }
     const TextBox* GameState_Battle_DamageCalculation::prompttext() const { return _prompttext; }
@@ -374,6 +381,8 @@ namespace AWE {
     bool GameState_Battle_DamageCalculation::isAcknowledged() const { return _isAcknowledged; }
 
     const DamageCalculator* GameState_Battle_DamageCalculation::calc(const DamageCalculator& newval) { const DamageCalculator* oldval = _calc; _calc = &newval; return oldval; }
+    DamageCache* GameState_Battle_DamageCalculation::cache(DamageCache& newval) { DamageCache* oldval = _cache; _cache = &newval; return oldval; }
+    const BattlerInstancePool* GameState_Battle_DamageCalculation::instances(const BattlerInstancePool& newval) { const BattlerInstancePool* oldval = _instances; _instances = &newval; return oldval; }
     AWESprite* GameState_Battle_DamageCalculation::targetsprite(AWESprite& newval) { AWESprite* oldval = _targetsprite; _targetsprite = &newval; return oldval; }
     TextBox* GameState_Battle_DamageCalculation::damagetext(TextBox& newval) { TextBox* oldval = _damagetext; _damagetext = &newval; return oldval; }
     TextBox* GameState_Battle_DamageCalculation::prompttext(TextBox& newval) { TextBox* oldval = _prompttext; _prompttext = &newval; return oldval; }
@@ -398,12 +407,30 @@ namespace AWE {
             return true;
         }
 
-        if (!_calc || !_targetsprite || !_damagetext || !_decision) {
+        if (!_calc || !_instances || !_targetsprite || !_damagetext || !_decision) {
+            return false;
+        }
+
+        const BattlerInstance* source = _instances->Get(_decision->source());
+        const BattlerInstance* target = _instances->Get(_decision->target());
+        if (!source || !target) {
             return false;
         }
 
-        _result = std::make_unique<Damage>(_calc->CalculateDamage(_decision->skill(), _decision->source(), _decision->target()));
-        _damagetext->SetString(_result->ToString(_calc->lov()->damageTypes()));
+        // Damage keeps its components inline, so holding the result by value keeps it off the heap.
+        if (_cache) {
+            _result.emplace(_cache->CalculateDamage(_decision->skill(), *source, *target));
+        } else {
+            _result.emplace(_calc->CalculateDamage(_decision->skill(), *source, *target));
+        }
+
+        // The text buffer only grows, and its size only depends on the layout, so only the first calculation allocates it.
+        if (_damagetextbuffer.size() < _result->MaxFormattedSize()) {
+            _damagetextbuffer.resize(_result->MaxFormattedSize());
+        }
+        TextFormatter damagetext(_damagetextbuffer);
+        _result->Format(damagetext, _calc->lov()->damageTypes());
+        _damagetext->SetString(damagetext);
         _damagetext->SetPosition(_targetsprite->GetSkillPosition());
         _damagetext->isVisible(true);
         _isAcknowledged = false;
@@ -625,7 +652,7 @@ namespace AWE {
             _menu->GoToCharacter(static_cast<unsigned int>(_characterIndex));
         }
 
-        BattlerInstance_shptr character = _menu->GetCurrentCharacter();
+        const BattlerInstance* character = _menu->GetCurrentCharacter();
         if (!character) {
             return false;
         }
@@ -656,22 +683,28 @@ namespace AWE {
             }
 
             BattlerDecisionOrdering* decisions = _battle->decisions();
-            BattlerInstance_shptr source = _menu->GetCurrentCharacter();
+            BattlerInstanceHandle source = _menu->GetCurrentCharacterHandle();
+            const BattlerInstance* sourceInstance = _battle->instances()->Get(source);
+            const Skill* skill = _menu->GetCurrentSkill();
+            if (!sourceInstance || !skill) {
+                return false;
+            }
+
             BattlerDecisionOrdering::iterator orderitr;
             BattlerDecisionList::iterator decision;
             bool foundOrderitr, foundDecision;
 
-            FindBattlerDecision(*decisions, source, foundOrderitr, orderitr, foundDecision, decision);
+            FindBattlerDecision(*decisions, *_battle->instances(), source, foundOrderitr, orderitr, foundDecision, decision);
 
             if (!foundOrderitr) {
-                orderitr = decisions->insert(decisions->begin(), std::make_pair(source->priority(), BattlerDecisionList()));
+                orderitr = decisions->try_emplace(sourceInstance->priority()).first;
             }
 
             if (foundDecision) {
                 orderitr->second.erase(decision);
             }
 
-            orderitr->second.push_back(BattlerDecision(_menu->GetCurrentSkill(), std::move(source), _battle->enemy()));
+            orderitr->second.push_back(BattlerDecision(*skill, source, _battle->enemy()));
             _menu->ReleaseSelection();
 
             if (_selectSound && _selectSound->getBuffer()) {
@@ -707,7 +740,7 @@ namespace AWE {
         _menu->isVisible(false);
 
         if (_characterIndex >= 0 && _menu->GoToCharacter(_characterIndex)) {
-            RemoveBattlerDecision(*_battle->decisions(), _menu->GetCurrentCharacter());
+            RemoveBattlerDecision(*_battle->decisions(), *_battle->instances(), _menu->GetCurrentCharacterHandle());
         }
 
         _step = GameStateStep::BEGINNING;
@@ -1006,12 +1039,12 @@ namespace AWE {
     /* Load Characters */
 
     GameState_LevelUp_LoadCharacters::GameState_LevelUp_LoadCharacters() : GameState(), _xlo(nullptr) {}
-    GameState_LevelUp_LoadCharacters::GameState_LevelUp_LoadCharacters(GameXLOStorage& xlo) : GameState(), _xlo(&xlo) {}
+    GameState_LevelUp_LoadCharacters::GameState_LevelUp_LoadCharacters(const GameXLOStorage& xlo) : GameState(), _xlo(&xlo) {}
 
     const GameXLOStorage* GameState_LevelUp_LoadCharacters::xlo() const { return _xlo; }
-    const std::unordered_map<GameTextureType, Battler_shptr>& GameState_LevelUp_LoadCharacters::characters() const { return _characters; }
+    const std::unordered_map<GameTextureType, BattlerKey>& GameState_LevelUp_LoadCharacters::characters() const { return _characters; }
 
-    GameXLOStorage* GameState_LevelUp_LoadCharacters::xlo(GameXLOStorage& newval) { GameXLOStorage* oldval = _xlo; _xlo = &newval; return oldval; }
+    const GameXLOStorage* GameState_LevelUp_LoadCharacters::xlo(const GameXLOStorage& newval) { const GameXLOStorage* oldval = _xlo; _xlo = &newval; return oldval; }
 
     bool GameState_LevelUp_LoadCharacters::Begin() {
         if (_step != GameStateStep::BEGINNING) {
@@ -1033,9 +1066,9 @@ namespace AWE {
         for (const BattlerMap::value_type& battler : battlers) {
             if (battler.second->isCharacter()) {
                 if (battler.second->textureType() == static_cast<unsigned int>(GameTextureType::EPPLER)) {
-                    _characters.insert(std::make_pair(GameTextureType::LEVELUP_EPPLER, _xlo->GetBattler(battler.first)));
+                    _characters.insert(std::make_pair(GameTextureType::LEVELUP_EPPLER, battler.first));
                 } else if (battler.second->textureType() == static_cast<unsigned int>(GameTextureType::REMI)) {
-                    _characters.insert(std::make_pair(GameTextureType::LEVELUP_REMI, _xlo->GetBattler(battler.first)));
+                    _characters.insert(std::make_pair(GameTextureType::LEVELUP_REMI, battler.first));
                 }
             }
         }
@@ -1046,9 +1079,10 @@ namespace AWE {
 
     /* Select */
 
-    GameState_LevelUp_Select::GameState_LevelUp_Select() : GameState(), _menu(nullptr), _isSelectionConfirmed(false) {}
-    GameState_LevelUp_Select::GameState_LevelUp_Select(AWESprite& menu) : GameState(), _menu(&menu), _isSelectionConfirmed(false) {}
-    GameState_LevelUp_Select::GameState_LevelUp_Select(AWESprite& menu, const sf::SoundBuffer& cursor, const sf::SoundBuffer& select) : GameState(), _menu(&menu), _isSelectionConfirmed(false) {
+    GameState_LevelUp_Select::GameState_LevelUp_Select() : GameState(), _menu(nullptr), _progression(nullptr), _battler(SymbolTable::INVALID_ID), _isSelectionConfirmed(false) {}
+    GameState_LevelUp_Select::GameState_LevelUp_Select(AWESprite& menu) : GameState(), _menu(&menu), _progression(nullptr), _battler(SymbolTable::INVALID_ID), _isSelectionConfirmed(false) {}
+    GameState_LevelUp_Select::GameState_LevelUp_Select(AWESprite& menu, const sf::SoundBuffer& cursor, const sf::SoundBuffer& select)
+            : GameState(), _menu(&menu), _progression(nullptr), _battler(SymbolTable::INVALID_ID), _isSelectionConfirmed(false) {
         _cursorSound = std::make_unique<sf::Sound>(sf::Sound());
         _cursorSound->setBuffer(cursor);
         _selectSound = std::make_unique<sf::Sound>(sf::Sound());
@@ -1058,7 +1092,9 @@ namespace AWE {
     const unsigned int GameState_LevelUp_Select::MAX_MENU_INDEX = 2U;
 
     const AWESprite* GameState_LevelUp_Select::menu() const { return _menu; }
-    const Battler_shptr& GameState_LevelUp_Select::battler() const { return _battler; }
+    const BattlerProgression* GameState_LevelUp_Select::progression() const { return _progression; }
+    BattlerKey GameState_LevelUp_Select::battler() const { return _battler; }
+    const BattlerProgressionTransaction& GameState_LevelUp_Select::levelup() const { return _levelup; }
     bool GameState_LevelUp_Select::isSelectionConfirmed() const { return _isSelectionConfirmed; }
     const sf::Sound* GameState_LevelUp_Select::cursorSound() const { return _cursorSound.get(); }
     const sf::Sound* GameState_LevelUp_Select::selectSound() const { return _selectSound.get(); }
@@ -1066,7 +1102,8 @@ namespace AWE {
     AWESprite* GameState_LevelUp_Select::menu() { return _menu; }
 
     AWESprite* GameState_LevelUp_Select::menu(AWESprite& newval) { AWESprite* oldval = _menu; _menu = &newval; return oldval; }
-    Battler_shptr GameState_LevelUp_Select::battler(Battler_shptr newval) { Battler_shptr oldval = std::move(_battler); _battler = std::move(newval); return oldval; }
+    BattlerProgression* GameState_LevelUp_Select::progression(BattlerProgression& newval) { BattlerProgression* oldval = _progression; _progression = &newval; return oldval; }
+    BattlerKey GameState_LevelUp_Select::battler(BattlerKey newval) { BattlerKey oldval = _battler; _battler = newval; return oldval; }
     void GameState_LevelUp_Select::cursorSound(const sf::SoundBuffer& newbuffer) {
         if (!_cursorSound) {
             _cursorSound = std::make_unique<sf::Sound>(sf::Sound());
@@ -1111,10 +1148,13 @@ namespace AWE {
     }
 
     bool GameState_LevelUp_Select::ConfirmSelection() {
-        if (_step != GameStateStep::PROCESSING || _isSelectionConfirmed || !_menu || !_menu->isVisible()) {
+        const Battler* battler = GetBattler();
+        if (_step != GameStateStep::PROCESSING || _isSelectionConfirmed || !_menu || !_menu->isVisible() || !battler) {
             return false;
         }
 
+        _levelup = _progression->Begin();
+        ApplySelection(*battler);
         _isSelectionConfirmed = true;
         return true;
     }
@@ -1124,6 +1164,7 @@ namespace AWE {
             return false;
         }
 
+        _levelup.Abort();
         _isSelectionConfirmed = false;
         return true;
     }
@@ -1159,13 +1200,15 @@ namespace AWE {
         return true;
     }
 
+    const Battler* GameState_LevelUp_Select::GetBattler() const { return _progression ? _progression->content().xlo().battlers().Get(_battler).get() : nullptr; }
+
     bool GameState_LevelUp_Select::ExtractElement(SkillElementGroupKey groupkey, DamageTypeKey dtypekey, ElementalAffinityKey& output) {
-        if (!_battler) {
+        const Battler* battler = GetBattler();
+        if (!battler) {
             return false;
         }
 
-        ABRV weapon('W', 'E', 'P', 'N');
-        const Equipment_shptr& equipment = _battler->currentEquipment().GetEquipment(weapon.AsLong(), 1);
+        const Equipment_shptr& equipment = battler->currentEquipment().GetEquipment("WEPN"_abrv, 1);
 
         if (!equipment) {
             return false;
@@ -1180,87 +1223,97 @@ namespace AWE {
         return false;
     }
 
-    bool GameState_LevelUp_Select::End() {
-        if (_step != GameStateStep::ENDING) {
-            return true;
-        }
-
-        if (!_menu || !_menu->isVisible() || !_battler || !_isSelectionConfirmed) {
-            _step = GameStateStep::BEGINNING;
-            return false;
-        }
-
+    void GameState_LevelUp_Select::ApplySelection(const Battler& battler) {
         int hpIncrease = 150;
         ElementalAffinityKey affinkey;
-        ABRV piercing('P', 'I', 'E', 'R');
-        if (_battler->textureType() == static_cast<unsigned int>(GameTextureType::EPPLER)) {
-            ABRV strength('S', 'T', 'R', 'N');
-            ABRV finesse('F', 'I', 'N', 'S');
-            ABRV pyretic('F', 'I', 'R', 'E');
-            ABRV slashing('S', 'L', 'S', 'H');
-            ABRV swords('S', 'W', 'D', 'S');
+        constexpr DamageTypeKey piercing = "PIER"_abrv;
+        if (battler.textureType() == static_cast<unsigned int>(GameTextureType::EPPLER)) {
+            constexpr BattlerStatKey strength = "STRN"_abrv;
+            constexpr BattlerStatKey finesse = "FINS"_abrv;
+            constexpr DamageTypeKey pyretic = "FIRE"_abrv;
+            constexpr DamageTypeKey slashing = "SLSH"_abrv;
+            constexpr SkillElementGroupKey swords = "SWDS"_abrv;
 
             switch (_menu->textureIndex()) {
             case 0:
-                if (ExtractElement(swords.AsLong(), pyretic.AsLong(), affinkey)) {
-                    _battler->AdjustStat(BattlerStat::MXHP.AsLong(), hpIncrease);
-                    _battler->AdjustStat(finesse.AsLong(), 10);
-                    _battler->AdjustAffinity(affinkey, 20);
+                if (ExtractElement(swords, pyretic, affinkey)) {
+                    _levelup.AdjustStat(_battler, BattlerStat::MXHP.AsLong(), hpIncrease);
+                    _levelup.AdjustStat(_battler, finesse, 10);
+                    _levelup.AdjustAffinity(_battler, affinkey, 20);
                 }
                 break;
 
             case 1:
-                if (ExtractElement(swords.AsLong(), slashing.AsLong(), affinkey)) {
-                    _battler->AdjustStat(BattlerStat::MXHP.AsLong(), hpIncrease);
-                    _battler->AdjustStat(strength.AsLong(), 5);
-                    _battler->AdjustAffinity(affinkey, 10);
+                if (ExtractElement(swords, slashing, affinkey)) {
+                    _levelup.AdjustStat(_battler, BattlerStat::MXHP.AsLong(), hpIncrease);
+                    _levelup.AdjustStat(_battler, strength, 5);
+                    _levelup.AdjustAffinity(_battler, affinkey, 10);
                 }
                 break;
 
             case 2:
-                if (ExtractElement(swords.AsLong(), piercing.AsLong(), affinkey)) {
-                    _battler->AdjustStat(BattlerStat::MXHP.AsLong(), hpIncrease);
-                    _battler->AdjustStat(strength.AsLong(), 5);
-                    _battler->AdjustStat(finesse.AsLong(), 5);
-                    _battler->AdjustAffinity(affinkey, 5);
+                if (ExtractElement(swords, piercing, affinkey)) {
+                    _levelup.AdjustStat(_battler, BattlerStat::MXHP.AsLong(), hpIncrease);
+                    _levelup.AdjustStat(_battler, strength, 5);
+                    _levelup.AdjustStat(_battler, finesse, 5);
+                    _levelup.AdjustAffinity(_battler, affinkey, 5);
                 }
                 break;
             }
-        } else if (_battler->textureType() == static_cast<unsigned int>(GameTextureType::REMI)) {
-            ABRV mysticism('M', 'Y', 'S', 'T');
-            ABRV will('W', 'I', 'L', 'L');
-            ABRV aetheric('A', 'E', 'T', 'H');
-            ABRV arcane('A', 'R', 'C', 'N');
-            ABRV aestival('A', 'S', 'V', 'L');
-            ABRV wands('W', 'A', 'N', 'S');
+        } else if (battler.textureType() == static_cast<unsigned int>(GameTextureType::REMI)) {
+            constexpr BattlerStatKey mysticism = "MYST"_abrv;
+            constexpr BattlerStatKey will = "WILL"_abrv;
+            constexpr DamageTypeKey aetheric = "AETH"_abrv;
+            constexpr DamageTypeKey arcane = "ARCN"_abrv;
+            constexpr SkillElementGroupKey aestival = "ASVL"_abrv;
+            constexpr SkillElementGroupKey wands = "WANS"_abrv;
 
             switch (_menu->textureIndex()) {
             case 0:
-                if (ExtractElement(aestival.AsLong(), aetheric.AsLong(), affinkey)) {
-                    _battler->AdjustStat(BattlerStat::MXHP.AsLong(), hpIncrease);
-                    _battler->AdjustStat(will.AsLong(), 10);
-                    _battler->AdjustAffinity(affinkey, 20);
+                if (ExtractElement(aestival, aetheric, affinkey)) {
+                    _levelup.AdjustStat(_battler, BattlerStat::MXHP.AsLong(), hpIncrease);
+                    _levelup.AdjustStat(_battler, will, 10);
+                    _levelup.AdjustAffinity(_battler, affinkey, 20);
                 }
                 break;
 
             case 1:
-                if (ExtractElement(wands.AsLong(), arcane.AsLong(), affinkey)) {
-                    _battler->AdjustStat(BattlerStat::MXHP.AsLong(), hpIncrease);
-                    _battler->AdjustStat(mysticism.AsLong(), 10);
-                    _battler->AdjustAffinity(affinkey, 20);
+                if (ExtractElement(wands, arcane, affinkey)) {
+                    _levelup.AdjustStat(_battler, BattlerStat::MXHP.AsLong(), hpIncrease);
+                    _levelup.AdjustStat(_battler, mysticism, 10);
+                    _levelup.AdjustAffinity(_battler, affinkey, 20);
                 }
                 break;
 
             case 2:
-                if (ExtractElement(aestival.AsLong(), piercing.AsLong(), affinkey)) {
-                    _battler->AdjustStat(BattlerStat::MXHP.AsLong(), hpIncrease);
-                    _battler->AdjustStat(will.AsLong(), 7);
-                    _battler->AdjustStat(mysticism.AsLong(), 7);
-                    _battler->AdjustAffinity(affinkey, 10);
+                if (ExtractElement(aestival, piercing, affinkey)) {
+                    _levelup.AdjustStat(_battler, BattlerStat::MXHP.AsLong(), hpIncrease);
+                    _levelup.AdjustStat(_battler, will, 7);
+                    _levelup.AdjustStat(_battler, mysticism, 7);
+                    _levelup.AdjustAffinity(_battler, affinkey, 10);
                 }
                 break;
             }
         }
+    }
+
+    bool GameState_LevelUp_Select::End() {
+        if (_step != GameStateStep::ENDING) {
+            return true;
+        }
+
+        if (!_menu || !_menu->isVisible() || !_isSelectionConfirmed) {
+            _levelup.Abort();
+            _step = GameStateStep::BEGINNING;
+            return false;
+        }
+
+        // Fails only if the progression was changed since the selection was confirmed. The selection is released so it can be confirmed again on top of the change.
+        if (!_levelup.Commit()) {
+            _isSelectionConfirmed = false;
+            _step = GameStateStep::PROCESSING;
+            return false;
+        }
 
         _menu->isVisible(false);
         _isSelectionConfirmed = false;
@@ -1,4 +1,5 @@
 #pragma once
+#include <optional>
 #include <unordered_map>
 #include <vector>
 #include <SFML/Audio.hpp>
@@ -342,7 +343,7 @@ namespace AWE {
     class GameState_Battle_SkillName : public GameState {
     private:
         TextBox* _textbox;
-        Skill_shptr _skill;
+        const Skill* _skill;
         std::unique_ptr<sf::Clock> _timer;
 
     public:
@@ -358,11 +359,11 @@ namespace AWE {
         static const unsigned int DEFAULT_DISPLAY_MILLIS;
 
         const TextBox* textbox() const;
-        const Skill_shptr& skill() const;
+        const Skill* skill() const;
         const std::unique_ptr<sf::Clock>& timer() const;
 
         TextBox* textbox(TextBox&);
-        Skill_shptr skill(Skill_shptr);
+        const Skill* skill(const Skill&);
 
         /// <returns>State type.</returns>
         GameStateType stateType() const override { return GameStateType::BATTLE_SKILLNAME; }
@@ -393,7 +394,10 @@ namespace AWE {
     class GameState_Battle_DamageCalculation : public GameState {
     private:
         const DamageCalculator* _calc;
-        std::unique_ptr<Damage> _result;
+        DamageCache* _cache;
+        const BattlerInstancePool* _instances;
+        std::optional<Damage> _result;
+        std::vector<char> _damagetextbuffer;
         AWESprite* _targetsprite;
         TextBox* _damagetext;
         TextBox* _prompttext;
@@ -420,7 +424,11 @@ namespace AWE {
         static const std::string DEFAULT_PROMPT_MESSAGE;
 
         const DamageCalculator* calc() const;
-        const std::unique_ptr<Damage>& result() const;
+        /// <returns>const pointer to the damage cache used in front of the damage calculator, if any.</returns>
+        const DamageCache* cache() const;
+        /// <returns>const pointer to the pool which owns the decision's battlers.</returns>
+        const BattlerInstancePool* instances() const;
+        const std::optional<Damage>& result() const;
         const AWESprite* targetsprite() const;
         const TextBox* damagetext() const;
         const TextBox* prompttext() const;
@@ -430,6 +438,12 @@ namespace AWE {
         bool isAcknowledged() const;
 
         const DamageCalculator* calc(const DamageCalculator&);
+        /// <param name="">New damage cache. Should sit in front of the same calculator this state uses.</param>
+        /// <returns>Old damage cache.</returns>
+        DamageCache* cache(DamageCache&);
+        /// <param name="">New pool to resolve the decision's battlers from.</param>
+        /// <returns>Old pool.</returns>
+        const BattlerInstancePool* instances(const BattlerInstancePool&);
         AWESprite* targetsprite(AWESprite&);
         TextBox* damagetext(TextBox&);
         TextBox* prompttext(TextBox&);
@@ -778,8 +792,8 @@ namespace AWE {
     /// </summary>
     class GameState_LevelUp_LoadCharacters : public GameState {
     private:
-        GameXLOStorage* _xlo;
-        std::unordered_map<GameTextureType, Battler_shptr> _characters;
+        const GameXLOStorage* _xlo;
+        std::unordered_map<GameTextureType, BattlerKey> _characters;
 
         /// <summary>
         /// Used to get the characters from the XLO storage.
@@ -794,12 +808,12 @@ namespace AWE {
         /// Default constructor. Initializes current step to BEGINNING.
         /// </summary>
         GameState_LevelUp_LoadCharacters();
-        GameState_LevelUp_LoadCharacters(GameXLOStorage&);
+        GameState_LevelUp_LoadCharacters(const GameXLOStorage&);
 
         const GameXLOStorage* xlo() const;
-        const std::unordered_map<GameTextureType, Battler_shptr>& characters() const;
+        const std::unordered_map<GameTextureType, BattlerKey>& characters() const;
 
-        GameXLOStorage* xlo(GameXLOStorage&);
+        const GameXLOStorage* xlo(const GameXLOStorage&);
 
         /// <returns>State type.</returns>
         GameStateType stateType() const override { return GameStateType::LEVELUP_LOADCHARACTERS; }
@@ -820,7 +834,9 @@ namespace AWE {
     class GameState_LevelUp_Select : public GameState {
     private:
         AWESprite* _menu;
-        Battler_shptr _battler;
+        BattlerProgression* _progression;
+        BattlerKey _battler;
+        BattlerProgressionTransaction _levelup;
         bool _isSelectionConfirmed;
         std::unique_ptr<sf::Sound> _cursorSound;
         std::unique_ptr<sf::Sound> _selectSound;
@@ -831,6 +847,12 @@ namespace AWE {
         /// <param name="output">Output parameter. If successful, this will be set to the extracted elemental affinity.</param>
         /// <returns>true if successful, false otherwise.</returns>
         bool ExtractElement(SkillElementGroupKey, DamageTypeKey, ElementalAffinityKey& output);
+        /// <returns>const pointer to the current battler, as it was loaded, or nullptr if there is no progression or no such battler.</returns>
+        const Battler* GetBattler() const;
+        /// <summary>
+        /// Applies the upgrade the cursor is over to the given battler, within the level-up transaction.
+        /// </summary>
+        void ApplySelection(const Battler&);
 
     public:
         /// <summary>
@@ -843,7 +865,10 @@ namespace AWE {
         static const unsigned int MAX_MENU_INDEX;
 
         const AWESprite* menu() const;
-        const Battler_shptr& battler() const;
+        const BattlerProgression* progression() const;
+        BattlerKey battler() const;
+        /// <returns>const reference to the level-up transaction. It is open, with the selected upgrade applied, from the time the selection is confirmed until it is committed or released.</returns>
+        const BattlerProgressionTransaction& levelup() const;
         bool isSelectionConfirmed() const;
         const sf::Sound* cursorSound() const;
         const sf::Sound* selectSound() const;
@@ -851,7 +876,9 @@ namespace AWE {
         AWESprite* menu();
 
         AWESprite* menu(AWESprite&);
-        Battler_shptr battler(Battler_shptr);
+        /// <param name="">Progression the level-ups are recorded in.</param>
+        BattlerProgression* progression(BattlerProgression&);
+        BattlerKey battler(BattlerKey);
         void cursorSound(const sf::SoundBuffer&);
         void selectSound(const sf::SoundBuffer&);
 
@@ -869,12 +896,13 @@ namespace AWE {
         /// <returns>true if successful, false otherwise. If false is returned, the cursor may already be over the top element.</returns>
         bool DecrementMenu();
         /// <summary>
-        /// Locks the cursor to its current position and confirms the upgrade its over as the selection.
+        /// Locks the cursor to its current position and confirms the upgrade its over as the selection. The upgrade is applied in a new level-up transaction,
+        /// which is committed when the state ends.
         /// </summary>
         /// <returns>true if successful, false otherwise.</returns>
         bool ConfirmSelection();
         /// <summary>
-        /// Releases the selection allowing the cursor to move again.
+        /// Releases the selection allowing the cursor to move again. The level-up transaction is aborted, so the upgrade is undone.
         /// </summary>
         /// <returns>true if successful, false otherwise.</returns>
         bool ReleaseSelection();
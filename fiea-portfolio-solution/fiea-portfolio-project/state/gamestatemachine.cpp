@@ -2,19 +2,19 @@
 #include "battlerdecision.h"
 
 namespace AWE {
-    GameStateMachine::GameStateMachine(GameXLOStorage& xlo, GameSceneTransitioner& scenes, GameBattleInfo& battle)
+    GameStateMachine::GameStateMachine(BattlerProgression& progression, GameSceneTransitioner& scenes, GameBattleInfo& battle)
             : GameState()
-            , _xlo(&xlo)
-            , _scenes(&scenes)
+            , _index(0)
             , _battle(&battle)
+            , _sfmls(nullptr)
+            , _scenes(&scenes)
+            , _progression(&progression)
             , _isSceneInitialized(false)
             , _isBattleInitialized(false)
             , _isBattleConfigured(false)
             , _isBattleLostConfigured(false)
             , _isLevelupInitialized(false)
-            , _isLevelupConfigured(false)
-            , _sfmls(nullptr)
-            , _index(0) {
+            , _isLevelupConfigured(false) {
         _map.insert(std::make_pair(GameStateType::SCENE_FADEIN, std::make_unique<GameState_Scene_FadeIn>(GameState_Scene_FadeIn())));
         _map.insert(std::make_pair(GameStateType::SCENE_FADEOUT, std::make_unique<GameState_Scene_FadeOut>(GameState_Scene_FadeOut())));
         _map.insert(std::make_pair(GameStateType::SCENE_MUSIC, std::make_unique<GameState_Scene_Music>(GameState_Scene_Music())));
@@ -39,7 +39,8 @@ namespace AWE {
         _map.insert(std::make_pair(GameStateType::STOP, std::make_unique<GameState>(GameState())));
     }
 
-    GameStateMachine::GameStateMachine(GameXLOStorage& xlo, GameSceneTransitioner& scenes, GameBattleInfo& battle, GameSFMLStorage& sfmls, sf::Sound& skillSound) : GameStateMachine(xlo, scenes, battle) {
+    GameStateMachine::GameStateMachine(BattlerProgression& progression, GameSceneTransitioner& scenes, GameBattleInfo& battle, GameSFMLStorage& sfmls, sf::Sound& skillSound)
+            : GameStateMachine(progression, scenes, battle) {
         InitializeScene(sfmls);
         InitializeBattle(sfmls, skillSound);
         InitializeLevelup(sfmls);
@@ -136,7 +137,7 @@ namespace AWE {
         auto playerSkillState = GetState<GameState_Battle_PlayerSkillSelect>(GameStateType::BATTLE_PLAYERSKILLSELECT);
         playerSkillState->characterIndex(0);
         playerSkillState->battle(*_battle);
-        _sfmls->battleMenu()->characters(_battle->characters());
+        _sfmls->battleMenu()->characters(_battle->characters(), *_battle->instances());
         playerSkillState->menu(*_sfmls->battleMenu());
         playerSkillState->selectSound(*_sfmls->GetSound(GameSoundType::SAVE));
 
@@ -149,6 +150,8 @@ namespace AWE {
 
         auto damageState = GetState<GameState_Battle_DamageCalculation>(GameStateType::BATTLE_DAMAGECALCULATION);
         damageState->calc(_battle->damagecalc());
+        damageState->cache(*_battle->damagecache());
+        damageState->instances(*_battle->instances());
         damageState->damagetext(_sfmls->textboxes()->at(GameTextboxType::DAMAGE));
         damageState->skilltext(_sfmls->textboxes()->at(GameTextboxType::SKILL));
         damageState->prompttext(_sfmls->textboxes()->at(GameTextboxType::GENERIC));
@@ -229,9 +232,10 @@ namespace AWE {
         }
 
         auto charloadState = GetState<GameState_LevelUp_LoadCharacters>(GameStateType::LEVELUP_LOADCHARACTERS);
-        charloadState->xlo(*_xlo);
+        charloadState->xlo(_progression->content().xlo());
 
         auto selectState = GetState<GameState_LevelUp_Select>(GameStateType::LEVELUP_SELECT);
+        selectState->progression(*_progression);
         selectState->cursorSound(*_sfmls->GetSound(GameSoundType::CURSOR));
         selectState->selectSound(*_sfmls->GetSound(GameSoundType::SAVE));
 
@@ -358,9 +362,9 @@ namespace AWE {
 
         case GameTextureType::FIRETOWN:
             _parent->ResetSteps();
-            _parent->_battle->GoToNextEnemy(_parent->_xlo->battlers());
-            _parent->_sfmls->GetSprite(GameTextureType::ENEMY)->textureIndex(_parent->_battle->enemy()->textureIndex());
-            _parent->_battle->RefreshCharacters(*_parent->_xlo);
+            _parent->_battle->GoToNextEnemy();
+            _parent->_sfmls->GetSprite(GameTextureType::ENEMY)->textureIndex(_parent->_battle->instances()->Get(_parent->_battle->enemy())->textureIndex());
+            _parent->_battle->RefreshCharacters();
             _parent->GetState<GameState_Battle_Monologue>(GameStateType::BATTLE_MONOLOGUE)->thomas(true);
             result = _parent->ConfigureForBattle();
             break;
@@ -406,14 +410,14 @@ namespace AWE {
             return false;
         }
 
-        int newindex = playerSkillState->characterIndex() + 1;
+        std::size_t newindex = static_cast<std::size_t>(playerSkillState->characterIndex()) + 1;
 
         if (newindex >= _parent->_battle->characters().size()) {
             _step = GameStateStep::DONE;
             return true;
         }
 
-        playerSkillState->characterIndex(newindex);
+        playerSkillState->characterIndex(static_cast<int>(newindex));
 
         if (current->stateType() == stateType()) {
             ConductReset();
@@ -477,11 +481,16 @@ namespace AWE {
         }
 
         const BattlerDecision& decision = *decisitr->second.begin();
-        AWESprite& targetsprite = _parent->_sfmls->sprites()->at(decision.target()->textureType());
+        const BattlerInstance* target = _parent->_battle->instances()->Get(decision.target());
+        if (!target) {
+            return false;
+        }
+
+        AWESprite& targetsprite = _parent->_sfmls->sprites()->at(target->textureType());
 
         skillNameState->skill(decision.skill());
-        skillAnimState->skillsprite()->textureIndex(decision.skill()->textureIndex());
-        skillAnimState->sound()->setBuffer(_parent->_sfmls->sounds().at(decision.skill()->soundFilename()));
+        skillAnimState->skillsprite()->textureIndex(decision.skill().textureIndex());
+        skillAnimState->sound()->setBuffer(_parent->_sfmls->sounds().at(decision.skill().soundFilename()));
         skillAnimState->targetsprite(targetsprite);
         calcState->decision(decision);
         calcState->targetsprite(targetsprite);
@@ -524,16 +533,17 @@ namespace AWE {
             return false;
         }
 
-        auto removed = RemoveBattlerDecision(*_parent->_battle->decisions(), calcState->decision()->source());
-        if (removed) {
-            BattlerInstance_shptr target = removed->target();
+        BattlerInstancePool* instances = _parent->_battle->instances();
+        auto removed = RemoveBattlerDecision(*_parent->_battle->decisions(), *instances, calcState->decision()->source());
+        BattlerInstance* target = removed ? instances->Get(removed->target()) : nullptr;
+        if (target) {
             auto hp = target->hp();
             auto result = calcState->result()->final();
             bool defeat = result >= hp;
             target->hp(defeat ? 0 : (hp - result));
 
             if (defeat) {
-                RemoveBattlerDecision(*_parent->_battle->decisions(), target);
+                RemoveBattlerDecision(*_parent->_battle->decisions(), *instances, removed->target());
 
                 if (target->isCharacter()) {
                     _parent->_sfmls->sprites()->at(target->textureType()).textureIndex(1);
@@ -605,16 +615,19 @@ namespace AWE {
             return false;
         }
 
-        if (_parent->_battle->enemy()->hp() <= 0) {
+        const BattlerInstancePool& instances = *_parent->_battle->instances();
+        const BattlerInstance* enemy = instances.Get(_parent->_battle->enemy());
+        if (!enemy || enemy->hp() <= 0) {
             _battleresult = true;
             _step = GameStateStep::ENDING;
             return true;
         }
 
         _battleresult = false;
-        const std::vector<BattlerInstance_shptr>& characters = _parent->_battle->characters();
-        for (const BattlerInstance_shptr& character : characters) {
-            _battleresult |= character->hp() > 0;
+        const std::vector<BattlerInstanceHandle>& characters = _parent->_battle->characters();
+        for (BattlerInstanceHandle handle : characters) {
+            const BattlerInstance* character = instances.Get(handle);
+            _battleresult |= character && character->hp() > 0;
             if (_battleresult) {
                 break;
             }
@@ -3,8 +3,8 @@
 #include <vector>
 #include "gamebattleinfo.h"
 #include "gamestate.h"
+#include "battlerprogression.h"
 #include "../store/gamesfmlstorage.h"
-#include "../store/gamexlostorage.h"
 
 namespace AWE {
     typedef std::unordered_map<GameStateType, std::unique_ptr<GameState>> GameStateMap;
@@ -29,7 +29,7 @@ namespace AWE {
         GameBattleInfo* _battle;
         GameSFMLStorage* _sfmls;
         GameSceneTransitioner* _scenes;
-        GameXLOStorage* _xlo;
+        BattlerProgression* _progression;
 
         bool _isSceneInitialized;
         bool _isBattleInitialized;
@@ -58,11 +58,11 @@ namespace AWE {
         /// <summary>
         /// Constructor. Creates all states, but does not initialize any of them.
         /// </summary>
-        GameStateMachine(GameXLOStorage&, GameSceneTransitioner&, GameBattleInfo&);
+        GameStateMachine(BattlerProgression&, GameSceneTransitioner&, GameBattleInfo&);
         /// <summary>
         /// Constructor. Creates all states, then initializes all scene-related, battle-related, and level-up-related states.
         /// </summary>
-        GameStateMachine(GameXLOStorage&, GameSceneTransitioner&, GameBattleInfo&, GameSFMLStorage&, sf::Sound&);
+        GameStateMachine(BattlerProgression&, GameSceneTransitioner&, GameBattleInfo&, GameSFMLStorage&, sf::Sound&);
 
         /// <returns>State type.</returns>
         GameStateType stateType() const override { return GameStateType::MACHINE; }
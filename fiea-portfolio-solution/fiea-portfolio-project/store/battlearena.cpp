@@ -0,0 +1,27 @@
+#include "battlearena.h"
+#include <algorithm>
+
+namespace AWE {
+    BattleArena::BattleArena(std::size_t initialSize)
+        : _initialSize((initialSize > 0) ? initialSize : DEFAULT_INITIAL_SIZE), _buffer(_initialSize), _bytesUsed(0), _highWaterMark(0) {}
+
+    std::size_t BattleArena::initialSize() const { return _initialSize; }
+    std::size_t BattleArena::bytesUsed() const { return _bytesUsed; }
+    std::size_t BattleArena::highWaterMark() const { return _highWaterMark; }
+
+    void* BattleArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+        void* p = _buffer.allocate(bytes, alignment);
+        _bytesUsed += bytes;
+        _highWaterMark = std::max(_highWaterMark, _bytesUsed);
+        return p;
+    }
+
+    void BattleArena::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) { _buffer.deallocate(p, bytes, alignment); }
+
+    bool BattleArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept { return this == &other; }
+
+    void BattleArena::Release() {
+        _buffer.release();
+        _bytesUsed = 0;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+
+namespace AWE {
+    /// <summary>
+    /// Monotonic memory resource for everything which lives exactly as long as one battle. Allocations are bumped out of large blocks and never freed one at a time;
+    /// instead, Release gives back every block at once when the battle ends. Give it to pmr containers, e.g. std::pmr::vector, to have them allocate from it.
+    /// Counts the bytes requested between releases, and remembers the highest count, so the arena can be sized up front to hold a whole battle in one block.
+    /// </summary>
+    class BattleArena : public std::pmr::memory_resource {
+    private:
+        std::size_t _initialSize;
+        std::pmr::monotonic_buffer_resource _buffer;
+        std::size_t _bytesUsed;
+        std::size_t _highWaterMark;
+
+    protected:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    public:
+        /// <summary>
+        /// Size of the first block when none is given. Later blocks grow geometrically.
+        /// </summary>
+        static const std::size_t DEFAULT_INITIAL_SIZE = 1024;
+
+        /// <summary>
+        /// Constructor.
+        /// </summary>
+        /// <param name="initialSize">Size of the first block, which is only allocated once the arena is first used. If 0, DEFAULT_INITIAL_SIZE is used.</param>
+        BattleArena(std::size_t initialSize = 0);
+        BattleArena(const BattleArena&) = delete;
+        BattleArena& operator=(const BattleArena&) = delete;
+
+        /// <returns>Size of the first block.</returns>
+        std::size_t initialSize() const;
+        /// <returns>Bytes requested from the arena since the last release. Deallocating does not lower this.</returns>
+        std::size_t bytesUsed() const;
+        /// <returns>Highest number of bytes requested between two releases. A good initial size for the next run.</returns>
+        std::size_t highWaterMark() const;
+
+        /// <summary>
+        /// Frees every block at once. Anything still allocated from the arena must already be destroyed, or at least never touched again.
+        /// </summary>
+        void Release();
+    };
+}
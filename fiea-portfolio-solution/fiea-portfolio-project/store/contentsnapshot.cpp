@@ -0,0 +1,35 @@
+#include "contentsnapshot.h"
+#include <algorithm>
+
+namespace AWE {
+    ContentSnapshot::ContentSnapshot(std::unique_ptr<GameLOVStorage> lov, std::unique_ptr<GameXLOStorage> xlo) : _lov(std::move(lov)), _xlo(std::move(xlo)) {
+        const BattlerMap& battlers = _xlo->battlers();
+        _battlers.reserve(battlers.size());
+        // The battler map is sorted by key, so the entries are too.
+        for (const BattlerMap::value_type& battler : battlers) {
+            _battlers.push_back(BattlerEntry {
+                battler.first,
+                battler.second.get(),
+                battler.second->BuildSnapshot(&_xlo->inclinationAttackingStats(), &_xlo->inclinationDefendingStats())
+            });
+        }
+    }
+
+    const GameLOVStorage& ContentSnapshot::lov() const { return *_lov; }
+    const GameXLOStorage& ContentSnapshot::xlo() const { return *_xlo; }
+    const std::vector<ContentSnapshot::BattlerEntry>& ContentSnapshot::battlers() const { return _battlers; }
+
+    const ContentSnapshot::BattlerEntry* ContentSnapshot::FindBattler(BattlerKey key) const {
+        auto found = std::lower_bound(_battlers.begin(), _battlers.end(), key, [](const BattlerEntry& entry, BattlerKey k) { return entry.key < k; });
+        return (found != _battlers.end() && found->key == key) ? &*found : nullptr;
+    }
+
+    std::optional<BattlerInstance> ContentSnapshot::Spawn(BattlerKey key, BattlerStatValue hp) const {
+        const BattlerEntry* entry = FindBattler(key);
+        if (!entry) {
+            return std::nullopt;
+        }
+
+        return BattlerInstance(*entry->battler, entry->snapshot, hp);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <memory>
+#include <optional>
+#include <vector>
+#include "gamelovstorage.h"
+#include "gamexlostorage.h"
+
+namespace AWE {
+    /// <summary>
+    /// Loaded content, frozen. Owns a loaded GameLOVStorage and GameXLOStorage and only hands out const access to them, so nothing in a snapshot changes after it is built,
+    /// and any number of threads can read the same snapshot without locks or copies. Progress made while playing belongs in a BattlerProgression layered on top of it.
+    /// Battlers are held const and keep no snapshot of their own, so every battler's snapshot is built here up front. Battler instances can only be spawned from a snapshot,
+    /// so spawn them through the content snapshot or a progression.
+    /// </summary>
+    class ContentSnapshot {
+    public:
+        /// <summary>
+        /// A battler and the snapshot its instances are spawned from.
+        /// </summary>
+        struct BattlerEntry {
+            BattlerKey key;
+            const Battler* battler;
+            /// <summary>
+            /// Never changed. Battler instances sharing it copy it before changing anything, since the entry always holds a reference of its own.
+            /// </summary>
+            std::shared_ptr<BattlerSnapshot> snapshot;
+        };
+
+    private:
+        std::unique_ptr<const GameLOVStorage> _lov;
+        std::unique_ptr<const GameXLOStorage> _xlo;
+        std::vector<BattlerEntry> _battlers;
+
+    public:
+        /// <summary>
+        /// Constructor. Takes ownership of the given storages, which should already be initialized, and builds every battler's snapshot.
+        /// </summary>
+        ContentSnapshot(std::unique_ptr<GameLOVStorage>, std::unique_ptr<GameXLOStorage>);
+        ContentSnapshot(const ContentSnapshot&) = delete;
+        ContentSnapshot& operator=(const ContentSnapshot&) = delete;
+
+        /// <returns>const reference to the frozen LOV storage.</returns>
+        const GameLOVStorage& lov() const;
+        /// <returns>const reference to the frozen XLO storage.</returns>
+        const GameXLOStorage& xlo() const;
+        /// <returns>const reference to every battler's entry, sorted by key. The array is built once, so pointers into it are good for as long as the snapshot is.</returns>
+        const std::vector<BattlerEntry>& battlers() const;
+
+        /// <returns>const pointer to the entry of the given battler, or nullptr if there is no such battler.</returns>
+        const BattlerEntry* FindBattler(BattlerKey) const;
+        /// <summary>
+        /// Creates a new battler instance of the given battler, as it was loaded. Safe to call from any thread.
+        /// </summary>
+        /// <param name="hp">If 0, the battler instance will be created using the `MXHP` stat of the battler. Otherwise, the battler instance will have the given HP value.</param>
+        /// <returns>The new battler instance, or nothing if there is no such battler.</returns>
+        std::optional<BattlerInstance> Spawn(BattlerKey, BattlerStatValue hp = 0) const;
+    };
+}
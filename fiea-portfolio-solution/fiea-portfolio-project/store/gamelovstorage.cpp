@@ -1,8 +1,22 @@
 #include "gamelovstorage.h"
 #include <iostream>
+#include "../misc/contentpack.h"
 #include "../misc/loaddata.h"
 
 namespace AWE {
+    namespace GAMELOVSTORAGE_PRIVATE {
+        /// <summary>
+        /// Puts every entry of the given pack section into the given map.
+        /// </summary>
+        template <typename T>
+        void LoadEntries(std::unordered_map<ABRV_long, std::shared_ptr<T>>& output, const ContentPack& pack, std::span<const ContentPackLOVEntry> entries) {
+            output.clear();
+            for (const ContentPackLOVEntry& entry : entries) {
+                output.insert(std::make_pair(entry.key, std::make_shared<T>(T(std::string(pack.GetString(entry.name)), ABRV(entry.key)))));
+            }
+        }
+    }
+
     const std::string GameLOVStorage::DEFAULT_LOAD_RES_LOC = "../res";
 
     bool GameLOVStorage::isInitialized() const { return _isInitialized; }
@@ -91,6 +105,39 @@ namespace AWE {
     const EquipmentTypeMap& GameLOVStorage::equipmentTypes() const { return _equipmentTypes; }
     const SkillElementMap& GameLOVStorage::skillElements() const { return _skillElements; }
     const SkillElementGroupMap& GameLOVStorage::skillElementGroups() const { return _skillElementGroups; }
+    const LOVIndexTable<BattlerStat>& GameLOVStorage::battlerStatIndices() const { return _battlerStatIndices; }
+    const LOVIndexTable<DamageInclination>& GameLOVStorage::damageInclinationIndices() const { return _damageInclinationIndices; }
+    const LOVIndexTable<DamageType>& GameLOVStorage::damageTypeIndices() const { return _damageTypeIndices; }
+    const LOVIndexTable<EquipmentType>& GameLOVStorage::equipmentTypeIndices() const { return _equipmentTypeIndices; }
+    const LOVIndexTable<SkillElement>& GameLOVStorage::skillElementIndices() const { return _skillElementIndices; }
+    const LOVIndexTable<SkillElementGroup>& GameLOVStorage::skillElementGroupIndices() const { return _skillElementGroupIndices; }
+
+    bool GameLOVStorage::AssignIndices() {
+        // Every battler keeps its stats in a BattlerStatBlock, which only has room for so many.
+        if (_battlerStats.size() > BattlerStatBlock::CAPACITY) {
+            return false;
+        }
+
+        bool isAssigned = _battlerStatIndices.Assign(_battlerStats)
+            && _damageInclinationIndices.Assign(_damageInclinations)
+            && _damageTypeIndices.Assign(_damageTypes)
+            && _equipmentTypeIndices.Assign(_equipmentTypes)
+            && _skillElementIndices.Assign(_skillElements)
+            && _skillElementGroupIndices.Assign(_skillElementGroups);
+
+        if (!isAssigned) {
+            return false;
+        }
+
+        // Every group keeps its elements as a SkillElementMask, which only has room for so many.
+        for (const SkillElementGroupMap::value_type& elegroup : _skillElementGroups) {
+            if (!elegroup.second->AssignMask(_skillElementIndices)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
 
     bool GameLOVStorage::Initialize(const std::string& resloc) {
         _isInitialized = false;
@@ -133,6 +180,83 @@ namespace AWE {
 
         std::cout << "Skill element groups loaded: " << _skillElementGroups.size() << "\n";
 
+        // The lists are closed from here on, so every entry can be given its dense index once.
+        if (!AssignIndices()) {
+            std::cout << "Too many list entries to index.\n";
+            return false;
+        }
+
+        _isInitialized = true;
+        return true;
+    }
+
+    bool GameLOVStorage::Initialize(const ContentPack& pack) {
+        _isInitialized = false;
+
+        if (!pack.isAttached()) {
+            return false;
+        }
+
+        GAMELOVSTORAGE_PRIVATE::LoadEntries(_battlerStats, pack, pack.battlerStats());
+        GAMELOVSTORAGE_PRIVATE::LoadEntries(_damageInclinations, pack, pack.damageInclinations());
+        GAMELOVSTORAGE_PRIVATE::LoadEntries(_damageTypes, pack, pack.damageTypes());
+        GAMELOVSTORAGE_PRIVATE::LoadEntries(_equipmentTypes, pack, pack.equipmentTypes());
+        GAMELOVSTORAGE_PRIVATE::LoadEntries(_skillElements, pack, pack.skillElements());
+
+        // Groups refer to each other by index, so they are all created before any is given its members.
+        std::span<const ContentPackLOVEntry> elements = pack.skillElements();
+        std::span<const ContentPackElementGroup> groups = pack.skillElementGroups();
+        SkillElementGroupList created;
+        _skillElementGroups.clear();
+        for (const ContentPackElementGroup& group : groups) {
+            created.push_back(std::make_shared<SkillElementGroup>(std::string(pack.GetString(group.name)), ABRV(group.key)));
+            _skillElementGroups.insert(std::make_pair(group.key, created.back()));
+        }
+
+        for (std::size_t i = 0; i < groups.size(); i++) {
+            if (groups[i].isGroups) {
+                SkillElementGroupList members;
+                for (ContentPackIndex member : ContentPack::GetRange(pack.indices(), groups[i].members)) {
+                    members.push_back(created[member]);
+                }
+                // Fails if a member group has not been given its own members yet. Retried below.
+                created[i]->Initialize(std::move(members));
+            } else {
+                SkillElementList members;
+                for (ContentPackIndex member : ContentPack::GetRange(pack.indices(), groups[i].members)) {
+                    members.push_back(_skillElements.at(elements[member].key));
+                }
+                created[i]->Initialize(std::move(members));
+            }
+        }
+
+        // Groups of groups can nest, so keep going until every group is valid. A pass without progress means the groups refer to each other in a cycle.
+        bool isProgressing = true;
+        while (isProgressing) {
+            isProgressing = false;
+            for (const SkillElementGroup_shptr& group : created) {
+                if (!group->IsValid() && group->Initialize()) {
+                    isProgressing = true;
+                }
+            }
+        }
+
+        for (const SkillElementGroup_shptr& group : created) {
+            if (!group->IsValid()) {
+                std::cout << "Skill element group " << group->abrvstr() << " could not be initialized from the content pack.\n";
+                return false;
+            }
+        }
+
+        std::cout << "Content pack lists loaded: " << _battlerStats.size() << " battler stats, " << _damageInclinations.size() << " damage inclinations, "
+            << _damageTypes.size() << " damage types, " << _equipmentTypes.size() << " equipment types, " << _skillElements.size() << " skill elements, "
+            << _skillElementGroups.size() << " skill element groups.\n";
+
+        if (!AssignIndices()) {
+            std::cout << "Too many list entries to index.\n";
+            return false;
+        }
+
         _isInitialized = true;
         return true;
     }
@@ -1,4 +1,5 @@
 #pragma once
+#include "lovindextable.h"
 #include "../models/battlerstat.h"
 #include "../models/damageinclination.h"
 #include "../models/damagetype.h"
@@ -7,6 +8,9 @@
 #include "../models/skillelementgroup.h"
 
 namespace AWE {
+    // Forward declaration, defined in misc/contentpack.h.
+    class ContentPack;
+
     /// <summary>
     /// LOV = List Of Values. This object stores all "list entry" objects loaded from the `.txt` files in the `res` folder. These objects all happen to be subclasses of AbbreviatedKey.
     /// </summary>
@@ -21,8 +25,22 @@ namespace AWE {
         SkillElementMap _skillElements;
         SkillElementGroupMap _skillElementGroups;
 
+        LOVIndexTable<BattlerStat> _battlerStatIndices;
+        LOVIndexTable<DamageInclination> _damageInclinationIndices;
+        LOVIndexTable<DamageType> _damageTypeIndices;
+        LOVIndexTable<EquipmentType> _equipmentTypeIndices;
+        LOVIndexTable<SkillElement> _skillElementIndices;
+        LOVIndexTable<SkillElementGroup> _skillElementGroupIndices;
+
         bool _isInitialized;
 
+        /// <summary>
+        /// Assigns every loaded entry its dense index.
+        /// Also assigns every skill element group its SkillElementMask.
+        /// </summary>
+        /// <returns>False if any list is too long to index, if there are more battler stats than a BattlerStatBlock can hold, or if any group's mask cannot be assigned.</returns>
+        bool AssignIndices();
+
     public:
         /// <returns>const reference to the loaded battler stats.</returns>
         const BattlerStatMap& battlerStats() const;
@@ -36,6 +54,18 @@ namespace AWE {
         const SkillElementMap& skillElements() const;
         /// <returns>const reference to the loaded skill element groups.</returns>
         const SkillElementGroupMap& skillElementGroups() const;
+        /// <returns>const reference to the dense indices of the loaded battler stats.</returns>
+        const LOVIndexTable<BattlerStat>& battlerStatIndices() const;
+        /// <returns>const reference to the dense indices of the loaded damage inclinations.</returns>
+        const LOVIndexTable<DamageInclination>& damageInclinationIndices() const;
+        /// <returns>const reference to the dense indices of the loaded damage types.</returns>
+        const LOVIndexTable<DamageType>& damageTypeIndices() const;
+        /// <returns>const reference to the dense indices of the loaded equipment types.</returns>
+        const LOVIndexTable<EquipmentType>& equipmentTypeIndices() const;
+        /// <returns>const reference to the dense indices of the loaded skill elements.</returns>
+        const LOVIndexTable<SkillElement>& skillElementIndices() const;
+        /// <returns>const reference to the dense indices of the loaded skill element groups.</returns>
+        const LOVIndexTable<SkillElementGroup>& skillElementGroupIndices() const;
         /// <returns>Is this object initialized? If false, the Initialize function may need to be invoked.</returns>
         bool isInitialized() const;
 
@@ -45,6 +75,12 @@ namespace AWE {
         /// <param name="resloc">Location of the text files to load data from.</param>
         /// <returns>Whether the load was successful.</returns>
         bool Initialize(const std::string& resloc = DEFAULT_LOAD_RES_LOC);
+        /// <summary>
+        /// Initializes the load from a compiled content pack instead of the text files. Running this function after this object is initialized will simply re-run the load.
+        /// </summary>
+        /// <param name="pack">Attached content pack. Nothing in this object refers back to it, so it may be detached once this returns.</param>
+        /// <returns>Whether the load was successful.</returns>
+        bool Initialize(const ContentPack& pack);
 
         /// <returns>Copy of the shared pointer to the battler stat with the given key. Returns an empty pointer if the key has no match.</returns>
         BattlerStat_shptr GetBattlerStat(BattlerStatKey) const;
@@ -1,15 +1,19 @@
 #include "gamexlostorage.h"
 #include <iostream>
 #include <memory>
+#include "../misc/contentpack.h"
 #include "../misc/xmlload.h"
 
 namespace AWE {
     const char* GameXLOStorage::DEFAULT_XMLFILENAME = "res/data.xml";
 
     const EquipmentTypeCountMap& GameXLOStorage::defaultEquipmentSlotSchema() const { return _defaultEquipmentSlotSchema; }
+    const SymbolTable& GameXLOStorage::symbols() const { return _symbols; }
     const SkillMap& GameXLOStorage::skills() const { return _skills; }
     const EquipmentMap& GameXLOStorage::equipment() const { return _equipment; }
     const BattlerMap& GameXLOStorage::battlers() const { return _battlers; }
+    const DamageInclinationStatListMap& GameXLOStorage::inclinationAttackingStats() const { return _inclinationAttackingStats; }
+    const DamageInclinationStatListMap& GameXLOStorage::inclinationDefendingStats() const { return _inclinationDefendingStats; }
     bool GameXLOStorage::isInitialized() const { return _isInitialized; }
 
     BattlerStatList GameXLOStorage::CopyAttackingStats(DamageInclinationKey incl) const {
@@ -34,39 +38,13 @@ namespace AWE {
         return output;
     }
 
-    Battler_shptr GameXLOStorage::GetBattler(const BattlerKey& key) {
-        Battler_shptr battler;
-
-        if (_isInitialized) {
-            auto found = _battlers.find(key);
-            if (found != _battlers.end()) {
-                battler = found->second;
-            }
-        }
-
-        return battler;
-    }
-
-    BattlerStatValue GameXLOStorage::AdjustBattlerStat(const BattlerKey& bkey, const BattlerStatKey& skey, int delta) {
-        auto found = _battlers.find(bkey);
-        if (found == _battlers.end()) {
-            return 0;
-        }
-        return found->second->AdjustStat(skey, delta);
-    }
-
-    ElementalAffinityValue GameXLOStorage::AdjustBattlerAffinity(const BattlerKey& bkey, const ElementalAffinityKey& ekey, int delta) {
-        auto found = _battlers.find(bkey);
-        if (found == _battlers.end()) {
-            return 0;
-        }
-        return found->second->AdjustAffinity(ekey, delta);
-    }
+    std::shared_ptr<const Battler> GameXLOStorage::GetBattler(BattlerKey key) const { return _isInitialized ? _battlers.Get(key) : std::shared_ptr<const Battler>(); }
+    std::shared_ptr<const Battler> GameXLOStorage::GetBattler(const std::string& name) const { return GetBattler(_symbols.Find(name)); }
 
     bool GameXLOStorage::Initialize(const GameLOVStorage& lov, const DamageInclination_shptr& nullDamageInclination, const char* xmlfilename) {
         _isInitialized = false;
 
-        XML_LOAD_PRIVATE::LoadDataVisitor visitor(&_skills, &_equipment, &_battlers, &_defaultEquipmentSlotSchema, &_inclinationAttackingStats, &_inclinationDefendingStats, lov, nullDamageInclination);
+        XML_LOAD_PRIVATE::LoadDataVisitor visitor(&_symbols, &_skills, &_equipment, &_battlers, &_defaultEquipmentSlotSchema, &_inclinationAttackingStats, &_inclinationDefendingStats, lov, nullDamageInclination);
 
         tinyxml2::XMLDocument doc;
         if (doc.LoadFile(xmlfilename) != tinyxml2::XML_SUCCESS) {
@@ -84,6 +62,170 @@ namespace AWE {
             return false;
         }
 
+        for (const SkillMap::value_type& skill : _skills) {
+            skill.second->CompileDamagePlan(lov.damageInclinations(), _inclinationAttackingStats, _inclinationDefendingStats);
+        }
+
+        _isInitialized = true;
+        return _isInitialized;
+    }
+
+    bool GameXLOStorage::Initialize(const GameLOVStorage& lov, const ContentPack& pack) {
+        _isInitialized = false;
+
+        // Records refer to list entries by index, which only means the same thing if the lists are the ones the pack was compiled against.
+        if (!lov.isInitialized() || !pack.Matches(lov)) {
+            std::cout << "The content pack does not match the loaded lists.\n";
+            return false;
+        }
+
+        _defaultEquipmentSlotSchema.clear();
+        _inclinationAttackingStats.clear();
+        _inclinationDefendingStats.clear();
+        _symbols.Clear();
+        _skills.clear();
+        _equipment.clear();
+        _battlers.clear();
+
+        for (const ContentPackString& name : pack.symbols()) {
+            // Intern hands out IDs in order, so this only fails if the pack has the same name twice.
+            if (_symbols.Intern(std::string(pack.GetString(name))) != _symbols.size()) {
+                std::cout << "The content pack has the same name twice.\n";
+                return false;
+            }
+        }
+
+        const LOVIndexTable<BattlerStat>& stats = lov.battlerStatIndices();
+        const LOVIndexTable<DamageInclination>& inclinations = lov.damageInclinationIndices();
+
+        // Settings.
+
+        for (const ContentPackSlotCount& slot : pack.defaultEquipmentSlots()) {
+            _defaultEquipmentSlotSchema.insert(std::make_pair(lov.equipmentTypeIndices().GetKey(slot.equipmentType), slot.count));
+        }
+
+        for (const ContentPackInclinationStats& inclination : pack.inclinationStats()) {
+            BattlerStatList attacking;
+            for (ContentPackIndex stat : ContentPack::GetRange(pack.indices(), inclination.attacking)) {
+                attacking.push_back(stats.GetValue(stat));
+            }
+            BattlerStatList defending;
+            for (ContentPackIndex stat : ContentPack::GetRange(pack.indices(), inclination.defending)) {
+                defending.push_back(stats.GetValue(stat));
+            }
+
+            _inclinationAttackingStats.insert(std::make_pair(inclinations.GetKey(inclination.inclination), std::move(attacking)));
+            _inclinationDefendingStats.insert(std::make_pair(inclinations.GetKey(inclination.inclination), std::move(defending)));
+        }
+
+        // Skills.
+
+        std::vector<Skill_shptr> skills;
+        for (const ContentPackSkill& skill : pack.skills()) {
+            std::vector<SkillDamage> damages;
+            for (const ContentPackSkillDamage& damage : ContentPack::GetRange(pack.skillDamages(), skill.damages)) {
+                SkillBaseDamage baseDamage(damage.baseValue, damage.baseInclination != CONTENTPACK_NO_INDEX ? inclinations.GetValue(damage.baseInclination) : DamageInclination_shptr());
+
+                if (damage.statScalings.count == 0 && damage.elementBindings.count == 0) {
+                    damages.push_back(SkillDamage(baseDamage, damage.inclinationKey));
+                    continue;
+                }
+
+                std::vector<SkillStatScaling> scalings;
+                for (const ContentPackStatScaling& scaling : ContentPack::GetRange(pack.statScalings(), damage.statScalings)) {
+                    scalings.push_back(SkillStatScaling(scaling.value, inclinations.GetValue(scaling.inclination), stats.GetValue(scaling.stat)));
+                }
+
+                std::vector<SkillElementBinding> bindings;
+                for (const ContentPackElementBinding& binding : ContentPack::GetRange(pack.elementBindings(), damage.elementBindings)) {
+                    bool isPenetrating = binding.flags & ContentPackElementBinding::FLAG_PENETRATING;
+                    const DamageType_shptr& damageType = lov.damageTypeIndices().GetValue(binding.damageType);
+                    bindings.push_back((binding.flags & ContentPackElementBinding::FLAG_GROUP)
+                        ? SkillElementBinding(isPenetrating, binding.scaling, inclinations.GetValue(binding.inclination), damageType, lov.skillElementGroupIndices().GetValue(binding.target))
+                        : SkillElementBinding(isPenetrating, binding.scaling, inclinations.GetValue(binding.inclination), damageType, lov.skillElementIndices().GetValue(binding.target)));
+                }
+
+                damages.push_back(SkillDamage(baseDamage, damage.inclinationKey, scalings, bindings));
+            }
+
+            const std::string& name = _symbols.GetName(skill.symbol);
+            skills.push_back(Skill_shptr(skill.damages.count > 0
+                ? new Skill(name, damages, skill.textureIndex, std::string(pack.GetString(skill.sound)))
+                : new Skill(name, skill.textureIndex, std::string(pack.GetString(skill.sound)))));
+            _skills.insert(std::make_pair(skill.symbol, skills.back()));
+        }
+
+        // Equipment.
+
+        std::vector<Equipment_shptr> equipment;
+        for (const ContentPackEquipment& eq : pack.equipment()) {
+            BattlerStatValues bonusStats;
+            for (const ContentPackStatValue& value : ContentPack::GetRange(pack.statValues(), eq.bonusStats)) {
+                bonusStats.insert(std::make_pair(stats.GetKey(value.stat), value.value));
+            }
+
+            SkillElementGroupConversionMap conversions;
+            for (const ContentPackConversion& conversion : ContentPack::GetRange(pack.conversions(), eq.conversions)) {
+                conversions.insert(std::make_pair(lov.skillElementGroupIndices().GetKey(conversion.group), lov.skillElementIndices().GetValue(conversion.element)));
+            }
+
+            SkillMap grantedSkills;
+            for (ContentPackIndex skill : ContentPack::GetRange(pack.indices(), eq.skills)) {
+                grantedSkills.insert(std::make_pair(pack.skills()[skill].symbol, skills[skill]));
+            }
+
+            DamageResistances _(lov.damageTypeIndices(), lov.damageInclinationIndices());
+            DamageSourceMatrix fullDamageSources = CreateFullDamageSources(lov.damageInclinationIndices(), lov.damageTypeIndices());
+            equipment.push_back(std::make_shared<Equipment>(Equipment(
+                _symbols.GetName(eq.symbol),
+                _,
+                fullDamageSources,
+                lov.equipmentTypeIndices().GetValue(eq.equipmentType),
+                grantedSkills,
+                bonusStats,
+                conversions
+            )));
+            _equipment.insert(std::make_pair(eq.symbol, equipment.back()));
+        }
+
+        // Battlers.
+
+        for (const ContentPackBattler& battler : pack.battlers()) {
+            BattlerStatValues values;
+            for (const ContentPackStatValue& value : ContentPack::GetRange(pack.statValues(), battler.stats)) {
+                values.insert(std::make_pair(stats.GetKey(value.stat), value.value));
+            }
+
+            EquipmentList startingEquipment;
+            for (ContentPackIndex eq : ContentPack::GetRange(pack.indices(), battler.startingEquipment)) {
+                startingEquipment.push_back(equipment[eq]);
+            }
+
+            BattlerStatBlock block(stats, values);
+            DamageResistances _(lov.damageTypeIndices(), lov.damageInclinationIndices());
+            DamageSourceMatrix fullDamageSources = CreateFullDamageSources(lov.damageInclinationIndices(), lov.damageTypeIndices());
+            ElementalAffinities __(lov.skillElementIndices(), lov.damageTypeIndices(), lov.skillElementGroupIndices());
+            _battlers.insert(std::make_pair(battler.symbol, std::make_shared<const Battler>(Battler(
+                _symbols.GetName(battler.symbol),
+                battler.isCharacter != 0,
+                static_cast<unsigned short>(battler.priority),
+                battler.textureIndex,
+                battler.textureType,
+                block,
+                _,
+                fullDamageSources,
+                __,
+                _defaultEquipmentSlotSchema,
+                startingEquipment
+            ))));
+        }
+
+        for (const SkillMap::value_type& skill : _skills) {
+            skill.second->CompileDamagePlan(lov.damageInclinations(), _inclinationAttackingStats, _inclinationDefendingStats);
+        }
+
+        std::cout << "Content pack objects loaded: " << _skills.size() << " skills, " << _equipment.size() << " equipment, " << _battlers.size() << " battlers.\n";
+
         _isInitialized = true;
         return _isInitialized;
     }
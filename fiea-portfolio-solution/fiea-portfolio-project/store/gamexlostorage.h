@@ -6,16 +6,22 @@
 #include "../models/damageinclination.h"
 #include "../models/equipment.h"
 #include "../models/skill.h"
+#include "symboltable.h"
 
 namespace AWE {
+    // Forward declaration, defined in misc/contentpack.h.
+    class ContentPack;
+
     /// <summary>
     /// XLO = XML Loaded Objects. Stores all the objects loaded using tinyxml2.
+    /// Skills, equipment and battlers are keyed by their names' symbols, interned by this storage's symbol table during the load.
     /// </summary>
     class GameXLOStorage {
     private:
         EquipmentTypeCountMap _defaultEquipmentSlotSchema;
         DamageInclinationStatListMap _inclinationAttackingStats;
         DamageInclinationStatListMap _inclinationDefendingStats;
+        SymbolTable _symbols;
         SkillMap _skills;
         EquipmentMap _equipment;
         BattlerMap _battlers;
@@ -30,40 +36,47 @@ namespace AWE {
 
         /// <returns>const reference to the loaded default equipment slot schema.</returns>
         const EquipmentTypeCountMap& defaultEquipmentSlotSchema() const;
+        /// <returns>const reference to the symbol table which interned the names of the loaded skills, equipment and battlers.</returns>
+        const SymbolTable& symbols() const;
         /// <returns>const reference to the loaded skills.</returns>
         const SkillMap& skills() const;
         /// <returns>const reference to the loaded equipment.</returns>
         const EquipmentMap& equipment() const;
-        /// <returns>const reference to the loaded battlers.</returns>
+        /// <returns>const reference to the loaded battlers. The battlers themselves are const as well, since content never changes once loaded.</returns>
         const BattlerMap& battlers() const;
+        /// <returns>const reference to the attacking stats of each damage inclination.</returns>
+        const DamageInclinationStatListMap& inclinationAttackingStats() const;
+        /// <returns>const reference to the defending stats of each damage inclination.</returns>
+        const DamageInclinationStatListMap& inclinationDefendingStats() const;
         /// <returns>Is this object initialized? If false, the Initialize method may need to be invoked.</returns>
         bool isInitialized() const;
 
         /// <summary>
         /// Initializes the load. Running this function after this object is initialized will simply re-run the load.
+        /// Once the load succeeds, every skill's damage plan is compiled.
         /// </summary>
         /// <param name="lov">LOVs to be used for ABRV lookup.</param>
         /// <param name="nullDamageInclination">The damage inclination to be used when no damage inclination is given for base damage.</param>
         /// <param name="xmlfilename">Filename of the XML file to be used for the load.</param>
         /// <returns>Whether the load was successful.</returns>
         bool Initialize(const GameLOVStorage& lov, const DamageInclination_shptr& nullDamageInclination, const char* xmlfilename = DEFAULT_XMLFILENAME);
+        /// <summary>
+        /// Initializes the load from a compiled content pack instead of the XML file. Running this function after this object is initialized will simply re-run the load.
+        /// Once the load succeeds, every skill's damage plan is compiled. Names keep the symbols they were interned with when the pack was compiled.
+        /// </summary>
+        /// <param name="lov">LOVs the pack's lists must match, usually loaded from the same pack.</param>
+        /// <param name="pack">Attached content pack. Nothing in this object refers back to it, so it may be detached once this returns.</param>
+        /// <returns>Whether the load was successful.</returns>
+        bool Initialize(const GameLOVStorage& lov, const ContentPack& pack);
 
         /// <returns>Returns a copy of all attacking stats for the given damage inclination.</returns>
         BattlerStatList CopyAttackingStats(DamageInclinationKey) const;
         /// <returns>Returns a copy of all defending stats for the given damage inclination.</returns>
         BattlerStatList CopyDefendingStats(DamageInclinationKey) const;
 
-        /// <returns>Mutable copy of the battler with the given key, or an empty pointer if no such battler exists.</returns>
-        Battler_shptr GetBattler(const BattlerKey&);
-        /// <summary>
-        /// Adjusts the stat of the given battler by the given amount.
-        /// </summary>
-        /// <returns>New value of the battler's stat, or 0 if no such battler or stat exist.</returns>
-        BattlerStatValue AdjustBattlerStat(const BattlerKey&, const BattlerStatKey&, int);
-        /// <summary>
-        /// Adjusts the elemental affinity of the given battler by the given amount.
-        /// </summary>
-        /// <returns>New value of the battler's elemental affinity, or 0 if no such battler or affinity exist.</returns>
-        ElementalAffinityValue AdjustBattlerAffinity(const BattlerKey&, const ElementalAffinityKey&, int);
+        /// <returns>Copy of the shared pointer to the battler with the given key, or an empty pointer if no such battler exists. Battlers are changed through a BattlerProgression, not here.</returns>
+        std::shared_ptr<const Battler> GetBattler(BattlerKey) const;
+        /// <returns>Copy of the shared pointer to the battler with the given name, or an empty pointer if no such battler exists. Battlers are changed through a BattlerProgression, not here.</returns>
+        std::shared_ptr<const Battler> GetBattler(const std::string&) const;
     };
 }
@@ -0,0 +1,91 @@
+#include "handlepool.h"
+#include <algorithm>
+#include "../models/battler.h"
+
+namespace AWE {
+    template <typename T>
+    HandlePool<T>::HandlePool(std::pmr::memory_resource* resource) : _slots(resource), _free(resource), _size(0), _firstGeneration(1) {}
+
+    template <typename T>
+    std::size_t HandlePool<T>::size() const { return _size; }
+
+    template <typename T>
+    Handle<T> HandlePool<T>::Insert(T value) {
+        std::uint16_t index;
+        if (!_free.empty()) {
+            index = _free.back();
+            _free.pop_back();
+        } else if (_slots.size() < MAX_SIZE && _firstGeneration != 0) {
+            index = static_cast<std::uint16_t>(_slots.size());
+            _slots.emplace_back();
+            _slots.back().generation = _firstGeneration;
+        } else {
+            return Handle<T>();
+        }
+
+        Slot& slot = _slots[index];
+        slot.value.emplace(std::move(value));
+        _size++;
+        return Handle<T>{ index, slot.generation };
+    }
+
+    template <typename T>
+    bool HandlePool<T>::Remove(Handle<T> handle) {
+        if (!Contains(handle)) {
+            return false;
+        }
+
+        Slot& slot = _slots[handle.index];
+        slot.value.reset();
+        _size--;
+        // Wrapping around would bring back generations which stale handles may still hold, so an exhausted slot is never filled again.
+        if (slot.generation == UINT32_MAX) {
+            return true;
+        }
+
+        slot.generation++;
+        _free.push_back(handle.index);
+        return true;
+    }
+
+    template <typename T>
+    void HandlePool<T>::Clear() {
+        for (std::size_t i = 0; i < _slots.size(); i++) {
+            if (_slots[i].value) {
+                Remove(Handle<T>{ static_cast<std::uint16_t>(i), _slots[i].generation });
+            }
+        }
+    }
+
+    template <typename T>
+    void HandlePool<T>::Reset() {
+        // New slots start past every generation issued so far, since a stale handle may point at any index the new slots will take.
+        // Objects are destroyed directly rather than through Remove, which would grow the free list only to throw it away.
+        std::uint32_t highest = _firstGeneration;
+        for (Slot& slot : _slots) {
+            slot.value.reset();
+            highest = std::max(highest, slot.generation);
+        }
+        // Once generations run out they stay out, for the same reason Remove retires exhausted slots.
+        _firstGeneration = (_firstGeneration == 0 || highest == UINT32_MAX) ? 0 : highest + 1;
+        _size = 0;
+
+        // Swapping with empty vectors is the only way to make them hand their storage back.
+        std::pmr::vector<Slot>(_slots.get_allocator()).swap(_slots);
+        std::pmr::vector<std::uint16_t>(_free.get_allocator()).swap(_free);
+    }
+
+    template <typename T>
+    bool HandlePool<T>::Contains(Handle<T> handle) const {
+        return handle.IsValid() && handle.index < _slots.size() && _slots[handle.index].generation == handle.generation && _slots[handle.index].value.has_value();
+    }
+
+    template <typename T>
+    T* HandlePool<T>::Get(Handle<T> handle) { return Contains(handle) ? &*_slots[handle.index].value : nullptr; }
+
+    template <typename T>
+    const T* HandlePool<T>::Get(Handle<T> handle) const { return Contains(handle) ? &*_slots[handle.index].value : nullptr; }
+
+    // Every pooled type must be instantiated here.
+    template class HandlePool<BattlerInstance>;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+namespace AWE {
+    /// <summary>
+    /// Reference to an object owned by a HandlePool. A handle is trivially copyable, and unlike a raw pointer it can tell when its object is gone:
+    /// every slot counts how many times it has been reused, and a handle only resolves while its generation matches the slot's.
+    /// Generation 0 is never issued, so a default-constructed handle is always invalid. Generations never wrap around, so a stale handle can never resolve again.
+    /// </summary>
+    template <typename T>
+    struct Handle {
+        std::uint16_t index = 0;
+        std::uint32_t generation = 0;
+
+        /// <returns>false for the default handle. Note a handle which returns true may still be stale; only the pool can tell.</returns>
+        bool IsValid() const { return generation != 0; }
+
+        friend bool operator==(const Handle& left, const Handle& right) { return left.index == right.index && left.generation == right.generation; }
+        friend bool operator!=(const Handle& left, const Handle& right) { return !(left == right); }
+    };
+
+    /// <summary>
+    /// Single owner of a set of objects, each addressed by a Handle. Removed slots are reused, bumping their generation so every handle to the old object stops resolving.
+    /// A slot whose generation reaches UINT32_MAX is retired instead of reused, rather than wrapping around to generations older handles may still hold.
+    /// Objects live in one vector, so pointers returned by Get are only good until the next Insert. Hold handles across frames, not pointers.
+    /// The vector allocates from the memory resource given at construction, e.g. a BattleArena.
+    /// </summary>
+    template <typename T>
+    class HandlePool {
+    private:
+        struct Slot {
+            std::optional<T> value;
+            std::uint32_t generation = 1;
+        };
+
+        std::pmr::vector<Slot> _slots;
+        std::pmr::vector<std::uint16_t> _free;
+        std::size_t _size;
+        /// <summary>
+        /// Generation of slots added after the last Reset. 0 once generations have run out, after which only reused slots can be filled.
+        /// </summary>
+        std::uint32_t _firstGeneration;
+
+    public:
+        /// <summary>
+        /// Largest number of objects a pool can hold at once, one for each index a handle can address.
+        /// </summary>
+        static const std::size_t MAX_SIZE = 0x10000;
+
+        /// <summary>
+        /// Constructor.
+        /// </summary>
+        /// <param name="">Memory resource the pool's storage comes from. Must outlive the pool. Defaults to the global heap.</param>
+        HandlePool(std::pmr::memory_resource* = std::pmr::get_default_resource());
+
+        /// <returns>Number of live objects.</returns>
+        std::size_t size() const;
+
+        /// <summary>
+        /// Moves the given object into the pool.
+        /// </summary>
+        /// <returns>Handle to the new object, or an invalid handle if the pool already holds MAX_SIZE objects or has run out of generations.</returns>
+        Handle<T> Insert(T);
+        /// <summary>
+        /// Destroys the object of the given handle. Every handle to it becomes stale.
+        /// </summary>
+        /// <returns>false if the handle was already stale or invalid.</returns>
+        bool Remove(Handle<T>);
+        /// <summary>
+        /// Destroys every object. Every handle issued so far becomes stale.
+        /// </summary>
+        void Clear();
+        /// <summary>
+        /// Destroys every object and gives back all of the pool's storage to its memory resource, so the resource can be released afterwards.
+        /// Indexes are reused from 0 again, but generations keep counting up from where they were, so every handle issued so far stays stale.
+        /// Once the highest generation reaches UINT32_MAX, there is no generation left which no handle has seen, and the pool stops issuing handles for good.
+        /// </summary>
+        void Reset();
+
+        /// <returns>true if the given handle still resolves to an object.</returns>
+        bool Contains(Handle<T>) const;
+        /// <returns>Pointer to the object of the given handle, or nullptr if the handle is stale or invalid.</returns>
+        T* Get(Handle<T>);
+        /// <returns>Pointer to the object of the given handle, or nullptr if the handle is stale or invalid.</returns>
+        const T* Get(Handle<T>) const;
+    };
+}
@@ -0,0 +1,64 @@
+#include "lovindextable.h"
+#include <algorithm>
+#include "../models/battlerstat.h"
+#include "../models/damageinclination.h"
+#include "../models/damagetype.h"
+#include "../models/equipmenttype.h"
+#include "../models/skillelement.h"
+#include "../models/skillelementgroup.h"
+
+namespace AWE {
+
+    /* LOVIndexTable */
+
+    template <typename T> LOVIndexTable<T>::LOVIndexTable() {}
+
+    template <typename T> std::size_t LOVIndexTable<T>::size() const { return _keys.size(); }
+    template <typename T> const std::vector<ABRV_long>& LOVIndexTable<T>::keys() const { return _keys; }
+    template <typename T> const std::vector<std::shared_ptr<T>>& LOVIndexTable<T>::values() const { return _values; }
+
+    template <typename T>
+    LOVIndex LOVIndexTable<T>::GetIndex(ABRV_long key) const {
+        auto found = std::lower_bound(_keys.begin(), _keys.end(), key);
+        return static_cast<LOVIndex>((found != _keys.end() && *found == key) ? (found - _keys.begin()) : _keys.size());
+    }
+
+    template <typename T> ABRV_long LOVIndexTable<T>::GetKey(LOVIndex index) const { return (index < _keys.size()) ? _keys[index] : INVALID_ABRV_LONG; }
+    template <typename T> const std::shared_ptr<T>& LOVIndexTable<T>::GetValue(LOVIndex index) const { return _values[index]; }
+
+    template <typename T>
+    bool LOVIndexTable<T>::Assign(const std::unordered_map<ABRV_long, std::shared_ptr<T>>& map) {
+        Clear();
+
+        if (map.size() > MAX_SIZE) {
+            return false;
+        }
+
+        _keys.reserve(map.size());
+        for (const auto& entry : map) {
+            _keys.push_back(entry.first);
+        }
+        std::sort(_keys.begin(), _keys.end());
+
+        _values.reserve(_keys.size());
+        for (ABRV_long key : _keys) {
+            _values.push_back(map.at(key));
+        }
+
+        return true;
+    }
+
+    template <typename T>
+    void LOVIndexTable<T>::Clear() {
+        _keys.clear();
+        _values.clear();
+    }
+
+    // Every LOV the storage indexes must be instantiated here.
+    template class LOVIndexTable<BattlerStat>;
+    template class LOVIndexTable<DamageInclination>;
+    template class LOVIndexTable<DamageType>;
+    template class LOVIndexTable<EquipmentType>;
+    template class LOVIndexTable<SkillElement>;
+    template class LOVIndexTable<SkillElementGroup>;
+}
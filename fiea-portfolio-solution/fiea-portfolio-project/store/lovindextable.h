@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "../abrv/abrv.h"
+
+namespace AWE {
+    /// <summary>
+    /// Dense index of one LOV entry. Indices are only meaningful for the table which assigned them.
+    /// </summary>
+    typedef std::uint16_t LOVIndex;
+
+    /// <summary>
+    /// Assigns every entry of one closed list of values a dense LOVIndex, so hot code can index arrays instead of searching maps. Indices are assigned in key order, starting at 0.
+    /// Like DamageBatchLayout, a key which is not in the table resolves to the size of the table, so arrays sized one past the table have a slot for "anything else".
+    /// </summary>
+    template <typename T>
+    class LOVIndexTable {
+    private:
+        std::vector<ABRV_long> _keys;
+        std::vector<std::shared_ptr<T>> _values;
+
+    public:
+        /// <summary>
+        /// Largest number of entries a table can index. One index is left over so the size of a full table is still a valid LOVIndex.
+        /// </summary>
+        static const std::size_t MAX_SIZE = 0xFFFF;
+
+        LOVIndexTable();
+
+        /// <returns>Number of entries.</returns>
+        std::size_t size() const;
+        /// <returns>const reference to every key, in index order.</returns>
+        const std::vector<ABRV_long>& keys() const;
+        /// <returns>const reference to every entry, in index order.</returns>
+        const std::vector<std::shared_ptr<T>>& values() const;
+
+        /// <returns>Index of the given key, or size() if it is not in the table.</returns>
+        LOVIndex GetIndex(ABRV_long) const;
+        /// <returns>Key at the given index, or INVALID_ABRV_LONG if the index is out of range.</returns>
+        ABRV_long GetKey(LOVIndex) const;
+        /// <returns>const reference to the entry at the given index. The index must be in range.</returns>
+        const std::shared_ptr<T>& GetValue(LOVIndex) const;
+
+        /// <summary>
+        /// Discards every index and assigns new ones to the entries of the given map.
+        /// </summary>
+        /// <returns>False if the map has more than MAX_SIZE entries, in which case the table is left empty.</returns>
+        bool Assign(const std::unordered_map<ABRV_long, std::shared_ptr<T>>&);
+        /// <summary>
+        /// Discards every index.
+        /// </summary>
+        void Clear();
+    };
+}
@@ -0,0 +1,111 @@
+#include "symboltable.h"
+#include <algorithm>
+#include "../models/battler.h"
+#include "../models/equipment.h"
+#include "../models/skill.h"
+
+namespace AWE {
+    const SymbolID SymbolTable::INVALID_ID = 0;
+
+    // Index 0 holds the name of INVALID_ID, so every issued ID is also its own index.
+    SymbolTable::SymbolTable() : _names(1) {}
+
+    std::size_t SymbolTable::size() const { return _names.size() - 1; }
+
+    SymbolID SymbolTable::Intern(const std::string& name) {
+        auto found = _ids.find(name);
+        if (found != _ids.end()) {
+            return found->second;
+        }
+
+        SymbolID id = static_cast<SymbolID>(_names.size());
+        _names.push_back(name);
+        _ids.insert(std::make_pair(name, id));
+        return id;
+    }
+
+    SymbolID SymbolTable::Find(const std::string& name) const {
+        auto found = _ids.find(name);
+        return (found != _ids.end()) ? found->second : INVALID_ID;
+    }
+
+    const std::string& SymbolTable::GetName(SymbolID id) const { return (id < _names.size()) ? _names[id] : _names[INVALID_ID]; }
+
+    void SymbolTable::Clear() {
+        _names.resize(1);
+        _ids.clear();
+    }
+
+    // SymbolMap
+
+    template <typename T>
+    SymbolMap<T>::SymbolMap() {}
+
+    template <typename T>
+    typename std::vector<typename SymbolMap<T>::value_type>::iterator SymbolMap<T>::LowerBound(SymbolID key) {
+        return std::lower_bound(_entries.begin(), _entries.end(), key, [](const value_type& entry, SymbolID k) { return entry.first < k; });
+    }
+
+    template <typename T>
+    typename SymbolMap<T>::const_iterator SymbolMap<T>::LowerBound(SymbolID key) const {
+        return std::lower_bound(_entries.begin(), _entries.end(), key, [](const value_type& entry, SymbolID k) { return entry.first < k; });
+    }
+
+    template <typename T>
+    std::size_t SymbolMap<T>::size() const { return _entries.size(); }
+
+    template <typename T>
+    bool SymbolMap<T>::empty() const { return _entries.empty(); }
+
+    template <typename T>
+    typename SymbolMap<T>::const_iterator SymbolMap<T>::find(SymbolID key) const {
+        const_iterator found = LowerBound(key);
+        return (found != _entries.end() && found->first == key) ? found : _entries.end();
+    }
+
+    template <typename T>
+    bool SymbolMap<T>::contains(SymbolID key) const { return find(key) != _entries.end(); }
+
+    template <typename T>
+    const std::shared_ptr<T>& SymbolMap<T>::Get(SymbolID key) const {
+        static const std::shared_ptr<T> EMPTY;
+        const_iterator found = find(key);
+        return (found != _entries.end()) ? found->second : EMPTY;
+    }
+
+    template <typename T>
+    bool SymbolMap<T>::insert(value_type entry) {
+        auto found = LowerBound(entry.first);
+        if (found != _entries.end() && found->first == entry.first) {
+            return false;
+        }
+
+        _entries.insert(found, std::move(entry));
+        return true;
+    }
+
+    template <typename T>
+    std::size_t SymbolMap<T>::erase(SymbolID key) {
+        auto found = LowerBound(key);
+        if (found == _entries.end() || found->first != key) {
+            return 0;
+        }
+
+        _entries.erase(found);
+        return 1;
+    }
+
+    template <typename T>
+    void SymbolMap<T>::clear() { _entries.clear(); }
+
+    template <typename T>
+    typename SymbolMap<T>::const_iterator SymbolMap<T>::begin() const { return _entries.begin(); }
+
+    template <typename T>
+    typename SymbolMap<T>::const_iterator SymbolMap<T>::end() const { return _entries.end(); }
+
+    // Every symbol-keyed collection must be instantiated here.
+    template class SymbolMap<const Battler>;
+    template class SymbolMap<Equipment>;
+    template class SymbolMap<Skill>;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace AWE {
+    /// <summary>
+    /// Compact ID of an interned name. IDs are only meaningful for the table which issued them.
+    /// </summary>
+    typedef std::uint32_t SymbolID;
+
+    /// <summary>
+    /// Interns names loaded from data, handing each distinct name one SymbolID. IDs are issued in the order names are first seen, starting at 1.
+    /// Names only need to be hashed at the boundary where they come in; everything past it compares integers.
+    /// </summary>
+    class SymbolTable {
+    private:
+        std::vector<std::string> _names;
+        std::unordered_map<std::string, SymbolID> _ids;
+
+    public:
+        /// <summary>
+        /// No name is interned to this ID. It is also what Find returns for a name which has not been interned.
+        /// </summary>
+        static const SymbolID INVALID_ID;
+
+        SymbolTable();
+
+        /// <returns>Number of interned names.</returns>
+        std::size_t size() const;
+
+        /// <returns>ID of the given name, interning it first if it has not been seen yet.</returns>
+        SymbolID Intern(const std::string&);
+        /// <returns>ID of the given name, or INVALID_ID if it has not been interned. Never interns.</returns>
+        SymbolID Find(const std::string&) const;
+        /// <returns>const reference to the name of the given ID, or to an empty string if the ID was not issued by this table.</returns>
+        const std::string& GetName(SymbolID) const;
+        /// <summary>
+        /// Forgets every name. IDs issued before this are no longer meaningful.
+        /// </summary>
+        void Clear();
+    };
+
+    /// <summary>
+    /// Maps symbols to shared objects, kept as one vector sorted by SymbolID, so a lookup is a binary search over integers and iteration is a linear pass.
+    /// Iterates in ID order, which is the order the names were first interned.
+    /// </summary>
+    template <typename T>
+    class SymbolMap {
+    public:
+        typedef std::pair<SymbolID, std::shared_ptr<T>> value_type;
+        typedef typename std::vector<value_type>::const_iterator const_iterator;
+        /// <summary>
+        /// Entries are never mutable through an iterator, since changing a key would break the ordering.
+        /// </summary>
+        typedef const_iterator iterator;
+
+    private:
+        std::vector<value_type> _entries;
+
+        /// <returns>Iterator to the first entry whose key is not less than the given key.</returns>
+        typename std::vector<value_type>::iterator LowerBound(SymbolID);
+        /// <returns>Iterator to the first entry whose key is not less than the given key.</returns>
+        const_iterator LowerBound(SymbolID) const;
+
+    public:
+        SymbolMap();
+
+        /// <returns>Number of entries.</returns>
+        std::size_t size() const;
+        /// <returns>true if there are no entries.</returns>
+        bool empty() const;
+
+        /// <returns>Iterator to the entry with the given key, or end() if there is none.</returns>
+        const_iterator find(SymbolID) const;
+        /// <returns>true if there is an entry with the given key.</returns>
+        bool contains(SymbolID) const;
+        /// <returns>const reference to the object with the given key, or to an empty pointer if there is none.</returns>
+        const std::shared_ptr<T>& Get(SymbolID) const;
+
+        /// <summary>
+        /// Adds the given entry, unless an entry with the same key already exists. Like std::map::insert, an existing entry is not replaced.
+        /// </summary>
+        /// <returns>true if the entry was added.</returns>
+        bool insert(value_type);
+        /// <summary>
+        /// Removes the entry with the given key, if any.
+        /// </summary>
+        /// <returns>Number of entries removed, either 0 or 1.</returns>
+        std::size_t erase(SymbolID);
+        /// <summary>
+        /// Removes every entry.
+        /// </summary>
+        void clear();
+
+        /// <returns>const iterator to the entry with the lowest key.</returns>
+        const_iterator begin() const;
+        /// <returns>const iterator to the spot behind the entry with the highest key. Attempting to dereference it will result in undefined behavior.</returns>
+        const_iterator end() const;
+    };
+}